@@ -0,0 +1,326 @@
+#include "BasicX\Mesh\AssetLoader.h"
+#include <chrono>
+using namespace BasicX;
+namespace BasicX
+{
+	//A load owns what it has made until the main thread hands it to a manager, anything left
+	//when it is dropped is freed and its future is set to -1
+	struct AssetMeshJob;
+	struct AssetTextureJob
+	{
+		Texture* m_pTexture = nullptr; //Texture decoded on a worker
+		bool m_bDecoded = false; //The file was decoded
+		std::shared_ptr<AssetMeshJob> m_pMesh; //Mesh the map belongs to, nullptr if asked for alone
+		bool m_bDone = false; //The future was set
+		std::promise<int> m_Promise; //Set when resident
+
+		void Finish(int a_nIndex)
+		{
+			if (m_bDone)
+				return;
+			m_bDone = true;
+			m_Promise.set_value(a_nIndex);
+		}
+		~AssetTextureJob(void)
+		{
+			SafeDelete(m_pTexture);
+			Finish(-1);
+		}
+	};
+	struct AssetMeshJob
+	{
+		String m_sFileName = ""; //Source file
+		Mesh* m_pMesh = nullptr; //Mesh parsed on a worker, nullptr when it comes from the cache
+		bool m_bParsed = false; //The file was parsed
+		std::vector<String> m_lLibrary; //Material libraries of the file
+		std::vector<Material> m_lMaterial; //Materials read from the libraries
+		String m_sMaterial = ""; //Material used by the mesh
+		uint m_uMaps = 0; //Maps not resident yet, the mesh is finished after the last one
+		bool m_bDone = false; //The future was set
+		std::promise<int> m_Promise; //Set when resident
+
+		void Finish(int a_nIndex)
+		{
+			if (m_bDone)
+				return;
+			m_bDone = true;
+			m_Promise.set_value(a_nIndex);
+		}
+		~AssetMeshJob(void)
+		{
+			SafeDelete(m_pMesh);
+			Finish(-1);
+		}
+	};
+}
+//  AssetLoader
+AssetLoader* AssetLoader::m_pInstance = nullptr;
+AssetLoader* AssetLoader::GetInstance(void)
+{
+	if (m_pInstance == nullptr)
+	{
+		m_pInstance = new AssetLoader();
+	}
+	return m_pInstance;
+}
+void AssetLoader::ReleaseInstance(void)
+{
+	if (m_pInstance != nullptr)
+	{
+		delete m_pInstance;
+		m_pInstance = nullptr;
+	}
+}
+AssetLoader::AssetLoader(void) { Init(); }
+AssetLoader::AssetLoader(AssetLoader const& other) { }
+AssetLoader& AssetLoader::operator=(AssetLoader const& other) { return *this; }
+AssetLoader::~AssetLoader(void) { Release(); }
+void AssetLoader::Init(void)
+{
+	//one core stays for the main thread
+	uint uWorkers = std::thread::hardware_concurrency();
+	uWorkers = uWorkers > 2 ? uWorkers - 1 : 1;
+
+	m_bQuit = false;
+	m_uPending = 0;
+	for (uint i = 0; i < uWorkers; i++)
+		m_lWorker.push_back(std::thread(&AssetLoader::WorkerLoop, this));
+}
+void AssetLoader::Release(void)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_JobLock);
+		m_bQuit = true;
+	}
+	m_JobSignal.notify_all();
+	for (uint i = 0; i < m_lWorker.size(); i++)
+		m_lWorker[i].join();
+	m_lWorker.clear();
+
+	//dropping the work frees whatever it had loaded, the workers are gone so this is the last owner
+	m_lJob.clear();
+	m_lUpload.clear();
+	m_uPending = 0;
+}
+void AssetLoader::WorkerLoop(void)
+{
+	while (true)
+	{
+		std::function<void()> fnJob;
+		{
+			std::unique_lock<std::mutex> lock(m_JobLock);
+			m_JobSignal.wait(lock, [this]() { return m_bQuit || !m_lJob.empty(); });
+			if (m_bQuit)
+				return;
+			fnJob = std::move(m_lJob.front());
+			m_lJob.pop_front();
+		}
+		fnJob();
+	}
+}
+void AssetLoader::EnqueueJob(std::function<void()> a_fnJob)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_JobLock);
+		m_lJob.push_back(std::move(a_fnJob));
+	}
+	m_JobSignal.notify_one();
+}
+void AssetLoader::EnqueueUpload(std::function<void()> a_fnUpload)
+{
+	std::lock_guard<std::mutex> lock(m_UploadLock);
+	m_lUpload.push_back(std::move(a_fnUpload));
+}
+std::shared_future<int> AssetLoader::LoadMesh(String a_sFileName)
+{
+	std::shared_ptr<AssetMeshJob> pJob = std::make_shared<AssetMeshJob>();
+	pJob->m_sFileName = a_sFileName;
+	std::shared_future<int> load = pJob->m_Promise.get_future().share();
+	m_uPending++;
+
+	//a fresh cache is mapped and goes straight to OpenGL, the workers have nothing to do
+	if (MeshCache::IsFresh(a_sFileName, MeshCache::GetCachePath(a_sFileName)))
+	{
+		EnqueueUpload([this, pJob]() { FinishMesh(pJob); });
+		return load;
+	}
+
+	//the constructor reads the managers, so the mesh is made here and only filled on the worker
+	pJob->m_pMesh = new Mesh();
+	EnqueueJob([this, pJob]()
+	{
+		pJob->m_bParsed = pJob->m_pMesh->ParseOBJ(pJob->m_sFileName, pJob->m_lLibrary, pJob->m_sMaterial);
+		for (uint i = 0; i < pJob->m_lLibrary.size(); i++)
+			MaterialManager::ReadMaterialLibrary(pJob->m_lLibrary[i], pJob->m_lMaterial);
+
+		//the maps are decoded here as well, each one is uploaded on its own before the mesh
+		std::vector<std::shared_ptr<AssetTextureJob>> lTexture;
+		std::set<String> lMap;
+		for (uint i = 0; pJob->m_bParsed && i < pJob->m_lMaterial.size(); i++)
+		{
+			Material& material = pJob->m_lMaterial[i];
+			String sMap[3] = { material.GetDiffuseMapName(), material.GetNormalMapName(), material.GetSpecularMapName() };
+			for (uint j = 0; j < 3; j++)
+			{
+				if (sMap[j] == "NULL" || sMap[j] == "" || !lMap.insert(sMap[j]).second)
+					continue;
+				std::shared_ptr<AssetTextureJob> pTexture = std::make_shared<AssetTextureJob>();
+				pTexture->m_pTexture = new Texture();
+				pTexture->m_bDecoded = pTexture->m_pTexture->DecodeTexture(sMap[j]);
+				if (!pTexture->m_bDecoded)
+					continue;
+				pTexture->m_pMesh = pJob;
+				lTexture.push_back(pTexture);
+			}
+		}
+
+		//counted before any is queued, from here on the count is only touched by the main thread
+		pJob->m_uMaps = lTexture.size();
+		if (lTexture.empty())
+			EnqueueUpload([this, pJob]() { FinishMesh(pJob); });
+		for (uint i = 0; i < lTexture.size(); i++)
+			UploadTexture(lTexture[i]);
+	});
+	return load;
+}
+std::shared_future<int> AssetLoader::LoadTexture(String a_sFileName)
+{
+	std::shared_ptr<AssetTextureJob> pJob = std::make_shared<AssetTextureJob>();
+	std::shared_future<int> load = pJob->m_Promise.get_future().share();
+	m_uPending++;
+
+	pJob->m_pTexture = new Texture();
+	EnqueueJob([this, pJob, a_sFileName]()
+	{
+		pJob->m_bDecoded = pJob->m_pTexture->DecodeTexture(a_sFileName);
+		UploadTexture(pJob);
+	});
+	return load;
+}
+void AssetLoader::FinishMesh(std::shared_ptr<AssetMeshJob> a_pJob)
+{
+	MeshManager* pMeshMngr = MeshManager::GetInstance();
+	String sFileName = a_pJob->m_sFileName;
+	MeshSource fnBuild = [sFileName](Mesh* a_pMesh) { a_pMesh->LoadOBJ(sFileName); };
+
+	int nMesh = -1;
+	if (a_pJob->m_pMesh == nullptr)
+		nMesh = pMeshMngr->LoadMesh(sFileName, fnBuild);
+	else if (a_pJob->m_bParsed)
+	{
+		//the maps are in the TextureManager already, adding the materials does not decode them again
+		MaterialManager::GetInstance()->AddMaterialList(a_pJob->m_lMaterial);
+
+		Mesh* pMesh = a_pJob->m_pMesh;
+		a_pJob->m_pMesh = nullptr;
+		if (a_pJob->m_sMaterial != "")
+			pMesh->SetMaterial(a_pJob->m_sMaterial);
+		pMesh->CompileOpenGL3X();
+		if (pMesh->GetBinded())
+		{
+			pMesh->SetSource(fnBuild);
+			pMesh->SaveCache(MeshCache::GetCachePath(sFileName));
+			nMesh = pMeshMngr->AddMesh(pMesh);
+		}
+		else
+		{
+			SafeDelete(pMesh);
+		}
+	}
+
+	a_pJob->Finish(nMesh);
+	m_uPending--;
+}
+void AssetLoader::UploadTexture(std::shared_ptr<AssetTextureJob> a_pJob)
+{
+	//small textures go from the bitmap, the driver copying them on this thread is cheap enough
+	if (!a_pJob->m_bDecoded || a_pJob->m_pTexture->GetDecodedSize() < m_uStreamSize)
+	{
+		EnqueueUpload([this, a_pJob]() { FinishTexture(a_pJob); });
+		return;
+	}
+
+	//big ones are copied by a worker into a pixel buffer the main thread maps and then uploads from
+	EnqueueUpload([this, a_pJob]()
+	{
+		if (a_pJob->m_pTexture->MapUploadBuffer() == nullptr)
+		{
+			FinishTexture(a_pJob);
+			return;
+		}
+		EnqueueJob([this, a_pJob]()
+		{
+			a_pJob->m_pTexture->WriteUploadBuffer();
+			EnqueueUpload([this, a_pJob]() { FinishTexture(a_pJob); });
+		});
+	});
+}
+void AssetLoader::FinishTexture(std::shared_ptr<AssetTextureJob> a_pJob)
+{
+	int nTexture = -1;
+	if (a_pJob->m_bDecoded)
+	{
+		TextureManager* pTextureMngr = TextureManager::GetInstance();
+		Texture* pTexture = a_pJob->m_pTexture;
+		a_pJob->m_pTexture = nullptr;
+
+		//if it was loaded meanwhile the one there is kept
+		nTexture = pTextureMngr->IdentifyTexure(pTexture->GetFileName());
+		if (nTexture < 0 && pTexture->UploadFromBuffer())
+			nTexture = pTextureMngr->AddTexture(pTexture);
+		else
+		{
+			SafeDelete(pTexture);
+		}
+	}
+
+	a_pJob->Finish(nTexture);
+	if (a_pJob->m_pMesh == nullptr)
+	{
+		m_uPending--;
+		return;
+	}
+
+	//the mesh goes once all its maps are in, so adding its materials finds them there
+	std::shared_ptr<AssetMeshJob> pMesh = a_pJob->m_pMesh;
+	a_pJob->m_pMesh = nullptr;
+	if (--pMesh->m_uMaps == 0)
+		FinishMesh(pMesh);
+}
+uint AssetLoader::Update(float a_fBudget)
+{
+	auto start = std::chrono::steady_clock::now();
+	uint uDone = 0;
+	while (true)
+	{
+		std::function<void()> fnUpload;
+		{
+			std::lock_guard<std::mutex> lock(m_UploadLock);
+			if (m_lUpload.empty())
+				break;
+			fnUpload = std::move(m_lUpload.front());
+			m_lUpload.pop_front();
+		}
+		fnUpload();
+		uDone++;
+
+		std::chrono::duration<float, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+		if (elapsed.count() >= a_fBudget)
+			break;
+	}
+	return uDone;
+}
+int AssetLoader::Wait(std::shared_future<int> a_Load)
+{
+	if (!a_Load.valid())
+		return -1;
+	while (a_Load.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+	{
+		//nothing to upload yet, the workers are still on it
+		if (Update(1000.0f) == 0)
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	return a_Load.get();
+}
+uint AssetLoader::GetPendingCount(void) { return m_uPending; }
+uint AssetLoader::GetWorkerCount(void) { return m_lWorker.size(); }
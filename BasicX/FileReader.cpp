@@ -1,25 +1,5 @@
 #include "BasicX\System\FileReader.h"
 using namespace BasicX;
-String GetFirst(String input)
-{
-	int length = static_cast<int>(input.size());
-	char* temp = new char[length+1];
-	int i = 0;
-	for (i = 0; i < length; i++)
-	{
-		temp[i] = input[i];
-	}
-	temp[i] = '\0';
-
-	char * pch;
-	pch = strtok (temp," ");
-
-	String sWord = temp;
-	delete temp;
-	
-	return sWord;
-}
-
 FileReader::FileReader(void) { Init(); }
 FileReader::FileReader(const FileReader& other) { }
 FileReader& FileReader::operator=(const FileReader& other) { return *this; }
@@ -56,18 +36,11 @@ BTO_OUTPUT FileReader::ReadBinaryFile(String a_sFileName)
 }
 BTO_OUTPUT FileReader::ReadFile(String a_sFileName)
 {
-	//if(m_pFile != nullptr)
-	//	CloseFile();
-
-	//fopen_s(&m_pFile, a_sFileName.c_str(), "r");
-
-	m_iStream = std::ifstream(a_sFileName.c_str());
-	if (m_iStream.is_open() == false)
+	//the file is mapped, lines are read straight out of it
+	if (!m_Scanner.Open(a_sFileName))
 		return OUT_ERR_FILE_MISSING;
-	
-	//if(m_pFile == nullptr)
-	//	return OUT_ERR_FILE_MISSING;
 
+	m_Line = StringView();
 	return OUT_ERR_NONE;
 }
 
@@ -93,12 +66,17 @@ void FileReader::CloseFile(void)
 	
 	if (m_oStream.is_open())
 		m_oStream.close();
+
+	m_Scanner.Close();
+	m_Line = StringView();
 }
 
-void FileReader::Rewind(void) const
+void FileReader::Rewind(void)
 {
 	if(m_pFile != nullptr)
 		rewind(m_pFile);
+
+	m_Scanner.Rewind();
 }
 BTO_OUTPUT FileReader::Write(String a_sStringInput)
 {
@@ -241,80 +219,44 @@ BTO_OUTPUT FileReader::RemoveTabs(String* a_sInput)
 BTO_OUTPUT FileReader::ReadNextLine(bool bSkipComments)
 {
 	//if the file is not open return
-	if (!m_iStream.is_open())
+	if (!m_Scanner.IsOpen())
 		return BTO_OUTPUT::OUT_ERR_NOT_INITIALIZED;
 
-	//if we are at the end of the file return
-	if (m_iStream.eof())
-		return BTO_OUTPUT::OUT_DONE;
-
-	//read the next line
-	std::getline(m_iStream, m_sLine);
-	
-	//Remove the tabs from the lines
-	//m_sLine = RemoveTabs(m_sLine);
-	
-	//Send the string to clean
-	RemoveBlanks(&m_sLine);
-
-	//if comments are skipped check for the beginning of the string
-	if(bSkipComments)
+	//the scanner already skips the blanks at the beginning of the line
+	StringView line;
+	while (m_Scanner.NextLine(line))
 	{
-		if(m_sLine[0] == '#')
-		{
-			if(ReadNextLine(bSkipComments) == OUT_DONE)
-				return OUT_DONE;
-		}
-		if(m_sLine[0] == '/')
+		//if comments are skipped check for the beginning of the line
+		if (bSkipComments)
 		{
-			if(m_sLine[1] == '/')
-			{
-				if(ReadNextLine(bSkipComments) == OUT_DONE)
-					return OUT_DONE;
-			}
-		}
-		if(m_sLine[0] == 0)
-		{
-			if(ReadNextLine(bSkipComments) == OUT_DONE)
-				return OUT_DONE;
+			if (line.Empty() || line.m_pData[0] == '#')
+				continue;
+			if (line.m_uLength > 1 && line.m_pData[0] == '/' && line.m_pData[1] == '/')
+				continue;
 		}
+
+		//the string keeps its capacity from line to line, this only copies the characters
+		m_Line = line;
+		m_sLine.assign(line.m_pData, line.m_uLength);
+		return OUT_RUNNING;
 	}
 
-	return OUT_RUNNING;
+	m_Line = StringView();
+	m_sLine.clear();
+	return OUT_DONE;
 };
+StringView FileReader::GetLine(void) const { return m_Line; }
 BTO_OUTPUT FileReader::RemoveBlanks(String* a_sInput)
 {
-	if ((*a_sInput)[0] == 32 || (*a_sInput)[0] == 9)
-	{
-		//create a char* backup
-		int nLenght = m_sLine.size() + 1;
-		char* zsLine = new char[nLenght];
-		strcpy_s(zsLine, nLenght, m_sLine.c_str());
-
-		uint nLength = strlen(zsLine);
-		if (nLength == 0)
-			return OUT_ERR_NONE;
-
-		zsLine[nLength] = '\0';
-
-		int nFirstCharacter = 0; //Counts how many characters or tabs there are before each line	
-		while (zsLine[nFirstCharacter] == 9 || zsLine[nFirstCharacter] == 32)
-		{
-			nFirstCharacter++;
-		}
-
-		memcpy_s(zsLine, nLength - nFirstCharacter + 1, &zsLine[nFirstCharacter], nLength - nFirstCharacter + 1);
-		*a_sInput = zsLine;
+	size_t nFirstCharacter = a_sInput->find_first_not_of(" \t");
+	if (nFirstCharacter == 0)
+		return OUT_ERR_NONE;
+	if (nFirstCharacter == String::npos)
+		nFirstCharacter = a_sInput->size();
 
-		//release the allocated memory
-		if (zsLine != nullptr)
-		{
-			delete[] zsLine;
-			zsLine = nullptr;
-		}
-		return OUT_DONE;
-	}
-	return OUT_ERR_NONE;
+	//erase shifts the characters in place, nothing is allocated
+	a_sInput->erase(0, nFirstCharacter);
+	return OUT_DONE;
 }
 
 BTO_OUTPUT FileReader::RemoveBlanks(char* a_szInput)
@@ -337,85 +279,28 @@ BTO_OUTPUT FileReader::RemoveBlanks(char* a_szInput)
 	if (nFirstCharacter == 0)
 		return OUT_ERR_NONE;
 	
-	//char *zsTemp = new char[nLength - nFirstCharacter + 1];	//we create a new temp line
-	//if (zsTemp == nullptr)
-	//	return OUT_ERR_MEMORY;
-	//memcpy_s(zsTemp, nLength - nFirstCharacter + 1, &a_szInput[nFirstCharacter], nLength - nFirstCharacter + 1);
-	memcpy_s(a_szInput, nLength - nFirstCharacter + 1, &a_szInput[nFirstCharacter], nLength - nFirstCharacter + 1);
-	//SafeDelete(a_szInput);
-	//a_szInput = zsTemp;
+	//source and destination overlap
+	memmove(a_szInput, &a_szInput[nFirstCharacter], nLength - nFirstCharacter + 1);
 
 	return BTO_OUTPUT::OUT_DONE;
 }
 BTO_OUTPUT FileReader::RemoveBlanks(char** zsInput)
 {
-	int nLength = static_cast<int>(strlen(*zsInput)) + 1;
-
-	if( nLength == 0)
+	if (zsInput == nullptr || (*zsInput) == nullptr)
 		return OUT_ERR_MEMORY;
 
-	int character = 0; //Counts how many characters or tabs there are before each line	
-	
-	while ((*zsInput)[character] == 9)
-		character ++;
-
-	while ((*zsInput)[character] == 32)
-		character ++;
-	
-	if(character > 0)	//If there is more than one character
-	{
-		nLength -= character;
-		char *zsTemp = new char[nLength];	//we create a new temp line
-		if(zsTemp == nullptr)
-			return OUT_ERR_MEMORY;
-
-		//Backup the original values
-		for(int n = 0; n < nLength; n++)
-		{
-			zsTemp[n] = (*zsInput)[character + n];
-		}
-		zsTemp[nLength - 1] = '\0';
-		
-		//Clean up and initialize original
-		if ((*zsInput) != nullptr)
-		{
-			delete[](*zsInput);
-			(*zsInput) = nullptr;
-		}
-		
-		(*zsInput) = new char[nLength];
-		//realloc( zsInput, sizeof(char) * nLength );
-		
-		if((*zsInput) == 0)
-		{
-			if (zsTemp != nullptr)
-			{
-				delete[] zsTemp;
-				zsTemp = nullptr;
-			}
-			return OUT_ERR_MEMORY;
-		}
-
-		//Restor the original values
-		for(int n = 0; n < nLength; n++)
-		{
-			(*zsInput)[n] = zsTemp[n];
-		}
-		if (zsTemp != nullptr)
-		{
-			delete[] zsTemp;
-			zsTemp = nullptr;
-		}
-		
-	}
-
+	//the blanks are taken out in place, the same buffer is kept
+	RemoveBlanks(*zsInput);
 	return OUT_DONE;
 };
+
 String FileReader::GetFirstWord(bool a_bToUpper)
 {
-	m_sFirstWord = m_sLine;
-	RemoveTabs(&m_sFirstWord);
-	m_sFirstWord = GetFirst(m_sLine);
+	//words end in spaces or tabs
+	StringView line = m_Line;
+	StringView word;
+	TextScanner::NextToken(line, word);
+	m_sFirstWord.assign(word.m_pData == nullptr ? "" : word.m_pData, word.m_uLength);
 	
 	if(a_bToUpper)
 		std::transform(m_sFirstWord.begin(), m_sFirstWord.end(), m_sFirstWord.begin(), ::toupper);
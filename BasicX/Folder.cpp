@@ -52,7 +52,7 @@ void Folder::Init(void)
 	m_sOBJ = "MOBJ\\";
 	m_sLVL = "LVL\\";
 	m_sTextures = "Textures\\";
-	m_sShaders = "Shaders\\";
+	m_sShaders = "Shaders\\BasicX\\";
 	m_sAddOn = "ADD\\";
 }
 String Folder::GetRealProgramPath(void)
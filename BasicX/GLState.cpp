@@ -0,0 +1,62 @@
+#include "BasicX\System\GLState.h"
+using namespace BasicX;
+//  GLState
+GLuint GLState::m_uProgram = static_cast<GLuint>(-1);
+GLuint GLState::m_uVertexArray = static_cast<GLuint>(-1);
+GLenum GLState::m_eActiveTexture = static_cast<GLenum>(-1);
+GLuint GLState::m_uTexture[GLState::m_uTextureUnits] = {};
+uint GLState::m_uSkipped = 0;
+void GLState::UseProgram(GLuint a_uProgram)
+{
+	if (m_uProgram == a_uProgram)
+	{
+		m_uSkipped++;
+		return;
+	}
+	m_uProgram = a_uProgram;
+	glUseProgram(a_uProgram);
+}
+void GLState::BindVertexArray(GLuint a_uVertexArray)
+{
+	if (m_uVertexArray == a_uVertexArray)
+	{
+		m_uSkipped++;
+		return;
+	}
+	m_uVertexArray = a_uVertexArray;
+	glBindVertexArray(a_uVertexArray);
+}
+void GLState::ActiveTexture(GLenum a_eUnit)
+{
+	if (m_eActiveTexture == a_eUnit)
+	{
+		m_uSkipped++;
+		return;
+	}
+	m_eActiveTexture = a_eUnit;
+	glActiveTexture(a_eUnit);
+}
+void GLState::BindTexture2D(GLenum a_eUnit, GLuint a_uTexture)
+{
+	uint uUnit = a_eUnit - GL_TEXTURE0;
+	//units past the tracked ones are always bound
+	if (uUnit < m_uTextureUnits && m_uTexture[uUnit] == a_uTexture)
+	{
+		m_uSkipped++;
+		return;
+	}
+	ActiveTexture(a_eUnit);
+	glBindTexture(GL_TEXTURE_2D, a_uTexture);
+	if (uUnit < m_uTextureUnits)
+		m_uTexture[uUnit] = a_uTexture;
+}
+void GLState::Invalidate(void)
+{
+	m_uProgram = static_cast<GLuint>(-1);
+	m_uVertexArray = static_cast<GLuint>(-1);
+	m_eActiveTexture = static_cast<GLenum>(-1);
+	for (uint i = 0; i < m_uTextureUnits; ++i)
+		m_uTexture[i] = static_cast<GLuint>(-1);
+}
+uint GLState::GetSkippedCallCount(void) { return m_uSkipped; }
+void GLState::ResetSkippedCallCount(void) { m_uSkipped = 0; }
@@ -1,4 +1,5 @@
 #include "BasicX\materials\MaterialManager.h"
+#include "BasicX\System\TextScanner.h"
 using namespace BasicX;
 //  MaterialManager
 MaterialManager* MaterialManager::m_pInstance = nullptr;
@@ -239,4 +240,87 @@ int MaterialManager::DuplicateMaterial(String a_sMaterialToDuplicate, String a_s
 	Material oMaterial = GetMaterialCopy(a_sMaterialToDuplicate);
 	oMaterial.SetName(a_sDesiredName);
 	return AddMaterial(oMaterial);
-}
\ No newline at end of file
+}int MaterialManager::LoadMaterialLibrary(String a_sFileName)
+{
+	std::vector<Material> lMaterial;
+	if (!ReadMaterialLibrary(a_sFileName, lMaterial))
+		return -1;
+	return AddMaterialList(lMaterial);
+}
+int MaterialManager::AddMaterialList(std::vector<Material> const& a_lMaterial)
+{
+	int nAdded = 0;
+	for (uint i = 0; i < a_lMaterial.size(); i++)
+	{
+		Material material = a_lMaterial[i];
+		if (IdentifyMaterial(material.GetName()) >= 0)
+			continue;
+		Material* pMaterial = new Material(material);
+		m_materialList.push_back(pMaterial);
+		m_map[pMaterial->GetName()] = static_cast<int>(m_materialList.size() - 1);
+		nAdded++;
+	}
+
+	//the maps of the whole list are loaded at once
+	if (nAdded > 0)
+		ReloadMaps();
+	return nAdded;
+}
+bool MaterialManager::ReadMaterialLibrary(String a_sFileName, std::vector<Material>& a_lMaterial)
+{
+	TextScanner scanner;
+	if (!scanner.Open(a_sFileName))
+		return false;
+
+	//maps are looked for by name in the textures folder, the path in the library is dropped
+	auto MapName = [](StringView a_Line) -> String
+	{
+		StringView token;
+		StringView last;
+		while (TextScanner::NextToken(a_Line, token))
+			last = token;
+		return FileReader::GetFileNameAndExtension(last.ToString());
+	};
+
+	Material* pMaterial = nullptr;
+	StringView line;
+	while (scanner.NextLine(line))
+	{
+		StringView keyword;
+		if (!TextScanner::NextToken(line, keyword) || keyword.m_pData[0] == '#')
+			continue;
+
+		if (keyword == "newmtl")
+		{
+			StringView name;
+			TextScanner::NextToken(line, name);
+			pMaterial = nullptr;
+			if (name.Empty())
+				continue;
+			a_lMaterial.push_back(Material(name.ToString()));
+			pMaterial = &a_lMaterial.back();
+		}
+		else if (pMaterial == nullptr)
+			continue;
+		else if (keyword == "Kd")
+		{
+			vector3 v3Color(1.0f);
+			StringView token;
+			for (uint i = 0; i < 3 && TextScanner::NextToken(line, token); i++)
+				TextScanner::ParseFloat(token, v3Color[i]);
+			pMaterial->SetDiffuse(v3Color);
+		}
+		else if (keyword == "map_Kd")
+		{
+			//setting the map resets the color, keep the one read
+			vector3 v3Color = pMaterial->GetDiffuse();
+			pMaterial->SetDiffuseMapName(MapName(line));
+			pMaterial->SetDiffuse(v3Color);
+		}
+		else if (keyword == "map_Bump" || keyword == "map_bump" || keyword == "bump" || keyword == "norm")
+			pMaterial->SetNormalMapName(MapName(line));
+		else if (keyword == "map_Ks")
+			pMaterial->SetSpecularMapName(MapName(line));
+	}
+	return true;
+}
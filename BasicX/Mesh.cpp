@@ -1,4 +1,8 @@
 #include "BasicX\Mesh\Mesh.h"
+#include "BasicX\System\TextScanner.h"
+#include <thread>
+#include <atomic>
+#include <cstring>
 using namespace BasicX;
 uint Mesh::m_nIndexer = 0;
 uint Mesh::m_uRenderCalls = 0;
@@ -16,6 +20,16 @@ void Mesh::Init(void)
 	
 	m_VAO = 0;
 	m_VBO = 0;
+	m_InstanceVBO = 0;
+	m_uInstanceCapacity = 0;
+	m_EBO = 0;
+	m_uIndexCount = 0;
+	m_eIndexType = GL_UNSIGNED_INT;
+	m_bIndexed = true;
+	m_eVertexFormat = VERTEX_PACKED;
+	m_uGPUMemory = 0;
+	m_v3Min = ZERO_V3;
+	m_v3Max = ZERO_V3;
 
 	m_v3Tint = DEFAULT_V3NEG;
 
@@ -37,6 +51,18 @@ void Mesh::Swap(Mesh& other)
 
 	std::swap(m_VAO, other.m_VAO);
 	std::swap(m_VBO, other.m_VBO);
+	std::swap(m_InstanceVBO, other.m_InstanceVBO);
+	std::swap(m_uInstanceCapacity, other.m_uInstanceCapacity);
+	std::swap(m_EBO, other.m_EBO);
+	std::swap(m_uIndexCount, other.m_uIndexCount);
+	std::swap(m_eIndexType, other.m_eIndexType);
+	std::swap(m_bIndexed, other.m_bIndexed);
+	std::swap(m_eVertexFormat, other.m_eVertexFormat);
+	std::swap(m_uGPUMemory, other.m_uGPUMemory);
+	std::swap(m_v3Min, other.m_v3Min);
+	std::swap(m_v3Max, other.m_v3Max);
+	std::swap(m_eResidency, other.m_eResidency);
+	std::swap(m_fnSource, other.m_fnSource);
 	std::swap(m_nShader, other.m_nShader);
 
 	std::swap(m_lVertex, other.m_lVertex);
@@ -65,6 +91,12 @@ void Mesh::Release(void)
 	if (m_VBO > 0)
 		glDeleteBuffers(1, &m_VBO);
 
+	if (m_InstanceVBO > 0)
+		glDeleteBuffers(1, &m_InstanceVBO);
+
+	if (m_EBO > 0)
+		glDeleteBuffers(1, &m_EBO);
+
 	if(m_VAO > 0 )
 		glDeleteVertexArrays(1, &m_VAO);
 	
@@ -99,6 +131,16 @@ Mesh::Mesh(Mesh& other)
 
 	m_VAO = other.m_VAO;
 	m_VBO = other.m_VBO;
+	m_InstanceVBO = other.m_InstanceVBO;
+	m_EBO = other.m_EBO;
+	m_uIndexCount = other.m_uIndexCount;
+	m_eIndexType = other.m_eIndexType;
+	m_bIndexed = other.m_bIndexed;
+	m_eVertexFormat = other.m_eVertexFormat;
+	m_eResidency = other.m_eResidency;
+	m_v3Min = other.m_v3Min;
+	m_v3Max = other.m_v3Max;
+	m_fnSource = other.m_fnSource;
 
 	m_nShader = other.m_nShader;
 
@@ -134,6 +176,16 @@ void Mesh::Instantiate(Mesh* const other)
 
 	m_VAO = other->m_VAO;
 	m_VBO = other->m_VBO;
+	m_InstanceVBO = other->m_InstanceVBO;
+	m_EBO = other->m_EBO;
+	m_uIndexCount = other->m_uIndexCount;
+	m_eIndexType = other->m_eIndexType;
+	m_bIndexed = other->m_bIndexed;
+	m_eVertexFormat = other->m_eVertexFormat;
+	m_eResidency = other->m_eResidency;
+	m_v3Min = other->m_v3Min;
+	m_v3Max = other->m_v3Max;
+	m_fnSource = other->m_fnSource;
 
 	m_nShader = other->m_nShader;
 
@@ -169,6 +221,72 @@ void Mesh::SetMaterial(String a_sMaterialName, String a_sDiffuseMapName, String
 }
 int Mesh::GetVertexCount(void){ return m_uVertexCount; }
 int  Mesh::GetMaterialIndex(void){return m_uMaterialIndex; }
+void Mesh::SetIndexed(bool a_bIndexed){ if (!m_bBinded) m_bIndexed = a_bIndexed; }
+bool Mesh::GetIndexed(void){ return m_bIndexed; }
+uint Mesh::GetIndexCount(void){ return m_uIndexCount; }
+void Mesh::SetVertexFormat(BTO_VERTEX a_eFormat){ if (!m_bBinded) m_eVertexFormat = a_eFormat; }
+BTO_VERTEX Mesh::GetVertexFormat(void){ return m_eVertexFormat; }
+void Mesh::SetResidency(BTO_RESIDENCY a_eResidency)
+{
+	m_eResidency = a_eResidency;
+	ReleaseCPUData();
+}
+BTO_RESIDENCY Mesh::GetResidency(void){ return m_eResidency; }
+void Mesh::SetSource(MeshSource a_fnSource){ m_fnSource = a_fnSource; }
+uint Mesh::GetGPUMemory(void){ return m_uGPUMemory; }
+size_t Mesh::GetResidentMemory(void)
+{
+	size_t uElements = m_lVertex.capacity() + m_lVertexPos.capacity() + m_lVertexCol.capacity() +
+		m_lVertexNor.capacity() + m_lVertexTan.capacity() + m_lVertexBin.capacity() + m_lVertexUV.capacity();
+	return uElements * sizeof(vector3);
+}
+bool Mesh::ReloadCPUData(void)
+{
+	if (m_fnSource == nullptr)
+		return false;
+
+	//build it again on the side, it stops before anything reaches the GPU or the managers
+	Mesh temp;
+	temp.m_bCPUOnly = true;
+	m_fnSource(&temp);
+	if (temp.m_uVertexCount != m_uVertexCount)
+		return false;
+	//loaders leave short the lists they do not fill and compiling completes them, it is done here too
+	//or the next Get would find them short and reload again
+	temp.CompleteMesh();
+
+	std::swap(m_lVertexPos, temp.m_lVertexPos);
+	std::swap(m_lVertexCol, temp.m_lVertexCol);
+	std::swap(m_lVertexNor, temp.m_lVertexNor);
+	std::swap(m_lVertexTan, temp.m_lVertexTan);
+	std::swap(m_lVertexBin, temp.m_lVertexBin);
+	std::swap(m_lVertexUV, temp.m_lVertexUV);
+	return true;
+}
+void Mesh::ReleaseCPUData(void)
+{
+	//until it is uploaded the lists are the only copy
+	if (!m_bBinded)
+		return;
+
+	//swapping with an empty list gives the memory back, clear would keep the capacity
+	std::vector<vector3>().swap(m_lVertex);
+	if (m_eResidency == RESIDENT_FULL)
+		return;
+	std::vector<vector3>().swap(m_lVertexCol);
+	std::vector<vector3>().swap(m_lVertexNor);
+	std::vector<vector3>().swap(m_lVertexTan);
+	std::vector<vector3>().swap(m_lVertexBin);
+	std::vector<vector3>().swap(m_lVertexUV);
+	if (m_eResidency == RESIDENT_POSITIONS)
+		return;
+	std::vector<vector3>().swap(m_lVertexPos);
+}
+void Mesh::RequireCPUData(std::vector<vector3> const& a_lList)
+{
+	if (m_bBinded && a_lList.size() < m_uVertexCount)
+		ReloadCPUData();
+}
 void Mesh::AddVertexPosition(vector3 input){ m_lVertexPos.push_back(input); m_uVertexCount++; }
 void Mesh::AddVertexPositionList(std::vector<vector3> a_lInput, matrix4 a_m4ModelToWorld)
 {
@@ -223,17 +341,17 @@ void Mesh::SetShaderProgram(String a_sShaderName)
 	return;
 }
 void Mesh::SetVertexList(std::vector<vector3> a_lVertex){ m_lVertexPos = a_lVertex; }
-std::vector<vector3> Mesh::GetVertexList(void){ return m_lVertexPos; }
+std::vector<vector3> Mesh::GetVertexList(void){ RequireCPUData(m_lVertexPos); return m_lVertexPos; }
 void Mesh::SetColorList(std::vector<vector3> a_lcolor) { m_lVertexCol = a_lcolor; }
-std::vector<vector3> Mesh::GetColorList(void){ return m_lVertexCol; }
+std::vector<vector3> Mesh::GetColorList(void){ RequireCPUData(m_lVertexCol); return m_lVertexCol; }
 void Mesh::SetUVList(std::vector<vector3> a_lUV) { m_lVertexUV = a_lUV; }
-std::vector<vector3> Mesh::GetUVList(void){ return m_lVertexUV; }
+std::vector<vector3> Mesh::GetUVList(void){ RequireCPUData(m_lVertexUV); return m_lVertexUV; }
 void Mesh::SetNormalList(std::vector<vector3> a_lNormal) { m_lVertexNor = a_lNormal; }
-std::vector<vector3> Mesh::GetNormalList(void){ return m_lVertexNor; }
+std::vector<vector3> Mesh::GetNormalList(void){ RequireCPUData(m_lVertexNor); return m_lVertexNor; }
 void Mesh::SetTangentList(std::vector<vector3> a_lTangent) { m_lVertexTan = a_lTangent; }
-std::vector<vector3> Mesh::GetTangentList(void){ return m_lVertexTan; }
+std::vector<vector3> Mesh::GetTangentList(void){ RequireCPUData(m_lVertexTan); return m_lVertexTan; }
 void Mesh::SetBitangentList(std::vector<vector3> a_lBitangent) { m_lVertexBin = a_lBitangent; }
-std::vector<vector3> Mesh::GetBitangetList(void){ return m_lVertexBin; }
+std::vector<vector3> Mesh::GetBitangetList(void){ RequireCPUData(m_lVertexBin); return m_lVertexBin; }
 uint Mesh::GetUniqueIdentifier(void) { return m_uID; }
 vector3 Mesh::GetTint(void){ return m_v3Tint; }
 void Mesh::SetTint(vector3 a_v3Tint) { m_v3Tint = a_v3Tint; }
@@ -241,7 +359,7 @@ String Mesh::GetName(void){ return m_sName; }
 void Mesh::SetName(String a_sName){ m_sName = a_sName; }
 GLuint Mesh::GetShaderIndex (void){ return m_nShader; }
 //Methods
-void Mesh::CompleteTriangleInfo(bool a_bAverageNormals)
+void Mesh::CompleteTriangleInfo(bool a_bAverageNormals, float a_fEpsilon)
 {
 	//Complete Colors
 	int nColors = static_cast<int>(m_lVertexCol.size());
@@ -290,29 +408,151 @@ void Mesh::CompleteTriangleInfo(bool a_bAverageNormals)
 	}
 
 	if(a_bAverageNormals)
+		AverageNormals(a_fEpsilon);
+}
+void Mesh::CompleteTriangleInfoList(std::vector<Mesh*> a_lMesh, bool a_bAverageNormals, float a_fEpsilon)
+{
+	//every worker takes the next mesh nobody has taken yet
+	std::atomic<uint> uNext(0);
+	auto Worker = [&]()
 	{
-		for(uint i = 0; i < m_uVertexCount; i++)
+		for (uint nMesh = uNext++; nMesh < a_lMesh.size(); nMesh = uNext++)
 		{
-			std::vector<int> vIndices;
-			for (uint j = i; j < m_uVertexCount; j++)
-			{
-				if(m_lVertexPos[i] == m_lVertexPos[j])
-					vIndices.push_back(j);
-			}
-			int nSize = static_cast<int> (vIndices.size());
-			vector3 normalAverage = ZERO_V3;
-			for (int k = 0; k < nSize; k++)
+			if (a_lMesh[nMesh] != nullptr)
+				a_lMesh[nMesh]->CompleteTriangleInfo(a_bAverageNormals, a_fEpsilon);
+		}
+	};
+
+	uint uThreads = std::thread::hardware_concurrency();
+	if (uThreads > a_lMesh.size())
+		uThreads = a_lMesh.size();
+	//this thread works too
+	std::vector<std::thread> lThread;
+	for (uint i = 1; i < uThreads; i++)
+		lThread.push_back(std::thread(Worker));
+	Worker();
+	for (uint i = 0; i < lThread.size(); i++)
+		lThread[i].join();
+}
+void Mesh::AverageNormals(float a_fEpsilon)
+{
+	uint uCount = m_lVertexNor.size() < m_uVertexCount ? m_lVertexNor.size() : m_uVertexCount;
+	if (uCount < 2)
+		return;
+	//with no tolerance only equal positions are the same point, they share a cell of any size
+	float fCellSize = a_fEpsilon > 0.0f ? a_fEpsilon : 1.0f;
+
+	//every position falls in a cell of epsilon size, any two in the same cell are the same point
+	struct VertexCell
+	{
+		long long x, y, z;
+		uint nVertex;
+	};
+	std::vector<VertexCell> lCell(uCount);
+	for (uint i = 0; i < uCount; i++)
+	{
+		vector3 const& v3Position = m_lVertexPos[i];
+		lCell[i].x = static_cast<long long>(std::floor(v3Position.x / fCellSize));
+		lCell[i].y = static_cast<long long>(std::floor(v3Position.y / fCellSize));
+		lCell[i].z = static_cast<long long>(std::floor(v3Position.z / fCellSize));
+		lCell[i].nVertex = i;
+	}
+	auto CellLess = [](VertexCell const& a, VertexCell const& b)
+	{
+		if (a.x != b.x) return a.x < b.x;
+		if (a.y != b.y) return a.y < b.y;
+		return a.z < b.z;
+	};
+	std::sort(lCell.begin(), lCell.end(), CellLess);
+
+	//union find of the vertices at the same point, each group points to one of its members
+	std::vector<uint> lGroup(uCount);
+	for (uint i = 0; i < uCount; i++)
+		lGroup[i] = i;
+	auto Find = [&lGroup](uint a_nVertex)
+	{
+		while (lGroup[a_nVertex] != a_nVertex)
+		{
+			lGroup[a_nVertex] = lGroup[lGroup[a_nVertex]];
+			a_nVertex = lGroup[a_nVertex];
+		}
+		return a_nVertex;
+	};
+	auto SamePoint = [&](uint a_nA, uint a_nB)
+	{
+		vector3 const& v3A = m_lVertexPos[a_nA];
+		vector3 const& v3B = m_lVertexPos[a_nB];
+		if (a_fEpsilon > 0.0f)
+			return std::abs(v3A.x - v3B.x) <= a_fEpsilon && std::abs(v3A.y - v3B.y) <= a_fEpsilon && std::abs(v3A.z - v3B.z) <= a_fEpsilon;
+		return v3A == v3B;
+	};
+
+	//the vertices of a cell are consecutive after sorting, each run starts where the cell changes
+	std::vector<uint> lRunStart;
+	for (uint i = 0; i < uCount; i++)
+	{
+		if (i == 0 || CellLess(lCell[i - 1], lCell[i]))
+			lRunStart.push_back(i);
+		else if (a_fEpsilon > 0.0f || SamePoint(lCell[lRunStart.back()].nVertex, lCell[i].nVertex))
+			lGroup[Find(lCell[i].nVertex)] = Find(lCell[lRunStart.back()].nVertex);
+		else
+		{
+			//exact mode, the cell holds different points, compare against everything before in it
+			for (uint j = lRunStart.back(); j < i; j++)
 			{
-				normalAverage += m_lVertexNor[vIndices[k]];
+				if (SamePoint(lCell[j].nVertex, lCell[i].nVertex))
+				{
+					lGroup[Find(lCell[i].nVertex)] = Find(lCell[j].nVertex);
+					break;
+				}
 			}
-			if (normalAverage != ZERO_V3)
-				normalAverage = glm::normalize(normalAverage);
-			for (int k = 0; k < nSize; k++)
+		}
+	}
+	lRunStart.push_back(uCount);
+
+	//points within epsilon can also sit in neighboring cells, look at the 13 neighbors after this one
+	if (a_fEpsilon > 0.0f)
+	{
+		uint uRunCount = lRunStart.size() - 1;
+		for (uint nRun = 0; nRun < uRunCount; nRun++)
+		{
+			VertexCell const& cell = lCell[lRunStart[nRun]];
+			for (int dx = 0; dx <= 1; dx++)
+			for (int dy = -1; dy <= 1; dy++)
+			for (int dz = -1; dz <= 1; dz++)
 			{
-				m_lVertexNor[vIndices[k]] = normalAverage;
+				if (dx == 0 && (dy < 0 || (dy == 0 && dz <= 0)))
+					continue;
+				VertexCell neighbor = { cell.x + dx, cell.y + dy, cell.z + dz, 0 };
+				std::vector<VertexCell>::iterator it = std::lower_bound(lCell.begin(), lCell.end(), neighbor, CellLess);
+				if (it == lCell.end() || CellLess(neighbor, *it))
+					continue;
+				uint nBegin = it - lCell.begin();
+				//the cells are merged already through some other pair
+				if (Find(cell.nVertex) == Find(it->nVertex))
+					continue;
+				uint nEnd = *std::upper_bound(lRunStart.begin(), lRunStart.end(), nBegin);
+				bool bFound = false;
+				for (uint i = lRunStart[nRun]; i < lRunStart[nRun + 1] && !bFound; i++)
+				{
+					for (uint j = nBegin; j < nEnd && !bFound; j++)
+						bFound = SamePoint(lCell[i].nVertex, lCell[j].nVertex);
+				}
+				if (bFound)
+					lGroup[Find(it->nVertex)] = Find(cell.nVertex);
 			}
 		}
 	}
+
+	//add the normals of each group in its root and hand the normalized sum back to every member
+	std::vector<vector3> lSum(uCount, ZERO_V3);
+	for (uint i = 0; i < uCount; i++)
+		lSum[Find(i)] += m_lVertexNor[i];
+	for (uint i = 0; i < uCount; i++)
+	{
+		vector3 v3Sum = lSum[Find(i)];
+		m_lVertexNor[i] = v3Sum != ZERO_V3 ? glm::normalize(v3Sum) : ZERO_V3;
+	}
 }
 void Mesh::CalculateTangents(void)
 {
@@ -375,6 +615,8 @@ void Mesh::DisconnectOpenGL3X(void)
 {
 	m_VAO = 0;
 	m_VBO = 0;
+	m_InstanceVBO = 0;
+	m_EBO = 0;
 }
 void Mesh::CompleteMesh(vector3 a_v3Color)
 {
@@ -408,6 +650,18 @@ void Mesh::CompileOpenGL3X(void)
 
 	CompleteMesh();
 
+	//only the vertex lists were wanted
+	if (m_bCPUOnly)
+		return;
+
+	//bounding box in local space, goes in the cache with the buffers
+	m_v3Min = m_v3Max = m_lVertexPos[0];
+	for (uint i = 1; i < m_uVertexCount; i++)
+	{
+		m_v3Min = glm::min(m_v3Min, m_lVertexPos[i]);
+		m_v3Max = glm::max(m_v3Max, m_lVertexPos[i]);
+	}
+
 	for (uint i = 0; i < m_uVertexCount; i++)
 	{
 		//Position
@@ -423,36 +677,56 @@ void Mesh::CompileOpenGL3X(void)
 		//Tangent
 		m_lVertex.push_back(m_lVertexTan[i]);
 	}
+
+	//Every corner of the soup is its own vertex, weld the repeated ones and draw with indices instead
+	std::vector<uint> lIndex;
+	uint uBufferVertexCount = m_uVertexCount;
+	if (m_bIndexed && m_uVertexCount % 3 == 0)
+	{
+		uBufferVertexCount = WeldVertices(lIndex);
+		OptimizeVertexCache(lIndex, uBufferVertexCount);
+		OptimizeVertexFetch(lIndex);
+	}
+
 	glGenVertexArrays( 1, &m_VAO );//Generate vertex array object
 	glGenBuffers(1, &m_VBO);//Generate Vertex Buffered Object
 	
-	glBindVertexArray( m_VAO );//Bind the VAO
+	GLState::BindVertexArray(m_VAO);//Bind the VAO
 	glBindBuffer(GL_ARRAY_BUFFER, m_VBO);//Bind the VBO
-	glBufferData(GL_ARRAY_BUFFER, m_uVertexCount * 6 * sizeof(vector3), &m_lVertex[0], GL_STATIC_DRAW);//Generate space for the VBO
+	// Interleaved vertices in the layout of the mesh, the descriptor points every attribute at its spot
+	VertexLayout layout(m_eVertexFormat);
+	std::vector<unsigned char> lBuffer;
+	layout.Pack(m_lVertex, lBuffer);
+	glBufferData(GL_ARRAY_BUFFER, uBufferVertexCount * layout.GetStride(), &lBuffer[0], GL_STATIC_DRAW);//Generate space for the VBO
+	m_uGPUMemory = uBufferVertexCount * layout.GetStride();
+	layout.Apply();
+
+	CreateInstanceBuffer();
+
+	// Index buffer, the VAO remembers it; 16 bit indices if every welded vertex fits in them
+	m_uIndexCount = lIndex.size();
+	if (m_uIndexCount > 0)
+	{
+		glGenBuffers(1, &m_EBO);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_EBO);
+		if (uBufferVertexCount <= 65536)
+		{
+			std::vector<GLushort> lShortIndex(lIndex.begin(), lIndex.end());
+			m_eIndexType = GL_UNSIGNED_SHORT;
+			glBufferData(GL_ELEMENT_ARRAY_BUFFER, m_uIndexCount * sizeof(GLushort), &lShortIndex[0], GL_STATIC_DRAW);
+			m_uGPUMemory += m_uIndexCount * sizeof(GLushort);
+		}
+		else
+		{
+			m_eIndexType = GL_UNSIGNED_INT;
+			glBufferData(GL_ELEMENT_ARRAY_BUFFER, m_uIndexCount * sizeof(GLuint), &lIndex[0], GL_STATIC_DRAW);
+			m_uGPUMemory += m_uIndexCount * sizeof(GLuint);
+		}
+	}
 
-	// Position attribute
-	glEnableVertexAttribArray(0);
-	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(vector3), (GLvoid*)0);
-
-	// Color attribute
-	glEnableVertexAttribArray(1);
-	glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(vector3), (GLvoid*)(1 * sizeof(vector3)));
-	
-	// UV attribute
-	glEnableVertexAttribArray(2);
-	glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(vector3), (GLvoid*)(2 * sizeof(vector3)));
-	
-	// Normal attribute
-	glEnableVertexAttribArray(3);
-	glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(vector3), (GLvoid*)(3 * sizeof(vector3)));
-	
-	// Bi-Normal attribute
-	glEnableVertexAttribArray(4);
-	glVertexAttribPointer(4, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(vector3), (GLvoid*)(4 * sizeof(vector3)));
-	
-	// Tangent attribute
-	glEnableVertexAttribArray(5);
-	glVertexAttribPointer(5, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(vector3), (GLvoid*)(5 * sizeof(vector3)));
+	//the Simplex shader has a variant that renormalizes the quantized directions
+	if (m_eVertexFormat != VERTEX_FLOAT && m_nShader == m_pShaderMngr->GetShaderID("Simplex"))
+		SetShaderProgram("SimplexPacked");
 
 	if(m_uMaterialIndex < 0)
 	{
@@ -468,10 +742,481 @@ void Mesh::CompileOpenGL3X(void)
 
 	m_bBinded = true;
 
-	glBindVertexArray(0); // Unbind VAO
+	GLState::BindVertexArray(0); // Unbind VAO
+
+	//the GPU has its copy, keep only what the residency asks for
+	ReleaseCPUData();
 
 	return;
 }
+uint Mesh::WeldVertices(std::vector<uint>& a_lIndex)
+{
+	const uint uStride = 6; //attributes per vertex in the composed array
+	uint uCornerCount = m_lVertex.size() / uStride;
+	a_lIndex.clear();
+	a_lIndex.reserve(uCornerCount);
+
+	//open addressing table of welded vertices, at most half full so the probes stay short
+	uint uTableSize = 1;
+	while (uTableSize < uCornerCount * 2)
+		uTableSize <<= 1;
+	std::vector<int> lTable(uTableSize, -1);
+
+	uint uWelded = 0;
+	for (uint nCorner = 0; nCorner < uCornerCount; ++nCorner)
+	{
+		vector3* pCorner = &m_lVertex[nCorner * uStride];
+
+		//FNV-1a over the bits of every component, adding 0 turns -0 into 0 so both hash the same
+		uint uHash = 2166136261u;
+		for (uint i = 0; i < uStride; ++i)
+		{
+			for (uint j = 0; j < 3; ++j)
+			{
+				float fValue = pCorner[i][j] + 0.0f;
+				uint uBits;
+				memcpy(&uBits, &fValue, sizeof(uint));
+				uHash = (uHash ^ uBits) * 16777619u;
+			}
+		}
+
+		uint uSlot = uHash & (uTableSize - 1);
+		while (lTable[uSlot] >= 0 && !std::equal(pCorner, pCorner + uStride, &m_lVertex[lTable[uSlot] * uStride]))
+			uSlot = (uSlot + 1) & (uTableSize - 1);
+
+		if (lTable[uSlot] < 0)
+		{
+			//first time this vertex shows up, move it down next to the other welded ones
+			lTable[uSlot] = uWelded;
+			if (uWelded != nCorner)
+				std::copy(pCorner, pCorner + uStride, &m_lVertex[uWelded * uStride]);
+			++uWelded;
+		}
+		a_lIndex.push_back(lTable[uSlot]);
+	}
+
+	m_lVertex.resize(uWelded * uStride);
+	return uWelded;
+}
+//Score of a vertex for the cache optimization, higher means its triangles should be drawn sooner
+static float VertexCacheScore(int a_nCachePosition, uint a_uTrianglesLeft, int a_nCacheSize)
+{
+	//nothing left to draw with this vertex
+	if (a_uTrianglesLeft == 0)
+		return -1.0f;
+
+	float fScore = 0.0f;
+	if (a_nCachePosition >= 0)
+	{
+		//the vertices of the last triangle get a fixed score so its winding does not matter
+		if (a_nCachePosition < 3)
+			fScore = 0.75f;
+		else
+			fScore = pow(1.0f - (a_nCachePosition - 3) / static_cast<float>(a_nCacheSize - 3), 1.5f);
+	}
+	//vertices with few triangles left are finished off before they leave the cache
+	fScore += 2.0f / sqrt(static_cast<float>(a_uTrianglesLeft));
+	return fScore;
+}
+void Mesh::OptimizeVertexCache(std::vector<uint>& a_lIndex, uint a_uVertexCount)
+{
+	const int nCacheSize = 32; //entries of the simulated cache
+	uint uTriangleCount = a_lIndex.size() / 3;
+	if (uTriangleCount < 2)
+		return;
+
+	//triangles that use each vertex, all in a single list with an offset per vertex
+	std::vector<uint> lTrianglesLeft(a_uVertexCount, 0);
+	for (uint i = 0; i < a_lIndex.size(); ++i)
+		lTrianglesLeft[a_lIndex[i]]++;
+	std::vector<uint> lOffset(a_uVertexCount + 1, 0);
+	for (uint nVertex = 0; nVertex < a_uVertexCount; ++nVertex)
+		lOffset[nVertex + 1] = lOffset[nVertex] + lTrianglesLeft[nVertex];
+	std::vector<uint> lAdjacency(a_lIndex.size());
+	std::vector<uint> lFill(lOffset.begin(), lOffset.end() - 1);
+	for (uint i = 0; i < a_lIndex.size(); ++i)
+		lAdjacency[lFill[a_lIndex[i]]++] = i / 3;
+
+	std::vector<float> lVertexScore(a_uVertexCount);
+	for (uint nVertex = 0; nVertex < a_uVertexCount; ++nVertex)
+		lVertexScore[nVertex] = VertexCacheScore(-1, lTrianglesLeft[nVertex], nCacheSize);
+
+	std::vector<bool> lDrawn(uTriangleCount, false);
+	std::vector<uint> lOutput;
+	lOutput.reserve(a_lIndex.size());
+	std::vector<uint> lCache;
+	std::vector<uint> lNewCache;
+	lCache.reserve(nCacheSize + 3);
+	lNewCache.reserve(nCacheSize + 3);
+
+	int nBest = -1;
+	uint uNextTriangle = 0;
+	while (lOutput.size() < a_lIndex.size())
+	{
+		if (nBest < 0)
+		{
+			//nothing in the cache has triangles left, carry on from the first one not drawn
+			while (lDrawn[uNextTriangle])
+				++uNextTriangle;
+			nBest = uNextTriangle;
+		}
+
+		lDrawn[nBest] = true;
+		lNewCache.clear();
+		for (uint i = 0; i < 3; ++i)
+		{
+			uint nVertex = a_lIndex[nBest * 3 + i];
+			lOutput.push_back(nVertex);
+
+			//degenerate triangles repeat vertices, each one goes in the cache once
+			if (std::find(lNewCache.begin(), lNewCache.end(), nVertex) != lNewCache.end())
+				continue;
+			lNewCache.push_back(nVertex);
+
+			//the triangle is drawn, take it off the ones left for the vertex
+			uint* pBegin = &lAdjacency[lOffset[nVertex]];
+			uint* pEnd = pBegin + lTrianglesLeft[nVertex];
+			uint* pFound = std::find(pBegin, pEnd, static_cast<uint>(nBest));
+			std::swap(*pFound, *(pEnd - 1));
+			lTrianglesLeft[nVertex]--;
+		}
+		//the rest of the cache goes after the triangle, minus the vertices it just used
+		uint uUsed = lNewCache.size();
+		for (uint i = 0; i < lCache.size(); ++i)
+		{
+			if (std::find(lNewCache.begin(), lNewCache.begin() + uUsed, lCache[i]) == lNewCache.begin() + uUsed)
+				lNewCache.push_back(lCache[i]);
+		}
+		lCache.swap(lNewCache);
+
+		//vertices that fell off the cache lose their position, the ones that stayed move back
+		for (uint i = 0; i < lCache.size(); ++i)
+		{
+			int nPosition = i < static_cast<uint>(nCacheSize) ? static_cast<int>(i) : -1;
+			lVertexScore[lCache[i]] = VertexCacheScore(nPosition, lTrianglesLeft[lCache[i]], nCacheSize);
+		}
+
+		//only the triangles around the cache changed score, the best of them goes next
+		nBest = -1;
+		float fBest = -1.0f;
+		for (uint i = 0; i < lCache.size(); ++i)
+		{
+			uint nVertex = lCache[i];
+			for (uint j = lOffset[nVertex]; j < lOffset[nVertex] + lTrianglesLeft[nVertex]; ++j)
+			{
+				uint nTriangle = lAdjacency[j];
+				float fScore = lVertexScore[a_lIndex[nTriangle * 3]] +
+					lVertexScore[a_lIndex[nTriangle * 3 + 1]] +
+					lVertexScore[a_lIndex[nTriangle * 3 + 2]];
+				if (fScore > fBest)
+				{
+					fBest = fScore;
+					nBest = nTriangle;
+				}
+			}
+		}
+		if (lCache.size() > static_cast<uint>(nCacheSize))
+			lCache.resize(nCacheSize);
+	}
+
+	a_lIndex.swap(lOutput);
+}
+void Mesh::OptimizeVertexFetch(std::vector<uint>& a_lIndex)
+{
+	const uint uStride = 6; //attributes per vertex in the composed array
+	std::vector<int> lRemap(m_lVertex.size() / uStride, -1);
+	std::vector<vector3> lVertex;
+	lVertex.reserve(m_lVertex.size());
+
+	for (uint i = 0; i < a_lIndex.size(); ++i)
+	{
+		uint nVertex = a_lIndex[i];
+		if (lRemap[nVertex] < 0)
+		{
+			lRemap[nVertex] = lVertex.size() / uStride;
+			lVertex.insert(lVertex.end(), m_lVertex.begin() + nVertex * uStride, m_lVertex.begin() + (nVertex + 1) * uStride);
+		}
+		a_lIndex[i] = lRemap[nVertex];
+	}
+
+	//vertices no triangle uses are dropped
+	m_lVertex.swap(lVertex);
+}
+void Mesh::CreateInstanceBuffer(void)
+{
+	// Model to world attribute, one matrix per instance, a mat4 takes 4 locations, one per column
+	glGenBuffers(1, &m_InstanceVBO);
+	glBindBuffer(GL_ARRAY_BUFFER, m_InstanceVBO);
+	for (GLuint nColumn = 0; nColumn < 4; ++nColumn)
+	{
+		glEnableVertexAttribArray(6 + nColumn);
+		glVertexAttribPointer(6 + nColumn, 4, GL_FLOAT, GL_FALSE, sizeof(matrix4), (GLvoid*)(nColumn * sizeof(vector4)));
+		glVertexAttribDivisor(6 + nColumn, 1);
+	}
+	m_uInstanceCapacity = 0;
+}
+bool Mesh::SaveCache(String a_sFileName)
+{
+	//copies share the buffers of their original, the original writes them
+	if (!m_bBinded || m_pOriginal != nullptr || m_VBO == 0)
+		return false;
+
+	VertexLayout layout(m_eVertexFormat);
+	MeshCacheHeader header = {};
+	header.m_uVertexFormat = m_eVertexFormat;
+	header.m_uStride = layout.GetStride();
+	header.m_uIndexCount = m_uIndexCount;
+	header.m_uIndexType = m_eIndexType;
+	header.m_uCornerCount = m_uVertexCount;
+	header.m_uIndexBytes = m_uIndexCount * (m_eIndexType == GL_UNSIGNED_SHORT ? sizeof(GLushort) : sizeof(GLuint));
+	header.m_uVertexBytes = m_uGPUMemory - header.m_uIndexBytes;
+	header.m_uVertexCount = header.m_uVertexBytes / header.m_uStride;
+	for (uint i = 0; i < 3; i++)
+	{
+		header.m_fMin[i] = m_v3Min[i];
+		header.m_fMax[i] = m_v3Max[i];
+	}
+
+	bool bFits = MeshCache::SetField(header.m_sName, m_sName);
+	if (m_uMaterialIndex < static_cast<uint>(m_pMatMngr->GetMaterialCount()))
+	{
+		bFits = bFits && MeshCache::SetField(header.m_sMaterial, m_pMatMngr->GetMaterial(m_uMaterialIndex)->GetName());
+		bFits = bFits && MeshCache::SetField(header.m_sDiffuse, m_pMatMngr->GetDiffuseMapName(m_uMaterialIndex));
+		bFits = bFits && MeshCache::SetField(header.m_sNormal, m_pMatMngr->GetNormalMapName(m_uMaterialIndex));
+		bFits = bFits && MeshCache::SetField(header.m_sSpecular, m_pMatMngr->GetSpecularMapName(m_uMaterialIndex));
+	}
+	if (!bFits)
+		return false;
+
+	//the CPU copy may be gone already, read the buffers back from the GPU
+	std::vector<unsigned char> lVertex(header.m_uVertexBytes);
+	std::vector<unsigned char> lIndex(header.m_uIndexBytes);
+	GLState::BindVertexArray(m_VAO);
+	glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
+	glGetBufferSubData(GL_ARRAY_BUFFER, 0, header.m_uVertexBytes, &lVertex[0]);
+	if (header.m_uIndexBytes > 0)
+		glGetBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, header.m_uIndexBytes, &lIndex[0]);
+	GLState::BindVertexArray(0);
+
+	return MeshCache::Write(a_sFileName, header, &lVertex[0], header.m_uIndexBytes > 0 ? &lIndex[0] : nullptr);
+}
+bool Mesh::LoadCache(String a_sFileName)
+{
+	MeshCache cache;
+	if (!cache.Open(a_sFileName))
+		return false;
+	MeshCacheHeader const* pHeader = cache.GetHeader();
+	if (pHeader->m_uVertexFormat > VERTEX_PACKED_HALF || pHeader->m_uVertexCount == 0)
+		return false;
+	VertexLayout layout(static_cast<BTO_VERTEX>(pHeader->m_uVertexFormat));
+	if (layout.GetStride() != pHeader->m_uStride)
+		return false;
+
+	Release();
+	Init();
+
+	m_sName = pHeader->m_sName;
+	m_eVertexFormat = layout.GetFormat();
+	m_uVertexCount = pHeader->m_uCornerCount;
+	m_uIndexCount = pHeader->m_uIndexCount;
+	m_eIndexType = pHeader->m_uIndexType;
+	m_v3Min = vector3(pHeader->m_fMin[0], pHeader->m_fMin[1], pHeader->m_fMin[2]);
+	m_v3Max = vector3(pHeader->m_fMax[0], pHeader->m_fMax[1], pHeader->m_fMax[2]);
+
+	//the mapped pages go to the driver as they are
+	glGenVertexArrays(1, &m_VAO);
+	glGenBuffers(1, &m_VBO);
+	GLState::BindVertexArray(m_VAO);
+	glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
+	glBufferData(GL_ARRAY_BUFFER, pHeader->m_uVertexBytes, cache.GetVertexData(), GL_STATIC_DRAW);
+	layout.Apply();
+	CreateInstanceBuffer();
+	if (m_uIndexCount > 0)
+	{
+		glGenBuffers(1, &m_EBO);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_EBO);
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, pHeader->m_uIndexBytes, cache.GetIndexData(), GL_STATIC_DRAW);
+	}
+	m_uGPUMemory = pHeader->m_uVertexBytes + pHeader->m_uIndexBytes;
+	GLState::BindVertexArray(0);
+
+	if (pHeader->m_sMaterial[0] != '\0')
+		m_uMaterialIndex = m_pMatMngr->AddMaterial(pHeader->m_sMaterial, pHeader->m_sDiffuse, pHeader->m_sNormal, pHeader->m_sSpecular);
+	if (m_eVertexFormat != VERTEX_FLOAT && m_nShader == m_pShaderMngr->GetShaderID("Simplex"))
+		SetShaderProgram("SimplexPacked");
+
+	//collisions need the positions, read them out of the buffer one corner at a time
+	if (m_eResidency != RESIDENT_NONE)
+	{
+		unsigned char const* pVertex = static_cast<unsigned char const*>(cache.GetVertexData());
+		m_lVertexPos.resize(m_uVertexCount);
+		for (uint nCorner = 0; nCorner < m_uVertexCount; nCorner++)
+		{
+			uint nVertex = nCorner;
+			if (m_uIndexCount > 0 && m_eIndexType == GL_UNSIGNED_SHORT)
+				nVertex = static_cast<GLushort const*>(cache.GetIndexData())[nCorner];
+			else if (m_uIndexCount > 0)
+				nVertex = static_cast<GLuint const*>(cache.GetIndexData())[nCorner];
+			if (nVertex >= pHeader->m_uVertexCount)
+				nVertex = 0;
+
+			unsigned char const* pPosition = pVertex + nVertex * pHeader->m_uStride;
+			if (m_eVertexFormat == VERTEX_PACKED_HALF)
+			{
+				unsigned short position[3];
+				memcpy(position, pPosition, sizeof(position));
+				m_lVertexPos[nCorner] = vector3(VertexLayout::HalfToFloat(position[0]),
+					VertexLayout::HalfToFloat(position[1]), VertexLayout::HalfToFloat(position[2]));
+			}
+			else
+				memcpy(&m_lVertexPos[nCorner], pPosition, sizeof(vector3));
+		}
+	}
+
+	m_bBinded = true;
+	return true;
+}
+bool Mesh::LoadCached(String a_sSource, MeshSource a_fnBuild)
+{
+	String sCache = MeshCache::GetCachePath(a_sSource);
+	if (MeshCache::IsFresh(a_sSource, sCache) && LoadCache(sCache))
+	{
+		m_fnSource = a_fnBuild;
+		return true;
+	}
+
+	//no cache or an old one, build from the source and leave a cache for the next run
+	if (a_fnBuild == nullptr)
+		return false;
+	a_fnBuild(this);
+	CompileOpenGL3X();
+	m_fnSource = a_fnBuild;
+	if (!m_bBinded)
+		return false;
+	SaveCache(sCache);
+	return true;
+}
+bool Mesh::LoadOBJ(String a_sFileName)
+{
+	std::vector<String> lLibrary;
+	String sMaterial = "";
+	if (!ParseOBJ(a_sFileName, lLibrary, sMaterial))
+		return false;
+
+	//reloading the vertices, the materials were registered by the first load
+	if (m_bCPUOnly)
+		return true;
+	for (uint i = 0; i < lLibrary.size(); i++)
+		m_pMatMngr->LoadMaterialLibrary(lLibrary[i]);
+	if (sMaterial != "")
+		SetMaterial(sMaterial);
+	return true;
+}
+bool Mesh::ParseOBJ(String a_sFileName, std::vector<String>& a_lLibrary, String& a_sMaterial)
+{
+	TextScanner scanner;
+	if (!scanner.Open(a_sFileName))
+		return false;
+
+	//libraries are next to the file
+	String sFolder = "";
+	size_t uSlash = a_sFileName.find_last_of("\\/");
+	if (uSlash != String::npos)
+		sFolder = a_sFileName.substr(0, uSlash + 1);
+
+	std::vector<vector3> lPosition;
+	std::vector<vector3> lUV;
+	std::vector<vector3> lNormal;
+	std::vector<int> lCorner; //position, uv and normal of each corner of the face, -1 if missing
+	uint uFirstVertex = m_uVertexCount;
+
+	//indices count from 1, or back from the last one read if negative
+	auto Resolve = [](StringView a_Token, size_t a_uCount) -> int
+	{
+		int nIndex;
+		if (a_Token.Empty() || !TextScanner::ParseInt(a_Token, nIndex))
+			return -1;
+		nIndex = nIndex < 0 ? static_cast<int>(a_uCount) + nIndex : nIndex - 1;
+		return (nIndex >= 0 && nIndex < static_cast<int>(a_uCount)) ? nIndex : -1;
+	};
+	auto ReadVector = [](StringView a_Line, uint a_uComponents) -> vector3
+	{
+		vector3 v3Output(0.0f);
+		StringView token;
+		for (uint i = 0; i < a_uComponents && TextScanner::NextToken(a_Line, token); i++)
+			TextScanner::ParseFloat(token, v3Output[i]);
+		return v3Output;
+	};
+
+	StringView line;
+	while (scanner.NextLine(line))
+	{
+		StringView keyword;
+		if (!TextScanner::NextToken(line, keyword))
+			continue;
+
+		if (keyword == "v")
+			lPosition.push_back(ReadVector(line, 3));
+		else if (keyword == "vt")
+			lUV.push_back(ReadVector(line, 2));
+		else if (keyword == "vn")
+			lNormal.push_back(ReadVector(line, 3));
+		else if (keyword == "f")
+		{
+			lCorner.clear();
+			StringView token;
+			while (TextScanner::NextToken(line, token))
+			{
+				int nPosition = Resolve(TextScanner::Split(token, '/'), lPosition.size());
+				int nUV = Resolve(TextScanner::Split(token, '/'), lUV.size());
+				int nNormal = Resolve(TextScanner::Split(token, '/'), lNormal.size());
+				if (nPosition < 0)
+					break;
+				lCorner.push_back(nPosition);
+				lCorner.push_back(nUV);
+				lCorner.push_back(nNormal);
+			}
+
+			//fan from the first corner
+			uint uCorners = lCorner.size() / 3;
+			for (uint nTri = 1; nTri + 1 < uCorners; nTri++)
+			{
+				int const* pCorner[3] = { &lCorner[0], &lCorner[nTri * 3], &lCorner[(nTri + 1) * 3] };
+				vector3 v3Face = glm::cross(lPosition[pCorner[1][0]] - lPosition[pCorner[0][0]],
+					lPosition[pCorner[2][0]] - lPosition[pCorner[0][0]]);
+				v3Face = glm::length(v3Face) > 0.0f ? glm::normalize(v3Face) : vector3(0.0f, 0.0f, 1.0f);
+				for (uint i = 0; i < 3; i++)
+				{
+					AddVertexPosition(lPosition[pCorner[i][0]]);
+					AddVertexUV(pCorner[i][1] >= 0 ? lUV[pCorner[i][1]] : vector3(0.0f));
+					AddVertexNormal(pCorner[i][2] >= 0 ? lNormal[pCorner[i][2]] : v3Face);
+				}
+			}
+		}
+		else if (keyword == "usemtl")
+		{
+			StringView name;
+			if (a_sMaterial == "" && TextScanner::NextToken(line, name))
+				a_sMaterial = name.ToString();
+		}
+		else if (keyword == "mtllib")
+		{
+			StringView library;
+			while (TextScanner::NextToken(line, library))
+				a_lLibrary.push_back(sFolder + library.ToString());
+		}
+	}
+
+	if (m_uVertexCount == uFirstVertex)
+		return false;
+
+	m_sName = FileReader::GetFileName(a_sFileName);
+	if (!lUV.empty() && m_lVertexTan.empty() && m_lVertexBin.empty())
+		CalculateTangents();
+	return true;
+}
+vector3 Mesh::GetMin(void) { return m_v3Min; }
+vector3 Mesh::GetMax(void) { return m_v3Max; }
 GLuint Mesh::GetVAO(void)
 {
 	return m_VAO;
@@ -542,6 +1287,7 @@ void Mesh::GeneratePlane(float a_fSize, vector3 a_v3Color)
 		"," + std::to_string(a_v3Color.y) +
 		"," + std::to_string(a_v3Color.z) + ")";
 	SetShaderProgram("BasicColor");
+	m_fnSource = [a_fSize, a_v3Color](Mesh* a_pMesh) { a_pMesh->GeneratePlane(a_fSize, a_v3Color); };
 }
 void Mesh::GenerateCube(float a_fSize, vector3 a_v3Color)
 {
@@ -589,6 +1335,7 @@ void Mesh::GenerateCube(float a_fSize, vector3 a_v3Color)
 		"," + std::to_string(a_v3Color.y) +
 		"," + std::to_string(a_v3Color.z) + ")";
 	SetShaderProgram("BasicColor");
+	m_fnSource = [a_fSize, a_v3Color](Mesh* a_pMesh) { a_pMesh->GenerateCube(a_fSize, a_v3Color); };
 }
 void Mesh::GenerateCuboid(vector3 a_v3Dimensions, vector3 a_v3Color)
 {
@@ -707,9 +1454,13 @@ void Mesh::GenerateSkybox(void)
 
 	CompleteMesh(C_WHITE);
 	CompileOpenGL3X();
+	//reloading the vertices, the material and its texture were registered by the first one
+	if (m_bCPUOnly)
+		return;
 	m_sName = "Skybox_Skybox.png";
 	SetMaterial("Skybox", "Skybox.png");
 	SetShaderProgram("Skybox");
+	m_fnSource = [](Mesh* a_pMesh) { a_pMesh->GenerateSkybox(); };
 }
 void Mesh::Render(matrix4 a_mProjection, matrix4 a_mView, matrix4 a_mWorld, vector3 a_v3CameraPosition, int a_RenderOption)
 {
@@ -730,11 +1481,13 @@ void Mesh::Render( matrix4 a_mProjection, matrix4 a_mView, float* a_fMatrixArray
 		wire would not be noticible.
 	*/
 	bool solid = false;
+	//Upload the instances once, solid and wire draw from the same buffer
+	UploadInstances(a_fMatrixArray, a_nInstances);
 	//Draw
 	if (a_RenderOption & BTO_RENDER::RENDER_SOLID)
 	{
 		solid = true;
-		RenderSolid(a_mProjection, a_mView, a_fMatrixArray, a_nInstances, a_v3CameraPosition);
+		RenderSolid(a_mProjection, a_mView, nullptr, a_nInstances, a_v3CameraPosition);
 	}
 	if (a_RenderOption & BTO_RENDER::RENDER_WIRE)
 	{
@@ -743,85 +1496,99 @@ void Mesh::Render( matrix4 a_mProjection, matrix4 a_mView, float* a_fMatrixArray
 			vector3 wireframe;
 			wireframe = m_v3Wireframe;
 			std::swap(wireframe, m_v3Wireframe);
-			RenderWire(a_mProjection, a_mView, a_fMatrixArray, a_nInstances);
+			RenderWire(a_mProjection, a_mView, nullptr, a_nInstances);
 			m_v3Wireframe = wireframe;
 		}
 		else
-			RenderWire(a_mProjection, a_mView, a_fMatrixArray, a_nInstances);
+			RenderWire(a_mProjection, a_mView, nullptr, a_nInstances);
+	}
+}
+void Mesh::UploadInstances(float* a_fMatrixArray, int a_nInstances)
+{
+	if (m_InstanceVBO == 0 || a_fMatrixArray == nullptr || a_nInstances <= 0)
+		return;
+
+	glBindBuffer(GL_ARRAY_BUFFER, m_InstanceVBO);
+	//grow by doubling so a changing instance count does not resize the storage every frame
+	uint uInstances = static_cast<uint>(a_nInstances);
+	if (uInstances > m_uInstanceCapacity)
+	{
+		m_uInstanceCapacity = m_uInstanceCapacity > 0 ? m_uInstanceCapacity : 64;
+		while (m_uInstanceCapacity < uInstances)
+			m_uInstanceCapacity *= 2;
 	}
+	//orphan the old storage, the draws still using it keep it alive and this upload does not stall
+	glBufferData(GL_ARRAY_BUFFER, m_uInstanceCapacity * sizeof(matrix4), nullptr, GL_STREAM_DRAW);
+	glBufferSubData(GL_ARRAY_BUFFER, 0, uInstances * sizeof(matrix4), a_fMatrixArray);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
 }
 void Mesh::RenderWire(matrix4 a_mProjection, matrix4 a_mView, float* a_fMatrixArray, int a_nInstances)
 {
 	GLuint nShader = m_pShaderMngr->GetShaderID("Wireframe");
-	// Use the buffer and shader
-	glUseProgram(nShader);
+	// Use the buffer and shader, the tracker skips them if they are bound already
+	GLState::UseProgram(nShader);
+
+	GLState::BindVertexArray(m_VAO);
 
-	glBindVertexArray(m_VAO);
+	if (a_fMatrixArray != nullptr)
+		UploadInstances(a_fMatrixArray, a_nInstances);
 
-	// Get the GPU variables by their name and hook them to CPU variables
-	GLuint VP = glGetUniformLocation(nShader, "VP");
-	GLuint m4ToWorld = glGetUniformLocation(nShader, "m4ToWorld");
-	GLuint vWireframe = glGetUniformLocation(nShader, "vWireframe");
+	// Get the GPU variables from the locations cached when the program was linked
+	ShaderUniforms const& uniforms = m_pShaderMngr->GetUniforms(nShader);
+	GLint VP = uniforms.m_nVP;
+	GLint vWireframe = uniforms.m_nWireframe;
 
 	//Final Projection of the Camera
 	matrix4 m4VP = a_mProjection * a_mView;
 	glUniformMatrix4fv(VP, 1, GL_FALSE, glm::value_ptr(m4VP));
 	glUniform3f(vWireframe, m_v3Wireframe.x, m_v3Wireframe.y, m_v3Wireframe.z);
 
-	//Number of Instances
-	uint nSections = a_nInstances / 250;
-	uint nRemainders = a_nInstances - (250 * nSections);
-	uint nInstances = a_nInstances;
+	//Every instance goes in a single draw, the matrices come from the instance buffer
 	glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
 	glEnable(GL_POLYGON_OFFSET_LINE);
 	glPolygonOffset(-1.f, -1.f);
-	for (uint n = 0; n < nSections; n++)
-	{
-		glUniformMatrix4fv(m4ToWorld, 250, GL_FALSE, &a_fMatrixArray[n * 250 * 16]);
-		//Draw
-		glDrawArraysInstanced(GL_TRIANGLES, 0, m_uVertexCount, 250);
-		m_uRenderCalls++;
-	}
-
-	glUniformMatrix4fv(m4ToWorld, nRemainders, GL_FALSE, &a_fMatrixArray[nSections * 250 * 16]);
-	glDrawArraysInstanced(GL_TRIANGLES, 0, m_uVertexCount, nRemainders);
+	if (m_uIndexCount > 0)
+		glDrawElementsInstanced(GL_TRIANGLES, m_uIndexCount, m_eIndexType, (GLvoid*)0, a_nInstances);
+	else
+		glDrawArraysInstanced(GL_TRIANGLES, 0, m_uVertexCount, a_nInstances);
 	m_uRenderCalls++;
 
 	glDisable(GL_POLYGON_OFFSET_LINE);
 	glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);//Set rendering mode back to fill
-
-	glBindVertexArray(0);
 }
 void Mesh::RenderSolid(matrix4 a_mProjection, matrix4 a_mView, float* a_fMatrixArray, int a_nInstances, vector3 a_v3CameraPosition)
 {
 	GLuint nShader = GetShaderIndex();
-	// Use the buffer and shader
-	glUseProgram(nShader);
+	// Use the buffer and shader, the tracker skips them if they are bound already
+	GLState::UseProgram(nShader);
+
+	GLState::BindVertexArray(m_VAO);
 
-	glBindVertexArray(m_VAO);
+	if (a_fMatrixArray != nullptr)
+		UploadInstances(a_fMatrixArray, a_nInstances);
 
-	// Get the GPU variables by their name and hook them to CPU variables
-	GLuint VP = glGetUniformLocation(nShader, "VP");
-	GLuint m4ModelToWorld = glGetUniformLocation(nShader, "m4ModelToWorld");
+	// Get the GPU variables from the locations cached when the program was linked
+	ShaderUniforms const& uniforms = m_pShaderMngr->GetUniforms(nShader);
+	GLint VP = uniforms.m_nVP;
+	GLint m4ModelToWorld = uniforms.m_nModelToWorld;
 
-	GLuint TextureID = glGetUniformLocation(nShader, "TextureID");
-	GLuint NormalID = glGetUniformLocation(nShader, "NormalID");
-	GLuint SpecularID = glGetUniformLocation(nShader, "SpecularID");
-	GLuint nTexture = glGetUniformLocation(nShader, "nTexture");
+	GLint TextureID = uniforms.m_nTextureID;
+	GLint NormalID = uniforms.m_nNormalID;
+	GLint SpecularID = uniforms.m_nSpecularID;
+	GLint nTexture = uniforms.m_nTexture;
 
-	GLuint LightPosition_W = glGetUniformLocation(nShader, "LightPosition_W");
-	GLuint LightColor = glGetUniformLocation(nShader, "LightColor");
-	GLuint LightPower = glGetUniformLocation(nShader, "LightPower");
-	GLuint AmbientColor = glGetUniformLocation(nShader, "AmbientColor");
-	GLuint AmbientPower = glGetUniformLocation(nShader, "AmbientPower");
-	GLuint Tint = glGetUniformLocation(nShader, "Tint");
+	GLint LightPosition_W = uniforms.m_nLightPosition;
+	GLint LightColor = uniforms.m_nLightColor;
+	GLint LightPower = uniforms.m_nLightPower;
+	GLint AmbientColor = uniforms.m_nAmbientColor;
+	GLint AmbientPower = uniforms.m_nAmbientPower;
+	GLint Tint = uniforms.m_nTint;
 
-	GLuint CameraPosition_W = glGetUniformLocation(nShader, "CameraPosition_W");
+	GLint CameraPosition_W = uniforms.m_nCameraPosition;
 
-	GLuint gl_nInstances = glGetUniformLocation(nShader, "nElements");
+	GLint gl_nInstances = uniforms.m_nElements;
 
-	GLuint m4ToWorld = glGetUniformLocation(nShader, "m4ToWorld");
-	GLuint m4CameraOnWorld = glGetUniformLocation(nShader, "m4CameraOnWorld");
+	GLint m4CameraOnWorld = uniforms.m_nCameraOnWorld;
 
 	//ToWorld matrix
 	glUniformMatrix4fv(m4ModelToWorld, 1, GL_FALSE, glm::value_ptr(matrix4(1.0f)));
@@ -857,9 +1624,8 @@ void Mesh::RenderSolid(matrix4 a_mProjection, matrix4 a_mView, float* a_fMatrixA
 		//if (m_pMatMngr->m_lMaterial[nMaterialIndex]->GetDiffuseMapName() != "NULL")
 		if (index > 0)
 		{
-			glActiveTexture(GL_TEXTURE0);
 			//glBindTexture(GL_TEXTURE_2D, m_pMatMngr->m_lMaterial[nMaterialIndex]->GetDiffuseMap());
-			glBindTexture(GL_TEXTURE_2D, index);
+			GLState::BindTexture2D(GL_TEXTURE0, index);
 			glUniform1i(TextureID, 0);
 			nTextures += 1;
 		}
@@ -869,9 +1635,8 @@ void Mesh::RenderSolid(matrix4 a_mProjection, matrix4 a_mView, float* a_fMatrixA
 		//if (m_pMatMngr->m_lMaterial[nMaterialIndex]->GetNormalMapName() != "NULL")
 		if (index > 0)
 		{
-			glActiveTexture(GL_TEXTURE1);
 			//glBindTexture(GL_TEXTURE_2D, m_pMatMngr->m_lMaterial[nMaterialIndex]->GetNormalMap());
-			glBindTexture(GL_TEXTURE_2D, index);
+			GLState::BindTexture2D(GL_TEXTURE1, index);
 			glUniform1i(NormalID, 1);
 			nTextures += 2;
 		}
@@ -880,38 +1645,23 @@ void Mesh::RenderSolid(matrix4 a_mProjection, matrix4 a_mView, float* a_fMatrixA
 		index = m_pMatMngr->GetSpecularMap(nMaterialIndex);
 		//if (m_pMatMngr->m_lMaterial[nMaterialIndex]->GetSpecularMapName() != "NULL")
 		{
-			glActiveTexture(GL_TEXTURE2);
 			//glBindTexture(GL_TEXTURE_2D, m_pMatMngr->m_lMaterial[nMaterialIndex]->GetSpecularMap());
-			glBindTexture(GL_TEXTURE_2D, index);
+			GLState::BindTexture2D(GL_TEXTURE2, index);
 			glUniform1i(SpecularID, 2);
 			nTextures += 4;
 		}
 	}
 	glUniform1i(nTexture, nTextures);
 
-	//Number of Instances
-	uint nSections = a_nInstances / 250;
-	uint nRemainders = a_nInstances - (250 * nSections);
-	uint nInstances = a_nInstances;
+	//Every instance goes in a single draw, the matrices come from the instance buffer
 	glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
-	for (uint n = 0; n < nSections; n++)
-	{
-		glUniform1i(gl_nInstances, 250);
-		glUniformMatrix4fv(m4ToWorld, 250, GL_FALSE, &a_fMatrixArray[n * 250 * 16]);
-		glUseProgram(nShader);
-		
-		glDrawArraysInstanced(GL_TRIANGLES, 0, m_uVertexCount, 250);
-		m_uRenderCalls++;
-	}
-
-	glUniform1i(gl_nInstances, nRemainders);
-	glUniformMatrix4fv(m4ToWorld, nRemainders, GL_FALSE, &a_fMatrixArray[nSections * 250 * 16]);
-	glDrawArraysInstanced(GL_TRIANGLES, 0, m_uVertexCount, nRemainders);
+	glUniform1i(gl_nInstances, a_nInstances);
+	if (m_uIndexCount > 0)
+		glDrawElementsInstanced(GL_TRIANGLES, m_uIndexCount, m_eIndexType, (GLvoid*)0, a_nInstances);
+	else
+		glDrawArraysInstanced(GL_TRIANGLES, 0, m_uVertexCount, a_nInstances);
 	m_uRenderCalls++;
-	//For the remainder
 	glDisable(GL_TEXTURE2);
 	glDisable(GL_TEXTURE1);
 	glDisable(GL_TEXTURE0);
-
-	glBindVertexArray(0);
 }
\ No newline at end of file
@@ -0,0 +1,139 @@
+#include "BasicX\Mesh\MeshCache.h"
+#include <cstring>
+using namespace BasicX;
+//  MeshCache
+MeshCache::MeshCache(void) {}
+MeshCache::~MeshCache(void) { Close(); }
+bool MeshCache::Open(String a_sFileName)
+{
+	Close();
+
+	m_hFile = CreateFileA(a_sFileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (m_hFile == INVALID_HANDLE_VALUE)
+		return false;
+
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(m_hFile, &size) || size.QuadPart < static_cast<LONGLONG>(sizeof(MeshCacheHeader)))
+	{
+		Close();
+		return false;
+	}
+	m_uSize = static_cast<size_t>(size.QuadPart);
+
+	m_hMapping = CreateFileMappingA(m_hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (m_hMapping == nullptr)
+	{
+		Close();
+		return false;
+	}
+	m_pData = static_cast<unsigned char const*>(MapViewOfFile(m_hMapping, FILE_MAP_READ, 0, 0, 0));
+	if (m_pData == nullptr)
+	{
+		Close();
+		return false;
+	}
+
+	//anything that does not add up means the file is not ours or is cut short
+	MeshCacheHeader const* pHeader = GetHeader();
+	bool bValid = memcmp(pHeader->m_sMagic, "BXMC", 4) == 0 && pHeader->m_uVersion == m_uVersion &&
+		pHeader->m_uVertexBytes == pHeader->m_uVertexCount * pHeader->m_uStride &&
+		static_cast<size_t>(pHeader->m_uVertexOffset) + pHeader->m_uVertexBytes <= m_uSize &&
+		static_cast<size_t>(pHeader->m_uIndexOffset) + pHeader->m_uIndexBytes <= m_uSize &&
+		pHeader->m_sName[255] == '\0' && pHeader->m_sMaterial[255] == '\0' && pHeader->m_sDiffuse[255] == '\0' &&
+		pHeader->m_sNormal[255] == '\0' && pHeader->m_sSpecular[255] == '\0';
+	if (!bValid)
+	{
+		Close();
+		return false;
+	}
+	return true;
+}
+void MeshCache::Close(void)
+{
+	if (m_pData != nullptr)
+		UnmapViewOfFile(m_pData);
+	if (m_hMapping != nullptr)
+		CloseHandle(m_hMapping);
+	if (m_hFile != INVALID_HANDLE_VALUE)
+		CloseHandle(m_hFile);
+
+	m_pData = nullptr;
+	m_hMapping = nullptr;
+	m_hFile = INVALID_HANDLE_VALUE;
+	m_uSize = 0;
+}
+MeshCacheHeader const* MeshCache::GetHeader(void) const
+{
+	return reinterpret_cast<MeshCacheHeader const*>(m_pData);
+}
+void const* MeshCache::GetVertexData(void) const
+{
+	if (m_pData == nullptr)
+		return nullptr;
+	return m_pData + GetHeader()->m_uVertexOffset;
+}
+void const* MeshCache::GetIndexData(void) const
+{
+	if (m_pData == nullptr || GetHeader()->m_uIndexBytes == 0)
+		return nullptr;
+	return m_pData + GetHeader()->m_uIndexOffset;
+}
+bool MeshCache::Write(String a_sFileName, MeshCacheHeader a_Header, void const* a_pVertex, void const* a_pIndex)
+{
+	//buffers start 16 byte aligned inside the file so the mapped pointers are too
+	memcpy(a_Header.m_sMagic, "BXMC", 4);
+	a_Header.m_uVersion = m_uVersion;
+	a_Header.m_uVertexOffset = (sizeof(MeshCacheHeader) + 15) & ~15u;
+	a_Header.m_uIndexOffset = (a_Header.m_uVertexOffset + a_Header.m_uVertexBytes + 15) & ~15u;
+
+	//write to the side and move it in place, a reader never sees half a file
+	String sTemp = a_sFileName + ".tmp";
+	std::ofstream file(sTemp.c_str(), std::ios::binary | std::ios::trunc);
+	if (!file.is_open())
+		return false;
+
+	char padding[16] = {};
+	file.write(reinterpret_cast<char const*>(&a_Header), sizeof(MeshCacheHeader));
+	file.write(padding, a_Header.m_uVertexOffset - sizeof(MeshCacheHeader));
+	file.write(static_cast<char const*>(a_pVertex), a_Header.m_uVertexBytes);
+	file.write(padding, a_Header.m_uIndexOffset - a_Header.m_uVertexOffset - a_Header.m_uVertexBytes);
+	if (a_Header.m_uIndexBytes > 0)
+		file.write(static_cast<char const*>(a_pIndex), a_Header.m_uIndexBytes);
+	file.close();
+	if (file.fail())
+	{
+		DeleteFileA(sTemp.c_str());
+		return false;
+	}
+
+	if (!MoveFileExA(sTemp.c_str(), a_sFileName.c_str(), MOVEFILE_REPLACE_EXISTING))
+	{
+		DeleteFileA(sTemp.c_str());
+		return false;
+	}
+	return true;
+}
+String MeshCache::GetCachePath(String a_sSource)
+{
+	return a_sSource + ".bxc";
+}
+bool MeshCache::IsFresh(String a_sSource, String a_sCache)
+{
+	WIN32_FILE_ATTRIBUTE_DATA cache;
+	if (!GetFileAttributesExA(a_sCache.c_str(), GetFileExInfoStandard, &cache))
+		return false;
+
+	WIN32_FILE_ATTRIBUTE_DATA source;
+	if (!GetFileAttributesExA(a_sSource.c_str(), GetFileExInfoStandard, &source))
+		return true;
+
+	return CompareFileTime(&cache.ftLastWriteTime, &source.ftLastWriteTime) >= 0;
+}
+bool MeshCache::SetField(char* a_sField, String a_sValue)
+{
+	memset(a_sField, 0, 256);
+	if (a_sValue.size() > 255)
+		return false;
+	memcpy(a_sField, a_sValue.c_str(), a_sValue.size());
+	return true;
+}
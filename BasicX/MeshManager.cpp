@@ -36,16 +36,7 @@ void MeshManager::Release(void)
 			pMesh = nullptr;
 		}
 	}
-	for (uint i = 0; i < uMeshCount; ++i)
-	{
-		std::vector<MeshOptions>* meshOptions = m_renderOptionsList[i];
-		if (meshOptions)
-		{
-			delete meshOptions;
-			meshOptions = nullptr;
-		}
-	}
-	m_renderOptionsList.clear();
+	m_renderQueueList.clear();
 	m_meshNames.clear();
 }
 MeshManager* MeshManager::GetInstance()
@@ -80,14 +71,12 @@ void MeshManager::PrintLine(String a_sInput, vector3 a_v3Color)
 }
 void MeshManager::Printf(vector3 a_v3Color, const char * _Format, ...)
 {
-	char* zs = nullptr;
-	zs = new char[1000];
+	char zs[1000];
 	va_list args;
 	va_start(args, _Format);
 	vsprintf_s(zs, 1000, _Format, args);
 	va_end(args);
 	m_pText->AddString(String(zs), a_v3Color);
-	SafeDelete(zs);
 }
 void MeshManager::SetFont(String a_sTextureName)
 {
@@ -150,6 +139,20 @@ int MeshManager::GenerateSphere(float a_fDiameter, int a_nSubdivisions, vector3
 	pMesh->SetShaderProgram("BasicColor");
 	return AddMesh(pMesh);
 }
+int MeshManager::LoadMesh(String a_sSource, MeshSource a_fnBuild)
+{
+	Mesh* pMesh = new Mesh();
+	if (!pMesh->LoadCached(a_sSource, a_fnBuild))
+	{
+		SafeDelete(pMesh);
+		return -1;
+	}
+	return AddMesh(pMesh);
+}
+int MeshManager::LoadOBJ(String a_sFileName)
+{
+	return LoadMesh(a_sFileName, [a_sFileName](Mesh* a_pMesh) { a_pMesh->LoadOBJ(a_sFileName); });
+}
 int MeshManager::GenerateSkybox(void)
 {
 	Mesh* pMesh = new Mesh();
@@ -414,8 +417,7 @@ int MeshManager::AddMesh(Mesh* a_pMesh)
 	}
 	a_pMesh->SetName(sName);
 	m_meshList.push_back(a_pMesh);
-	std::vector<MeshOptions>* meshOptions = new std::vector<MeshOptions>();
-	m_renderOptionsList.push_back(meshOptions);
+	m_renderQueueList.push_back(MeshRenderQueue());
 	m_meshNames[a_pMesh->GetName()] = m_meshList.size() - 1;
 	return m_meshList.size() - 1;
 }
@@ -431,6 +433,25 @@ Mesh *MeshManager::GetMesh(uint nMesh)
 	return m_meshList[nMesh];
 }
 uint MeshManager::GetMeshCount(void) { return m_meshList.size(); }
+void MeshManager::SetResidency(BTO_RESIDENCY a_eResidency)
+{
+	for (uint i = 0; i < m_meshList.size(); ++i)
+		m_meshList[i]->SetResidency(a_eResidency);
+}
+size_t MeshManager::GetResidentMemory(void)
+{
+	size_t uBytes = 0;
+	for (uint i = 0; i < m_meshList.size(); ++i)
+		uBytes += m_meshList[i]->GetResidentMemory();
+	return uBytes;
+}
+size_t MeshManager::GetGPUMemory(void)
+{
+	size_t uBytes = 0;
+	for (uint i = 0; i < m_meshList.size(); ++i)
+		uBytes += m_meshList[i]->GetGPUMemory();
+	return uBytes;
+}
 
 void MeshManager::SetRenderTarget(GLuint a_uFrameBuffer, GLuint a_uDepthBuffer, GLuint a_uTextureToRender, int a_nWidth, int a_nHeight)
 {
@@ -438,8 +459,7 @@ void MeshManager::SetRenderTarget(GLuint a_uFrameBuffer, GLuint a_uDepthBuffer,
 	glBindFramebuffer(GL_FRAMEBUFFER, a_uFrameBuffer);
 
 	//Texture to render to
-	glActiveTexture(GL_TEXTURE0);
-	glBindTexture(GL_TEXTURE_2D, a_uTextureToRender);
+	GLState::BindTexture2D(GL_TEXTURE0, a_uTextureToRender);
 
 	glBindRenderbuffer(GL_RENDERBUFFER, a_uDepthBuffer);
 
@@ -470,9 +490,12 @@ int MeshManager::GetMeshIndex(String a_sName)
 }
 void MeshManager::ClearRenderList(void)
 {
-	for (auto it = m_renderOptionsList.begin(); it != m_renderOptionsList.end(); ++it)
+	//clear keeps the capacity, next frame fills the same memory
+	for (auto it = m_renderQueueList.begin(); it != m_renderQueueList.end(); ++it)
 	{
-		(*it)->clear();
+		it->m_lSolid.clear();
+		it->m_lWire.clear();
+		it->m_lBoth.clear();
 	}
 	Mesh::ResetRenderCallCount();
 }
@@ -488,13 +511,22 @@ void MeshManager::AddMeshToRenderList(uint a_nIndex, matrix4 a_m4Transform, int
 	if (a_nIndex >= m_meshList.size())
 		return;
 
-	//we create a new options object and store the information provided
-	MeshOptions options(a_m4Transform, a_Render);
-
-	//Get the list of options for this mesh
-	//std::vector<MeshOptions>* optionsList = m_MeshOptionsList[a_nIndex];
-	//optionsList->push_back(options);
-	(m_renderOptionsList[a_nIndex])->push_back(options);
+	//we store the transform straight in the list of its render mode so Render can hand it over as is
+	MeshRenderQueue& queue = m_renderQueueList[a_nIndex];
+	switch (a_Render)
+	{
+	case RENDER_NONE:
+		break;
+	case RENDER_SOLID:
+		queue.m_lSolid.push_back(a_m4Transform);
+		break;
+	case RENDER_WIRE:
+		queue.m_lWire.push_back(a_m4Transform);
+		break;
+	default:
+		queue.m_lBoth.push_back(a_m4Transform);
+		break;
+	}
 	/*
 	//look the map to see if we have options for the specified mesh
 	auto var = m_mRender.find(a_sMeshName);
@@ -554,104 +586,29 @@ void MeshManager::AddMeshToRenderList(Mesh* a_pMesh, matrix4 a_m4Transform, int
 }
 uint MeshManager::Render(void)
 {
-	//for each element in map check the rendering type
+	//the application may have bound its own state since the last frame
+	GLState::Invalidate();
+
+	//for each mesh render the instances of each render mode, the lists are contiguous
+	//matrices so they go to the mesh without being copied
 	uint nMeshCount = m_meshList.size();
-	std::vector<matrix4> solidList;
-	std::vector<matrix4> wireList;
-	std::vector<matrix4> bothList;
-	std::vector<MeshOptions>* optionList;
 	for (uint nMesh = 0; nMesh < nMeshCount; ++nMesh)
 	{
-		optionList = m_renderOptionsList[nMesh];
-		if (optionList->size() > 0)
-		{
-			//The idea is to know what each mesh will be rendered as and store the matrix in a list
-			//that way we will have 3 separate calls each for a render mode
-			for (uint nOpt = 0; nOpt < optionList->size(); ++nOpt)
-			{
-				switch ((*optionList)[nOpt].m_nRender)
-				{
-				case RENDER_NONE:
-					break;
-				case RENDER_SOLID:
-					solidList.push_back((*optionList)[nOpt].m_m4Transform);
-					break;
-				case RENDER_WIRE:
-					wireList.push_back((*optionList)[nOpt].m_m4Transform);
-					break;
-				default:
-					bothList.push_back((*optionList)[nOpt].m_m4Transform);
-					break;
-				}
-			}
-			//For Solids ---------------------------------------------------------------------------
-			int nSolids = solidList.size();//count elements
-			if (nSolids > 0)
-			{
-				float* fSolidArray = new float[16 * nSolids];//reserve memory
-															 //memcpy the translated values to the array (way faster than copy element by element)
-				for (int nSolid = 0; nSolid < nSolids; ++nSolid)
-				{
-					const float* m4MVP = glm::value_ptr(solidList[nSolid]);
-					memcpy(&fSolidArray[nSolid * 16], m4MVP, 16 * sizeof(float));
-				}
-				//render
-				m_meshList[nMesh]->Render(m_pCameraMngr->GetProjectionMatrix(), m_pCameraMngr->GetViewMatrix(),
-					fSolidArray, solidList.size(), m_pCameraMngr->GetPosition(), RENDER_SOLID);
-				//deallocate memory
-				if (fSolidArray)
-				{
-					delete[] fSolidArray;
-					fSolidArray = nullptr;
-				}
-				solidList.clear();
-			}
-			//For Wires ---------------------------------------------------------------------------
-			int nWires = wireList.size();//count elements
-			if (nWires > 0)
-			{
-				float* fWireArray = new float[16 * nWires];//reserve memory
-														   //memcpy the translated values to the array (way faster than copy element by element)
-				for (int nWire = 0; nWire < nWires; ++nWire)
-				{
-					const float* m4MVP = glm::value_ptr(wireList[nWire]);
-					memcpy(&fWireArray[nWire * 16], m4MVP, 16 * sizeof(float));
-				}
-				//render
-				m_meshList[nMesh]->Render(m_pCameraMngr->GetProjectionMatrix(), m_pCameraMngr->GetViewMatrix(),
-					fWireArray, wireList.size(), m_pCameraMngr->GetPosition(), RENDER_WIRE);
-				//deallocate memory
-				if (fWireArray)
-				{
-					delete[] fWireArray;
-					fWireArray = nullptr;
-				}
-				wireList.clear();
-			}
-			//For Both ---------------------------------------------------------------------------
-			int nBoths = bothList.size();//count elements
-			if (nBoths > 0)
-			{
-				float* fBothArray = new float[16 * nBoths];//reserve memory
-														   //memcpy the translated values to the array (way faster than copy element by element)
-				for (int nBoth = 0; nBoth < nBoths; ++nBoth)
-				{
-					const float* m4MVP = glm::value_ptr(bothList[nBoth]);
-					memcpy(&fBothArray[nBoth * 16], m4MVP, 16 * sizeof(float));
-				}
-				//render
-				m_meshList[nMesh]->Render(m_pCameraMngr->GetProjectionMatrix(), m_pCameraMngr->GetViewMatrix(),
-					fBothArray, bothList.size(), m_pCameraMngr->GetPosition(), RENDER_SOLID | RENDER_WIRE);
-				//deallocate memory
-				if (fBothArray)
-				{
-					delete[] fBothArray;
-					fBothArray = nullptr;
-				}
-				bothList.clear();
-			}
-		}
+		MeshRenderQueue& queue = m_renderQueueList[nMesh];
+		RenderQueue(nMesh, queue.m_lSolid, RENDER_SOLID);
+		RenderQueue(nMesh, queue.m_lWire, RENDER_WIRE);
+		RenderQueue(nMesh, queue.m_lBoth, RENDER_SOLID | RENDER_WIRE);
 	}
 	m_pText->Render();
+	//leave no vertex array bound so nothing outside changes ours by mistake
+	GLState::BindVertexArray(0);
 	return Mesh::GetRenderCallCount();
-}
\ No newline at end of file
+}
+void MeshManager::RenderQueue(uint a_nMesh, std::vector<matrix4>& a_lInstance, int a_nRender)
+{
+	if (a_lInstance.empty())
+		return;
+
+	m_meshList[a_nMesh]->Render(m_pCameraMngr->GetProjectionMatrix(), m_pCameraMngr->GetViewMatrix(),
+		glm::value_ptr(a_lInstance[0]), a_lInstance.size(), m_pCameraMngr->GetPosition(), a_nRender);
+}
@@ -11,6 +11,8 @@ void Shader::Init(void)
 	m_sVertexShaderName = "";
 	m_sFragmentShaderName = "";
 	m_nProgram = -1;
+	m_Uniforms = ShaderUniforms();
+	m_mUniform.clear();
 }
 void Shader::Swap(Shader& other)
 {
@@ -18,6 +20,8 @@ void Shader::Swap(Shader& other)
 	std::swap( m_sVertexShaderName, other.m_sVertexShaderName);
 	std::swap( m_sFragmentShaderName, other.m_sFragmentShaderName);
 	std::swap( m_nProgram, other.m_nProgram);
+	std::swap( m_Uniforms, other.m_Uniforms);
+	std::swap( m_mUniform, other.m_mUniform);
 }
 void Shader::Release(void)
 {
@@ -36,6 +40,8 @@ Shader::Shader(const Shader& other)
 	m_sVertexShaderName = other.m_sVertexShaderName;
 	m_sFragmentShaderName = other.m_sFragmentShaderName;
 	m_nProgram = other.m_nProgram;
+	m_Uniforms = other.m_Uniforms;
+	m_mUniform = other.m_mUniform;
 }
 Shader& Shader::operator=(const Shader& other)
 {
@@ -63,6 +69,29 @@ GLuint Shader::CompileShader(String a_sVertexShader, String a_sFragmentShader, S
 	m_sFragmentShaderName = a_sFragmentShader;
 	m_nProgram = LoadShaders( m_sVertexShaderName.c_str(), m_sFragmentShaderName.c_str() );
 
+	//Cache the locations now that the program is linked
+	m_Uniforms = ShaderUniforms();
+	m_mUniform.clear();
+	if (m_nProgram == 0)
+		return m_nProgram;
+	m_Uniforms.Reflect(m_nProgram);
+
+	GLint nUniforms = 0;
+	glGetProgramiv(m_nProgram, GL_ACTIVE_UNIFORMS, &nUniforms);
+	char szName[256];
+	for (GLint nUniform = 0; nUniform < nUniforms; ++nUniform)
+	{
+		GLint nSize = 0;
+		GLenum eType = 0;
+		glGetActiveUniform(m_nProgram, nUniform, sizeof(szName), nullptr, &nSize, &eType, szName);
+		String sName = szName;
+		//arrays are reported as name[0]
+		size_t uBracket = sName.find('[');
+		if (uBracket != String::npos)
+			sName = sName.substr(0, uBracket);
+		m_mUniform[sName] = glGetUniformLocation(m_nProgram, szName);
+	}
+
 	return m_nProgram;
 }
 
@@ -71,3 +100,36 @@ String Shader::GetProgramName() { return m_sProgramName; }
 String Shader::GetVertexShaderName() { return m_sVertexShaderName; }
 String Shader::GetFragmentShaderName() { return m_sFragmentShaderName; }
 int Shader::GetProgramID() { return m_nProgram; }
+ShaderUniforms const& Shader::GetUniforms(void) { return m_Uniforms; }
+GLint Shader::GetUniformLocation(String a_sName)
+{
+	auto var = m_mUniform.find(a_sName);
+	if (var != m_mUniform.end())
+		return var->second;
+	return -1;
+}
+//ShaderUniforms
+void ShaderUniforms::Reflect(GLuint a_nProgram)
+{
+	m_nVP = glGetUniformLocation(a_nProgram, "VP");
+	m_nMVP = glGetUniformLocation(a_nProgram, "MVP");
+	m_nModelToWorld = glGetUniformLocation(a_nProgram, "m4ModelToWorld");
+	m_nCameraOnWorld = glGetUniformLocation(a_nProgram, "m4CameraOnWorld");
+	m_nTextureID = glGetUniformLocation(a_nProgram, "TextureID");
+	m_nNormalID = glGetUniformLocation(a_nProgram, "NormalID");
+	m_nSpecularID = glGetUniformLocation(a_nProgram, "SpecularID");
+	m_nTexture = glGetUniformLocation(a_nProgram, "nTexture");
+	m_nLightPosition = glGetUniformLocation(a_nProgram, "LightPosition_W");
+	m_nLightColor = glGetUniformLocation(a_nProgram, "LightColor");
+	m_nLightPower = glGetUniformLocation(a_nProgram, "LightPower");
+	m_nAmbientColor = glGetUniformLocation(a_nProgram, "AmbientColor");
+	m_nAmbientPower = glGetUniformLocation(a_nProgram, "AmbientPower");
+	m_nTint = glGetUniformLocation(a_nProgram, "Tint");
+	m_nCameraPosition = glGetUniformLocation(a_nProgram, "CameraPosition_W");
+	m_nElements = glGetUniformLocation(a_nProgram, "nElements");
+	m_nWireframe = glGetUniformLocation(a_nProgram, "vWireframe");
+
+	m_nPositionAttrib = glGetAttribLocation(a_nProgram, "Position_b");
+	m_nColorAttrib = glGetAttribLocation(a_nProgram, "Color_b");
+	m_nUVAttrib = glGetAttribLocation(a_nProgram, "UV_b");
+}
@@ -25,6 +25,9 @@ void ShaderManager::Init(void)
 	//Compile Simplex shader
 	CompileShader(pFolder->GetFolderShaders() + "Simplex.vs", pFolder->GetFolderShaders() + "Simplex.fs", "Simplex");
 
+	//Compile Simplex shader for packed vertices
+	CompileShader(pFolder->GetFolderShaders() + "SimplexPacked.vs", pFolder->GetFolderShaders() + "Simplex.fs", "SimplexPacked");
+
 	printf("\n");
 }
 void ShaderManager::Release(void)
@@ -36,6 +39,8 @@ void ShaderManager::Release(void)
 	}
 
 	m_vShader.clear();
+	m_map.clear();
+	m_mProgram.clear();
 }
 ShaderManager* ShaderManager::GetInstance()
 {
@@ -70,6 +75,7 @@ GLuint ShaderManager::CompileShader(String a_sVertexShader, String a_sFragmentSh
 	nShader = vShader.CompileShader(a_sVertexShader, a_sFragmentShader, a_sName);
 	m_vShader.push_back(vShader);
 	m_map[vShader.GetProgramName()] = m_uShaderCount;
+	m_mProgram[vShader.GetProgramID()] = m_uShaderCount;
 	m_uShaderCount++;
 
 	return nShader;
@@ -96,4 +102,12 @@ GLuint ShaderManager::GetShaderID(uint a_uIndex)
 		return 0;
 
 	return m_vShader[a_uIndex].GetProgramID();
-}
\ No newline at end of file
+}
+ShaderUniforms const& ShaderManager::GetUniforms(GLuint a_nProgram)
+{
+	static const ShaderUniforms unknown;
+	auto var = m_mProgram.find(a_nProgram);
+	if (var == m_mProgram.end())
+		return unknown;
+	return m_vShader[var->second].GetUniforms();
+}
@@ -251,16 +251,22 @@ void SystemSingleton::SetUsingConsole(bool a_bUsing) { m_bConsoleWindow = a_bUsi
 float SystemSingleton::GetWindowRatio(void) { return m_nWindowWidth / static_cast<float>(m_nWindowHeight); }
 int SystemSingleton::GetFPS(void) { return m_nFPS; }
 
+long long SystemSingleton::GetTimeNanoseconds(void)
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+}
 void SystemSingleton::Update()
 {
-	static DWORD dLastTime = GetTickCount(); //Last time the time was called
+	static long long nLastTime = GetTimeNanoseconds(); //Last time the time was called
 
 	static uint uFrameCount = 0; //Frames Passed
 
 								 // Get FPS
-	if ((GetTickCount() - dLastTime) >= 1000)	// When a Second has passed...
+	long long nCurrentTime = GetTimeNanoseconds();
+	if ((nCurrentTime - nLastTime) >= 1000000000LL)	// When a Second has passed...
 	{
-		dLastTime = GetTickCount();	// Refresh the value of frames
+		nLastTime = nCurrentTime;	// Refresh the value of frames
 		m_nFPS = uFrameCount;		// save the number of frames that occurred in this second
 		uFrameCount = 0;			// Reset the frames
 	}
@@ -271,20 +277,19 @@ void SystemSingleton::StartClock(uint a_nClock)
 {
 	while (m_clockList.size() < a_nClock + 1)
 	{
-		m_clockList.push_back(GetTickCount());
-		m_deltaList.push_back(GetTickCount());
+		long long nCurrentTime = GetTimeNanoseconds();
+		m_clockList.push_back(nCurrentTime);
+		m_deltaList.push_back(nCurrentTime);
 		m_countdownList.push_back(0.0f);
-		m_deltaList[m_clockList.size() - 1] =
-			m_clockList[m_clockList.size() - 1] = GetTickCount();
 	}
 }
 float SystemSingleton::GetDeltaTime(uint a_nClock)
 {
 	StartClock(a_nClock);
 
-	DWORD dCurrentTime = GetTickCount();
-	float dTime = (dCurrentTime - m_deltaList[a_nClock]) / 1000.0f;
-	m_deltaList[a_nClock] = dCurrentTime;
+	long long nCurrentTime = GetTimeNanoseconds();
+	float dTime = static_cast<float>((nCurrentTime - m_deltaList[a_nClock]) / 1e9);
+	m_deltaList[a_nClock] = nCurrentTime;
 
 	return dTime;
 }
@@ -292,7 +297,8 @@ float SystemSingleton::GetTimeSinceStart(uint a_nClock)
 {
 	StartClock(a_nClock);
 
-	return (GetTickCount() - m_clockList[a_nClock]) / 1000.0f;
+	//the difference is taken in double, a float of nanoseconds would lose the small deltas
+	return static_cast<float>((GetTimeNanoseconds() - m_clockList[a_nClock]) / 1e9);
 }
 uint SystemSingleton::GenClock(void)
 {
@@ -304,7 +310,7 @@ void SystemSingleton::ResetClock(uint a_nClock)
 {
 	if (a_nClock >= m_clockList.size())
 		return;
-	m_deltaList[a_nClock] = m_clockList[a_nClock] = GetTickCount();
+	m_deltaList[a_nClock] = m_clockList[a_nClock] = GetTimeNanoseconds();
 }
 void SystemSingleton::StartTimerOnClock(float a_fTime, uint a_nClock)
 {
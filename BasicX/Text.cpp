@@ -85,7 +85,7 @@ void Text::CompileOpenGL3X(void)
 
 	// Create a vertex array object
 	glGenVertexArrays(1, &m_vao);
-	glBindVertexArray(m_vao);
+	GLState::BindVertexArray(m_vao);
 
 	// Create and initialize a buffer object for each shape.
 	glGenBuffers(1, &m_VBO);
@@ -128,16 +128,17 @@ void Text::Render(void)
 
 	GLuint nShader = m_nShader;
 	// Use the buffer and shader
-	glUseProgram(nShader);
-	glBindVertexArray(m_vao);
-	// Get the GPU variables by their name and hook them to CPU variables
+	GLState::UseProgram(nShader);
+	GLState::BindVertexArray(m_vao);
+	// Get the GPU variables from the locations cached when the program was linked
+	ShaderUniforms const& uniforms = m_pShaderMngr->GetUniforms(nShader);
 
-	GLuint Position_b = glGetAttribLocation(nShader, "Position_b");
-	GLuint UV_b = glGetAttribLocation(nShader, "UV_b");
-	GLuint Color_b = glGetAttribLocation(nShader, "Color_b");
+	GLuint Position_b = uniforms.m_nPositionAttrib;
+	GLuint UV_b = uniforms.m_nUVAttrib;
+	GLuint Color_b = uniforms.m_nColorAttrib;
 
-	GLuint MVP = glGetUniformLocation(nShader, "MVP");
-	GLuint TextureID = glGetUniformLocation(nShader, "TextureID");
+	GLint MVP = uniforms.m_nMVP;
+	GLint TextureID = uniforms.m_nTextureID;
 	
 	float fRatio = static_cast<float>(m_pSystem->GetWindowWidth()) / static_cast<float>(m_pSystem->GetWindowHeight());
 	
@@ -152,8 +153,7 @@ void Text::Render(void)
 	int nMaterialIndex = m_uMaterialIndex;
 	if (m_pMatMngr->m_materialList[nMaterialIndex]->GetDiffuseMapName() != "NULL")
 	{
-		glActiveTexture(GL_TEXTURE0);
-		glBindTexture(GL_TEXTURE_2D, m_pMatMngr->m_materialList[nMaterialIndex]->GetDiffuseMap());
+		GLState::BindTexture2D(GL_TEXTURE0, m_pMatMngr->m_materialList[nMaterialIndex]->GetDiffuseMap());
 		glUniform1i(TextureID, 0);
 	}
 
@@ -183,8 +183,6 @@ void Text::Render(void)
 	m_sText = "";
 	m_lColorPrev = m_lColor;
 	m_lColor.clear();
-
-	glBindVertexArray(0);
 }
 void Text::Reset(void)
 {
@@ -0,0 +1,273 @@
+#include "BasicX\System\TextScanner.h"
+#include <cstring>
+using namespace BasicX;
+//  StringView
+bool StringView::Empty(void) const { return m_uLength == 0; }
+bool StringView::operator==(const char* a_sInput) const
+{
+	return strlen(a_sInput) == m_uLength && memcmp(m_pData, a_sInput, m_uLength) == 0;
+}
+String StringView::ToString(void) const
+{
+	if (m_uLength == 0)
+		return String();
+	return String(m_pData, m_uLength);
+}
+//  TextScanner
+TextScanner::TextScanner(void) {}
+TextScanner::~TextScanner(void) { Close(); }
+bool TextScanner::Open(String a_sFileName)
+{
+	Close();
+
+	m_hFile = CreateFileA(a_sFileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+		FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (m_hFile == INVALID_HANDLE_VALUE)
+		return false;
+
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(m_hFile, &size))
+	{
+		Close();
+		return false;
+	}
+	m_uSize = static_cast<size_t>(size.QuadPart);
+	m_bOpen = true;
+
+	//an empty file cannot be mapped, there is nothing to read anyway
+	if (m_uSize == 0)
+		return true;
+
+	m_hMapping = CreateFileMappingA(m_hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (m_hMapping != nullptr)
+		m_pView = static_cast<const char*>(MapViewOfFile(m_hMapping, FILE_MAP_READ, 0, 0, 0));
+	if (m_pView != nullptr)
+	{
+		m_pData = m_pView;
+		return true;
+	}
+
+	//could not be mapped, read it whole in a single block instead
+	m_lBuffer.resize(m_uSize);
+	size_t uRead = 0;
+	while (uRead < m_uSize)
+	{
+		DWORD uChunk = static_cast<DWORD>((m_uSize - uRead) < 0x40000000 ? (m_uSize - uRead) : 0x40000000);
+		DWORD uDone = 0;
+		if (!ReadFile(m_hFile, &m_lBuffer[uRead], uChunk, &uDone, nullptr) || uDone == 0)
+		{
+			Close();
+			return false;
+		}
+		uRead += uDone;
+	}
+	m_pData = &m_lBuffer[0];
+	return true;
+}
+void TextScanner::Close(void)
+{
+	if (m_pView != nullptr)
+		UnmapViewOfFile(m_pView);
+	if (m_hMapping != nullptr)
+		CloseHandle(m_hMapping);
+	if (m_hFile != INVALID_HANDLE_VALUE)
+		CloseHandle(m_hFile);
+
+	std::vector<char>().swap(m_lBuffer);
+	m_pView = nullptr;
+	m_hMapping = nullptr;
+	m_hFile = INVALID_HANDLE_VALUE;
+	m_pData = nullptr;
+	m_uSize = 0;
+	m_uPosition = 0;
+	m_bOpen = false;
+}
+bool TextScanner::IsOpen(void) const { return m_bOpen; }
+void TextScanner::Rewind(void) { m_uPosition = 0; }
+bool TextScanner::NextLine(StringView& a_Line)
+{
+	if (m_uPosition >= m_uSize)
+		return false;
+
+	const char* pStart = m_pData + m_uPosition;
+	size_t uLeft = m_uSize - m_uPosition;
+	const char* pEnd = static_cast<const char*>(memchr(pStart, '\n', uLeft));
+	if (pEnd == nullptr)
+	{
+		pEnd = pStart + uLeft;
+		m_uPosition = m_uSize;
+	}
+	else
+		m_uPosition = (pEnd - m_pData) + 1;
+
+	//the line goes without the \r of windows files and without the indentation
+	if (pEnd > pStart && pEnd[-1] == '\r')
+		pEnd--;
+	while (pStart < pEnd && (*pStart == ' ' || *pStart == '\t'))
+		pStart++;
+
+	a_Line.m_pData = pStart;
+	a_Line.m_uLength = static_cast<uint>(pEnd - pStart);
+	return true;
+}
+bool TextScanner::NextToken(StringView& a_Input, StringView& a_Token)
+{
+	const char* pChar = a_Input.m_pData;
+	const char* pEnd = pChar + a_Input.m_uLength;
+	while (pChar < pEnd && (*pChar == ' ' || *pChar == '\t' || *pChar == '\r'))
+		pChar++;
+
+	const char* pStart = pChar;
+	while (pChar < pEnd && *pChar != ' ' && *pChar != '\t' && *pChar != '\r')
+		pChar++;
+
+	a_Token.m_pData = pStart;
+	a_Token.m_uLength = static_cast<uint>(pChar - pStart);
+	a_Input.m_pData = pChar;
+	a_Input.m_uLength = static_cast<uint>(pEnd - pChar);
+	return a_Token.m_uLength > 0;
+}
+StringView TextScanner::Split(StringView& a_Input, char a_cSeparator)
+{
+	StringView part;
+	part.m_pData = a_Input.m_pData;
+	const char* pSeparator = a_Input.m_uLength > 0 ?
+		static_cast<const char*>(memchr(a_Input.m_pData, a_cSeparator, a_Input.m_uLength)) : nullptr;
+	if (pSeparator == nullptr)
+	{
+		part.m_uLength = a_Input.m_uLength;
+		a_Input.m_pData += a_Input.m_uLength;
+		a_Input.m_uLength = 0;
+		return part;
+	}
+	part.m_uLength = static_cast<uint>(pSeparator - a_Input.m_pData);
+	a_Input.m_uLength -= part.m_uLength + 1;
+	a_Input.m_pData = pSeparator + 1;
+	return part;
+}
+bool TextScanner::ParseFloat(StringView a_Token, float& a_fOutput)
+{
+	const char* pChar = a_Token.m_pData;
+	const char* pEnd = pChar + a_Token.m_uLength;
+
+	bool bNegative = false;
+	if (pChar < pEnd && (*pChar == '-' || *pChar == '+'))
+	{
+		bNegative = *pChar == '-';
+		pChar++;
+	}
+
+	//up to 19 significant digits fit in the mantissa, the rest only move the exponent
+	unsigned long long uMantissa = 0;
+	int nExponent = 0;
+	uint uSignificant = 0;
+	bool bDigits = false;
+	for (; pChar < pEnd && *pChar >= '0' && *pChar <= '9'; pChar++)
+	{
+		bDigits = true;
+		if (uSignificant < 19)
+		{
+			uMantissa = uMantissa * 10 + (*pChar - '0');
+			if (uMantissa != 0)
+				uSignificant++;
+		}
+		else
+			nExponent++;
+	}
+	if (pChar < pEnd && *pChar == '.')
+	{
+		for (pChar++; pChar < pEnd && *pChar >= '0' && *pChar <= '9'; pChar++)
+		{
+			bDigits = true;
+			if (uSignificant < 19)
+			{
+				uMantissa = uMantissa * 10 + (*pChar - '0');
+				if (uMantissa != 0)
+					uSignificant++;
+				nExponent--;
+			}
+		}
+	}
+	if (bDigits && pChar < pEnd && (*pChar == 'e' || *pChar == 'E'))
+	{
+		pChar++;
+		bool bNegativeExponent = false;
+		if (pChar < pEnd && (*pChar == '-' || *pChar == '+'))
+		{
+			bNegativeExponent = *pChar == '-';
+			pChar++;
+		}
+		if (pChar == pEnd)
+			return false;
+		int nWritten = 0;
+		for (; pChar < pEnd && *pChar >= '0' && *pChar <= '9'; pChar++)
+		{
+			if (nWritten < 10000)
+				nWritten = nWritten * 10 + (*pChar - '0');
+		}
+		nExponent += bNegativeExponent ? -nWritten : nWritten;
+	}
+
+	//anything else, nan, inf or hex floats, goes through the C library
+	if (!bDigits || pChar != pEnd)
+	{
+		char sCopy[64];
+		if (a_Token.m_uLength == 0 || a_Token.m_uLength >= sizeof(sCopy))
+			return false;
+		memcpy(sCopy, a_Token.m_pData, a_Token.m_uLength);
+		sCopy[a_Token.m_uLength] = '\0';
+		char* pStop = nullptr;
+		a_fOutput = strtof(sCopy, &pStop);
+		return pStop == sCopy + a_Token.m_uLength;
+	}
+
+	//powers up to 10^22 are exact in a double, the result is within an ulp of the float
+	static const double dPower[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+		1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+	double dValue = static_cast<double>(uMantissa);
+	if (uMantissa != 0)
+	{
+		for (; nExponent > 22 && dValue < 1e300; nExponent -= 22)
+			dValue *= 1e22;
+		for (; nExponent < -22 && dValue > 1e-300; nExponent += 22)
+			dValue /= 1e22;
+		if (nExponent > 22 || nExponent < -22)
+			dValue = nExponent > 0 ? HUGE_VAL : 0.0;
+		else if (nExponent >= 0)
+			dValue *= dPower[nExponent];
+		else
+			dValue /= dPower[-nExponent];
+	}
+	a_fOutput = static_cast<float>(bNegative ? -dValue : dValue);
+	return true;
+}
+bool TextScanner::ParseInt(StringView a_Token, int& a_nOutput)
+{
+	const char* pChar = a_Token.m_pData;
+	const char* pEnd = pChar + a_Token.m_uLength;
+
+	bool bNegative = false;
+	if (pChar < pEnd && (*pChar == '-' || *pChar == '+'))
+	{
+		bNegative = *pChar == '-';
+		pChar++;
+	}
+	if (pChar == pEnd)
+		return false;
+
+	long long nValue = 0;
+	for (; pChar < pEnd; pChar++)
+	{
+		if (*pChar < '0' || *pChar > '9')
+			return false;
+		nValue = nValue * 10 + (*pChar - '0');
+		if (nValue > 0x80000000LL)
+			return false;
+	}
+	if (bNegative)
+		nValue = -nValue;
+	if (nValue > 0x7fffffffLL)
+		return false;
+	a_nOutput = static_cast<int>(nValue);
+	return true;
+}
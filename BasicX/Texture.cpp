@@ -1,4 +1,6 @@
 #include "BasicX\materials\Texture.h"
+#include "BasicX\System\GLState.h"
+#include <cstring>
 using namespace BasicX;
 
 Texture::Texture(void) { Init(); }
@@ -8,7 +10,25 @@ Texture::~Texture(void) { Release(); }
 
 void Texture::Release(void)
 {
-	glDeleteTextures(1, &m_nTextureID);
+	//a texture that was only decoded never touched OpenGL, it may not even be on its thread
+	if (m_uUploadBuffer > 0)
+	{
+		if (m_pUploadMemory != nullptr)
+		{
+			glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_uUploadBuffer);
+			glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+			glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+		}
+		glDeleteBuffers(1, &m_uUploadBuffer);
+	}
+	if (m_nTextureID > 0)
+		glDeleteTextures(1, &m_nTextureID);
+	if (m_pBitmap != nullptr)
+		FreeImage_Unload(m_pBitmap);
+	m_uUploadBuffer = 0;
+	m_pUploadMemory = nullptr;
+	m_nTextureID = 0;
+	m_pBitmap = nullptr;
 }
 void Texture::Init(void)
 {
@@ -17,6 +37,12 @@ void Texture::Init(void)
 	m_sAbsoluteRoute = "";
 }
 bool Texture::LoadTexture(String a_sFileName)
+{
+	if (!DecodeTexture(a_sFileName))
+		return false;
+	return UploadTexture();
+}
+bool Texture::DecodeTexture(String a_sFileName)
 {
 	if (a_sFileName == "NULL")
 		return false;
@@ -44,65 +70,120 @@ bool Texture::LoadTexture(String a_sFileName)
 	//Based on Raul's implementation: http://www.raul-art.blogspot.com
 	FREE_IMAGE_FORMAT eFormat = FreeImage_GetFileType(m_sFileName.c_str(), 0);//Detect the file format
 	FIBITMAP* image = FreeImage_Load(eFormat, m_sFileName.c_str()); //Load the file as FreeImage imagefile
-	image = FreeImage_ConvertTo32Bits(image); //convert to 32bits
+	if (image == nullptr)
+		return false;
+	if (FreeImage_GetBPP(image) != 32)
+	{
+		FIBITMAP* image32 = FreeImage_ConvertTo32Bits(image); //convert to 32bits
+		FreeImage_Unload(image);
+		image = image32;
+		if (image == nullptr)
+			return false;
+	}
 
-	int w = FreeImage_GetWidth(image);
-	int h = FreeImage_GetHeight(image);
+	//the bitmap is kept as FreeImage made it, the upload reads its channel order as it is
+	if (m_pBitmap != nullptr)
+		FreeImage_Unload(m_pBitmap);
+	m_pBitmap = image;
+	m_nWidth = FreeImage_GetWidth(image);
+	m_nHeight = FreeImage_GetHeight(image);
 #ifdef DEBUG
 	std::cout << "Texture loaded " << m_sFileName.c_str() << std::endl; //Some debugging code
-	std::cout << "               With size [ " << w << " * " << h << "]" << std::endl;
+	std::cout << "               With size [ " << m_nWidth << " * " << m_nHeight << "]" << std::endl;
 #endif
-	GLubyte* tempGLTexture = new GLubyte[4 * w * h];//Create a new texture to hold the information onto
-	char* pixeles = (char*)FreeImage_GetBits(image);//Create a pixel container
-							 //FreeImage loads in BGRA format, so you need to swap some bytes (Or use GL_BGR).
-	for (int nPixel = 0; nPixel < (w * h); nPixel++)
+	return true;
+}
+uint Texture::GetDecodedSize(void)
+{
+	if (m_pBitmap == nullptr)
+		return 0;
+	return static_cast<uint>(m_nWidth) * static_cast<uint>(m_nHeight) * 4;
+}
+bool Texture::UploadTexture(void)
+{
+	if (m_pBitmap == nullptr)
+		return false;
+	return CreateTexture(FreeImage_GetBits(m_pBitmap));
+}
+GLubyte* Texture::MapUploadBuffer(void)
+{
+	if (m_pBitmap == nullptr)
+		return nullptr;
+	if (m_pUploadMemory != nullptr)
+		return m_pUploadMemory;
+
+	//orphaned and written only once, the driver can hand out memory it is not using
+	uint uSize = GetDecodedSize();
+	if (m_uUploadBuffer == 0)
+		glGenBuffers(1, &m_uUploadBuffer);
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_uUploadBuffer);
+	glBufferData(GL_PIXEL_UNPACK_BUFFER, uSize, nullptr, GL_STREAM_DRAW);
+	m_pUploadMemory = static_cast<GLubyte*>(glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, uSize,
+		GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT));
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+	if (m_pUploadMemory == nullptr)
 	{
-		tempGLTexture[nPixel * 4 + 0] = pixeles[nPixel * 4 + 2];
-		tempGLTexture[nPixel * 4 + 1] = pixeles[nPixel * 4 + 1];
-		tempGLTexture[nPixel * 4 + 2] = pixeles[nPixel * 4 + 0];
-		tempGLTexture[nPixel * 4 + 3] = pixeles[nPixel * 4 + 3];
+		glDeleteBuffers(1, &m_uUploadBuffer);
+		m_uUploadBuffer = 0;
 	}
-	FreeImage_Unload(image); //OUT_DONE with the image, unload it
+	return m_pUploadMemory;
+}
+void Texture::WriteUploadBuffer(void)
+{
+	if (m_pUploadMemory == nullptr || m_pBitmap == nullptr)
+		return;
+	memcpy(m_pUploadMemory, FreeImage_GetBits(m_pBitmap), GetDecodedSize());
+}
+bool Texture::UploadFromBuffer(void)
+{
+	if (m_pUploadMemory == nullptr)
+		return UploadTexture();
+
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_uUploadBuffer);
+	bool bIntact = glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER) == GL_TRUE;
+	m_pUploadMemory = nullptr;
 
+	//with the buffer bound the pixels are read from its start
+	bool bUploaded = bIntact && CreateTexture(nullptr);
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+	glDeleteBuffers(1, &m_uUploadBuffer);
+	m_uUploadBuffer = 0;
+
+	//the contents of the buffer were lost, go from the bitmap instead
+	if (!bIntact)
+		return UploadTexture();
+	return bUploaded;
+}
+bool Texture::CreateTexture(GLvoid const* a_pPixels)
+{
 	if(m_nTextureID > 0)// if the texture is already binded
 	{
 		glDeleteTextures(1, &m_nTextureID);
-/*#if _MSC_VER == 1800 //If visual studio 2013
-		 /*m_nTextureID = SOIL_load_OGL_texture
-		(
-			m_sFileName.c_str(),
-			SOIL_LOAD_AUTO,
-			SOIL_CREATE_NEW_ID,
-			SOIL_FLAG_INVERT_Y 
-		);
-#elif _MSC_VER == 1900 //If visual studio 2015
-		
-		
-//#endif*/
 	}
-	//else
-	//{
-	//	m_nTextureID = SOIL_load_OGL_texture
-	//	(
-	//		m_sFileName.c_str(),
-	//		SOIL_LOAD_AUTO,
-	//		m_nTextureID,
-	//		SOIL_FLAG_INVERT_Y
-	//	);
-	//}
+
+	//FreeImage stores the channels in the order of the machine, BGRA on windows; OpenGL takes
+	//that order as it is so no swizzle is needed. Rows of a 32 bit bitmap have no padding
+#if FREEIMAGE_COLORORDER == FREEIMAGE_COLORORDER_BGR
+	const GLenum eFormat = GL_BGRA;
+#else
+	const GLenum eFormat = GL_RGBA;
+#endif
 
 	//Now generate the OpenGL texture object 
 	glGenTextures(1, &m_nTextureID); //Generate a container
-	glBindTexture(GL_TEXTURE_2D, m_nTextureID); //Set the active texture
-	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, w, h, 0, GL_RGBA, GL_UNSIGNED_BYTE, (GLvoid*)tempGLTexture); //Set the data
+	GLState::BindTexture2D(GL_TEXTURE0, m_nTextureID); //Set the active texture
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, m_nWidth, m_nHeight, 0, eFormat, GL_UNSIGNED_BYTE, a_pPixels); //Set the data
+	glGenerateMipmap(GL_TEXTURE_2D);
+	//blocky up close like before, the mip chain keeps it from shimmering far away
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_LINEAR);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
 
-	//glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-	//glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-	//glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+	//the pixels live in OpenGL now
+	FreeImage_Unload(m_pBitmap); //OUT_DONE with the image, unload it
+	m_pBitmap = nullptr;
 
 	if (glGetError())
 	{
@@ -80,6 +80,24 @@ int TextureManager::LoadTexture(String a_sName)
 	}
 	return nTexture;
 }
+int TextureManager::AddTexture(Texture* a_pTexture)
+{
+	if (a_pTexture == nullptr)
+		return -1;
+
+	auto var = m_map.find(a_pTexture->GetFileName());
+	if (var != m_map.end())
+	{
+		if (m_textureList[var->second] != a_pTexture)
+			delete a_pTexture;
+		return var->second;
+	}
+
+	m_textureList.push_back(a_pTexture);
+	int nTexture = GetTextureCount() - 1;
+	m_map[a_pTexture->GetFileName()] = nTexture;
+	return nTexture;
+}
 void TextureManager::SaveTexture(String a_sTextureName)
 {
 	//working on this still, weird tint in the texture.
@@ -0,0 +1,184 @@
+#include "BasicX\Mesh\VertexLayout.h"
+#include <cstring>
+using namespace BasicX;
+//  VertexLayout
+VertexLayout::VertexLayout(BTO_VERTEX a_eFormat)
+{
+	m_eFormat = a_eFormat;
+
+	//components, type, normalized and bytes of each location
+	struct { GLint nComponents; GLenum eType; GLboolean bNormalized; uint uSize; } format[6];
+	if (m_eFormat == VERTEX_FLOAT)
+	{
+		for (uint i = 0; i < 6; i++)
+			format[i] = { 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float) };
+	}
+	else
+	{
+		//half positions keep a 4th component so the next attribute stays 4 byte aligned
+		if (m_eFormat == VERTEX_PACKED_HALF)
+			format[0] = { 4, GL_HALF_FLOAT, GL_FALSE, 4 * sizeof(unsigned short) };
+		else
+			format[0] = { 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float) };
+		format[1] = { 4, GL_UNSIGNED_BYTE, GL_TRUE, 4 };
+		format[2] = { 2, GL_HALF_FLOAT, GL_FALSE, 2 * sizeof(unsigned short) };
+		for (uint i = 3; i < 6; i++)
+			format[i] = { 4, GL_INT_2_10_10_10_REV, GL_TRUE, 4 };
+	}
+
+	m_uStride = 0;
+	for (uint i = 0; i < 6; i++)
+	{
+		VertexAttribute attribute;
+		attribute.m_uLocation = i;
+		attribute.m_nComponents = format[i].nComponents;
+		attribute.m_eType = format[i].eType;
+		attribute.m_bNormalized = format[i].bNormalized;
+		attribute.m_uOffset = m_uStride;
+		attribute.m_uSize = format[i].uSize;
+		m_lAttribute.push_back(attribute);
+		m_uStride += attribute.m_uSize;
+	}
+}
+BTO_VERTEX VertexLayout::GetFormat(void) const { return m_eFormat; }
+uint VertexLayout::GetStride(void) const { return m_uStride; }
+VertexAttribute const& VertexLayout::GetAttribute(uint a_uLocation) const { return m_lAttribute[a_uLocation]; }
+void VertexLayout::Pack(std::vector<vector3> const& a_lVertex, std::vector<unsigned char>& a_lBuffer) const
+{
+	uint uVertexCount = a_lVertex.size() / 6;
+	a_lBuffer.resize(uVertexCount * m_uStride);
+	if (uVertexCount == 0)
+		return;
+
+	//the float layout is the composed array as is
+	if (m_eFormat == VERTEX_FLOAT)
+	{
+		memcpy(&a_lBuffer[0], &a_lVertex[0], a_lBuffer.size());
+		return;
+	}
+
+	for (uint nVertex = 0; nVertex < uVertexCount; nVertex++)
+	{
+		vector3 const* pInput = &a_lVertex[nVertex * 6];
+		unsigned char* pOutput = &a_lBuffer[nVertex * m_uStride];
+
+		//Position
+		if (m_eFormat == VERTEX_PACKED_HALF)
+		{
+			unsigned short position[4] = { FloatToHalf(pInput[0].x), FloatToHalf(pInput[0].y), FloatToHalf(pInput[0].z), FloatToHalf(1.0f) };
+			memcpy(pOutput + m_lAttribute[0].m_uOffset, position, sizeof(position));
+		}
+		else
+			memcpy(pOutput + m_lAttribute[0].m_uOffset, &pInput[0], sizeof(vector3));
+
+		//Color
+		uint uColor = PackColor(pInput[1]);
+		memcpy(pOutput + m_lAttribute[1].m_uOffset, &uColor, sizeof(uint));
+
+		//UV
+		unsigned short uv[2] = { FloatToHalf(pInput[2].x), FloatToHalf(pInput[2].y) };
+		memcpy(pOutput + m_lAttribute[2].m_uOffset, uv, sizeof(uv));
+
+		//Normal, Bi-Normal and Tangent
+		for (uint i = 3; i < 6; i++)
+		{
+			uint uPacked = PackSigned1010102(pInput[i]);
+			memcpy(pOutput + m_lAttribute[i].m_uOffset, &uPacked, sizeof(uint));
+		}
+	}
+}
+void VertexLayout::Apply(void) const
+{
+	for (uint i = 0; i < m_lAttribute.size(); i++)
+	{
+		VertexAttribute const& attribute = m_lAttribute[i];
+		glEnableVertexAttribArray(attribute.m_uLocation);
+		glVertexAttribPointer(attribute.m_uLocation, attribute.m_nComponents, attribute.m_eType,
+			attribute.m_bNormalized, m_uStride, (GLvoid*)(size_t)attribute.m_uOffset);
+	}
+}
+unsigned short VertexLayout::FloatToHalf(float a_fValue)
+{
+	uint uBits;
+	memcpy(&uBits, &a_fValue, sizeof(uint));
+
+	uint uSign = (uBits >> 16) & 0x8000;
+	int nExponent = static_cast<int>((uBits >> 23) & 0xff) - 127 + 15;
+	uint uMantissa = uBits & 0x7fffff;
+
+	//NaN stays NaN, anything too big for a half becomes infinity
+	if ((uBits & 0x7fffffff) > 0x7f800000)
+		return static_cast<unsigned short>(uSign | 0x7e00);
+	if (nExponent >= 31)
+		return static_cast<unsigned short>(uSign | 0x7c00);
+
+	//too small for a normal half, keep what fits as a denormal
+	if (nExponent <= 0)
+	{
+		if (nExponent < -10)
+			return static_cast<unsigned short>(uSign);
+		uMantissa |= 0x800000;
+		uint uShift = 14 - nExponent;
+		uint uHalf = uMantissa >> uShift;
+		if ((uMantissa >> (uShift - 1)) & 1)
+			uHalf++;
+		return static_cast<unsigned short>(uSign | uHalf);
+	}
+
+	//rounding may carry into the exponent, that is still the right nearest value
+	uint uHalf = (static_cast<uint>(nExponent) << 10) | (uMantissa >> 13);
+	if (uMantissa & 0x1000)
+		uHalf++;
+	return static_cast<unsigned short>(uSign | uHalf);
+}
+float VertexLayout::HalfToFloat(unsigned short a_uHalf)
+{
+	uint uSign = (a_uHalf & 0x8000) << 16;
+	uint uExponent = (a_uHalf >> 10) & 0x1f;
+	uint uMantissa = a_uHalf & 0x3ff;
+	uint uBits;
+
+	if (uExponent == 0x1f) //infinity and NaN
+		uBits = uSign | 0x7f800000 | (uMantissa << 13);
+	else if (uExponent != 0) //normal
+		uBits = uSign | ((uExponent + 127 - 15) << 23) | (uMantissa << 13);
+	else if (uMantissa == 0) //zero
+		uBits = uSign;
+	else
+	{
+		//denormal, shift until the leading bit is the implicit one
+		int nExponent = 127 - 15 + 1;
+		while ((uMantissa & 0x400) == 0)
+		{
+			uMantissa <<= 1;
+			nExponent--;
+		}
+		uBits = uSign | (static_cast<uint>(nExponent) << 23) | ((uMantissa & 0x3ff) << 13);
+	}
+
+	float fValue;
+	memcpy(&fValue, &uBits, sizeof(float));
+	return fValue;
+}
+uint VertexLayout::PackSigned1010102(vector3 a_v3Input)
+{
+	uint uPacked = 0;
+	for (uint i = 0; i < 3; i++)
+	{
+		float fValue = a_v3Input[i] < -1.0f ? -1.0f : (a_v3Input[i] > 1.0f ? 1.0f : a_v3Input[i]);
+		int nValue = static_cast<int>(floor(fValue * 511.0f + 0.5f));
+		uPacked |= (static_cast<uint>(nValue) & 0x3ff) << (i * 10);
+	}
+	//w is 0, these are directions
+	return uPacked;
+}
+uint VertexLayout::PackColor(vector3 a_v3Color)
+{
+	uint uPacked = 0xff000000;
+	for (uint i = 0; i < 3; i++)
+	{
+		float fValue = a_v3Color[i] < 0.0f ? 0.0f : (a_v3Color[i] > 1.0f ? 1.0f : a_v3Color[i]);
+		uPacked |= static_cast<uint>(fValue * 255.0f + 0.5f) << (i * 8);
+	}
+	return uPacked;
+}
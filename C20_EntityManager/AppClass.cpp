@@ -13,17 +13,30 @@ void Application::InitVariables(void)
 
 	m_pLightMngr->SetPosition(vector3(0.0f, 3.0f, 13.0f), 1); //set the position of first light (0 is reserved for ambient light)
 
+	// The profiler is made here so the workers find it when they start timing
+	MY_PROFILE_THREAD("Main");
+
+	// Every core but this one runs jobs
+	m_uJobWorkers = MyJobSystem::GetInstance()->GetWorkerCount();
+
 	//Entity Manager
 	m_pEntityMngr = MyEntityManager::GetInstance();
 
+	// Read the files of every model at once, the entities below pick them up as they are created
+	MyAssetCache* pAssetCache = MyAssetCache::GetInstance();
+	pAssetCache->Request(PLAYER_MODEL_PATH);
+	pAssetCache->Request(m_sCowModelPath);
+	pAssetCache->Request(m_sCoinModelPath);
+
 	// add the player
-	m_pEntityMngr->AddEntity(PLAYER_MODEL_PATH, PLAYER_UID, Simplex::EntityLayer::Player);
+	m_hPlayer = m_pEntityMngr->AddEntity(PLAYER_MODEL_PATH, PLAYER_UID, Simplex::EntityLayer::Player);
 
 	// set the model matrix and visibility of the player
-	m_pEntityMngr->SetAxisVisibility(true, PLAYER_UID);
+	m_pEntityMngr->SetAxisVisibility(true, m_hPlayer);
 
-	// Seed random
-	srand(static_cast <unsigned> (time(0)));
+	// The rules of the game, seeded with the time
+	m_pGameLogic = new MyGameLogic(static_cast <unsigned> (time(0)));
+	m_pEntityMngr->SetModelMatrix(m_pGameLogic->GetPlayerMatrix(), m_hPlayer);
 
 #if DEBUG
 	m_uNumberObstacles = 100;
@@ -32,77 +45,128 @@ void Application::InitVariables(void)
 #endif
 
 	// Generate the coins and obstacles
-	m_mObstacles = GenerateObjects(m_sCowUID, m_sCowModelPath, m_uNumberObstacles, m_fObstacleSpacing, Simplex::EntityLayer::Obstacle);
-	m_mCoins = GenerateObjects(m_sCoinUID, m_sCoinModelPath, m_uNumberOfCoins, m_fCoinSpacing, Simplex::EntityLayer::Coin);
-	// Create the root node to the octree
-	m_pRootOctant = new MyOctant(
-		m_pMeshMngr,		// Mesh man
-		m_pEntityMngr,		// Entity man
-		m_uOctantLevels,		// Max octant levels
-		5,				// Ideal entity count
-		5.0f,			// Size of the octant
-		vector3(0.f, 1.f, 0.f)
-	);
-
-	m_pRootOctant->AddAllEntites();
-	m_pRootOctant->BuildTree();
+	GenerateObjects(m_sCowUID, m_sCowModelPath, m_uNumberObstacles, MyGameLogic::Obstacles, Simplex::EntityLayer::Obstacle);
+	GenerateObjects(m_sCoinUID, m_sCoinModelPath, m_uNumberOfCoins, MyGameLogic::Coins, Simplex::EntityLayer::Coin);
+
+	// Create the broadphases, they hold every entity where it spawned
+	m_pGameLogic->BuildBroadphase(m_pEntityMngr->GetEntityStore());
+
+	// The first frame shows the world as it was made, the simulation records the ones after it
+	RenderFrame& frame = m_Frame[m_uFrontFrame];
+	frame.m_Snapshot.CaptureView();
+	m_pEntityMngr->CaptureSnapshot(frame.m_Snapshot, m_uFrameCount, true);
 }
 
-std::map<std::string, vector3> Simplex::Application::GenerateObjects(const std::string a_UID, const std::string a_ModelPath, const uint & a_Amount, float & a_Spacing, Simplex::EntityLayer a_layer)
+void Simplex::Application::GenerateObjects(const std::string a_UID, const std::string a_ModelPath, const uint & a_Amount, MyGameLogic::Lane a_eLane, Simplex::EntityLayer a_layer)
 {
-	std::map<std::string, vector3> objects;
+	m_lLaneEntity[a_eLane].reserve(a_Amount);
 
-	// Generate the coins
+	// Generate the objects
 	for (size_t i = 0; i < a_Amount; ++i)
 	{
 		std::string name = a_UID;
 		name += std::to_string(i);
 
-		m_pEntityMngr->AddEntity(a_ModelPath, name, a_layer);
-		m_pEntityMngr->SetAxisVisibility(true, name);
-
-		vector3 pos(GenerateRandomLaneX(), 0.f, -20.0f - (a_Spacing * i));
+		EntityHandle hEntity = m_pEntityMngr->AddEntity(a_ModelPath, name, a_layer);
+		if (!hEntity.IsValid()) continue;
+		m_pEntityMngr->SetAxisVisibility(true, hEntity);
 
-		// Add this to the map of coins
-		objects[name] = pos;
+		// The game logic puts it behind the ones before it
+		uint uIndex = m_pGameLogic->AddLaneObject(a_eLane);
+		m_lLaneEntity[a_eLane].push_back(hEntity);
 
-		m_pEntityMngr->SetModelMatrix(
-			glm::translate(pos) * glm::rotate(IDENTITY_M4, 90.0f, AXIS_Y),
-			name);
+		m_pEntityMngr->SetModelMatrix(m_pGameLogic->GetLaneMatrix(a_eLane, uIndex), hEntity);
 	}
-
-	return objects;
 }
 
 void Application::Update(void)
 {
+	MY_PROFILE_FUNCTION();
+
 	//Update the system so it knows how much time has passed since the last call
 	m_pSystem->Update();
 
-	// get delta time
-	static float fDeltaTime = 0;	//store the new timer
-	static uint uClock = m_pSystem->GenClock(); //generate a new clock for that timer
-	fDeltaTime = m_pSystem->GetDeltaTime(uClock); //get the delta time for that timer
+	// get delta time from the steady clock, the clocks of the system only tick every 10 to 16 ms
+	float fFrameTime = m_FixedTimestep.Tick();
+	float fDeltaTime = fFrameTime;
+	uint uSteps = 1;
+	float fAlpha = 1.0f;
+	if (m_bFixedTimestep)
+	{
+		// the time of the frame is simulated in whole steps, what is left carries to the next one
+		uSteps = m_FixedTimestep.Advance(fFrameTime);
+		fDeltaTime = m_FixedTimestep.GetStep();
+		fAlpha = m_FixedTimestep.GetAlpha();
+	}
+
+	// Load the models requested in the background whose files are ready
+	MyAssetCache::GetInstance()->Update(m_fLoadBudget);
 
+	// The input and the loads are done with the entities, the simulation has them until the swap.
+	// The back frame is seen from the camera and lights as they are now
+	++m_uFrameCount;
+	RenderFrame& frame = m_Frame[1 - m_uFrontFrame];
+	frame.m_uFrame = m_uFrameCount;
+	frame.m_Snapshot.CaptureView();
+	m_bSimulating = true;
+	if (m_bPipeline)
+	{
+		// A worker simulates it while the main thread renders the front frame
+		MyJobSystem::GetInstance()->Run([this, uSteps, fDeltaTime, fAlpha, &frame]()
+		{
+			Simulate(uSteps, fDeltaTime, fAlpha, frame);
+		});
+	}
+	else
+	{
+		// Simulated here and shown right away
+		Simulate(uSteps, fDeltaTime, fAlpha, frame);
+		SwapFrame();
+	}
+}
+
+void Simplex::Application::Simulate(uint a_uSteps, float a_fDeltaTime, float a_fAlpha, RenderFrame& a_Frame)
+{
+	MY_PROFILE_FUNCTION();
 	if (m_gameState == GameState::Playing)
 	{
-		// Move the player
-		UpdatePlayer(fDeltaTime);
+		// The last frame left the entities in between steps, the collisions have to see where they are
+		if (a_uSteps > 0)
+			ApplySimulationState(1.0f);
 
-		// Move the obstacles towards the player
-		UpdateObtacles(fDeltaTime);
+		for (uint i = 0; i < a_uSteps && m_gameState == GameState::Playing; ++i)
+		{
+			// Move the player
+			UpdatePlayer(a_fDeltaTime);
+
+			// Move the obstacles and coins towards the player
+			UpdateLanes(a_fDeltaTime);
+		}
 
-		// Update the coins
-		UpdateCoins(fDeltaTime);
+		// Render in between the last two steps so the motion does not judder with the frame rate
+		ApplySimulationState(a_fAlpha);
 	}
 
-	//Add objects to render list
-	m_pEntityMngr->AddEntityToRenderList(-1, true);
-	++m_uFrameCount;
+	// Record what the frame draws, nothing reads the entities to render it
+	m_pEntityMngr->CaptureSnapshot(a_Frame.m_Snapshot, a_Frame.m_uFrame, true);
+	a_Frame.m_gameState = m_gameState;
+	a_Frame.m_nScore = score;
+}
+
+void Simplex::Application::SwapFrame(void)
+{
+	if (!m_bSimulating)
+		return;
+
+	// Nothing started this frame can still be running when the entities go back to the input
+	MyJobSystem::GetInstance()->WaitFrame();
+	m_uFrontFrame = 1 - m_uFrontFrame;
+	m_bSimulating = false;
 }
 
 void Application::UpdatePlayer(float & dt)
 {
+	MY_PROFILE_FUNCTION();
 	bool colliding = false;
 
 	// See which optimization that we want to use
@@ -115,195 +179,84 @@ void Application::UpdatePlayer(float & dt)
 		colliding = BruteForceCollisionDetection();
 	}
 
-	if (colliding)
-	{
-		m_v3PlayerPos.z += m_fSpeed * dt;
-		if (m_fPlayerRotY < 270)
-		{
-			m_fPlayerRotY += 20.0f;
-		}
-	}
-	else
-	{
-		//rotate the player back
-		if (m_fPlayerRotY > 180)
-		{
-			m_fPlayerRotY -= 20.0f;
-		}
-		// update player velocity from input
-		m_v3PlayerVelo.x = m_fPlayerInputDirection * m_fPlayerHorizSpeed;
-
-		// update player position from velocity
-		m_v3PlayerPos += m_v3PlayerVelo * dt;
-
-		// clamp player to ground
-		if (m_v3PlayerPos.y < 0)
-			m_v3PlayerPos.y = 0;
-
-		// check if player is on ground
-		m_bIsPlayerOnGround = m_v3PlayerPos.y == 0;
-
-		// clamp player x to lane bounds
-		if (m_v3PlayerPos.x > LANE_X_MAX)
-		{
-			m_v3PlayerPos.x = LANE_X_MAX;
-			m_fPlayerInputDirection = 0.0f;
-		}
-		else if (m_v3PlayerPos.x < LANE_X_MIN)
-		{
-			m_v3PlayerPos.x = LANE_X_MIN;
-			m_fPlayerInputDirection = 0.0f;
-		}
-		else
-		{
-			m_fPlayerInputDirection *= m_fPlayerInputDampening;
-		}
-	}
+	// The game logic pushes the player back if it collides
+	m_pGameLogic->UpdatePlayer(dt, colliding);
 
 	//if the player is off screen, game over!
-	if (m_v3PlayerPos.z > 5.0f)
+	if (m_pGameLogic->IsPlayerOffScreen())
 	{
 		SetGameState(GameState::GameOver);
 	}
 
 	// set the player's position and rotation
-	matrix4 mPlayer = glm::translate(m_v3PlayerPos) * glm::rotate(IDENTITY_M4, m_fPlayerRotY, AXIS_Y);
-	m_pEntityMngr->SetModelMatrix(mPlayer, PLAYER_UID);
-
-	// apply gravity to player velo
-	m_v3PlayerVelo += m_v3Gravity * dt;
+	m_pEntityMngr->SetModelMatrix(m_pGameLogic->GetPlayerMatrix(), m_hPlayer);
 }
 
 bool Simplex::Application::BruteForceCollisionDetection()
 {
-	bool isColliding = false;
-
-	//check collisions. This is brute force and checking every object in the scene.
-	for (uint i = 0; i < m_pEntityMngr->GetEntityCount() - 1; ++i)
-	{
-		for (uint j = i + 1; j < m_pEntityMngr->GetEntityCount(); ++j)
-		{
-			// If what we just checked was the player, then set isColldiing to true.
-			if (m_pEntityMngr->GetEntity(i)->IsColliding(m_pEntityMngr->GetEntity(j)))
-			{
-				// Check that what we just hit was an obstcle
-				if ((m_pEntityMngr->GetEntity(i)->GetEntityLayer() == EntityLayer::Obstacle ||
-					m_pEntityMngr->GetEntity(j)->GetEntityLayer() == EntityLayer::Obstacle) &&
-					(i == 0 || j == 0))
-				{
-					isColliding = true;
-				}
-			}
-		}
-	}
-
-	return isColliding;
+	MY_PROFILE_FUNCTION();
+	uint uPlayer = static_cast<uint>(m_pEntityMngr->GetEntityIndex(m_hPlayer));
+
+	//check collisions between every object in the scene. The sweep and prune along Z
+	//hands out the pairs whose bounds overlap instead of looping over all of them
+	m_pEntityMngr->GetCandidatePairs(m_lCandidatePairs);
+	// The pairs are tested on every core, the results come back in the same order
+	m_pEntityMngr->CheckCollisions(m_lCandidatePairs, m_lPairColliding);
+
+	// Only the player hitting an obstacle counts
+	return MyGameLogic::IsPlayerHit(m_lCandidatePairs, m_lPairColliding,
+		m_pEntityMngr->GetEntityStore().GetLayerArray(), uPlayer);
 }
 
 bool Simplex::Application::OptimizedCollisionDetection()
 {
+	MY_PROFILE_FUNCTION();
 	bool isColliding = false;
-	// this is the octree stuff, which isnt great for this because we need
-	// to rebuild the tree so often. But, this was a project requirement so 
-	// I implmented it anyway. 
-	/*if(m_uFrameCount % 5 ==0)
-		m_pRootOctant->BuildTree();
-
-	// Update the octree collisions. Updating root will recusively call the children
-	m_pRootOctant->UpdateOctant();
-	*/
 
 	// We only need to check against the player in this case, nothing else
-	MyEntity * player = m_pEntityMngr->GetEntity(0);
+	int nPlayer = m_pEntityMngr->GetEntityIndex(m_hPlayer);
+	if (nPlayer < 0) return false;
 
-	for (uint i = 0; i < m_pEntityMngr->GetEntityCount(); ++i)
-	{
-		if (m_pEntityMngr->GetEntity(i)->GetRigidBody()->GetCenterGlobal().z > 5.f) continue;
-		// If what we just checked was the player, then set isColldiing to true.
-		if (player->IsColliding(m_pEntityMngr->GetEntity(i)))
-		{
-			// Check that what we just hit was an obstcle
-			if (m_pEntityMngr->GetEntity(i)->GetEntityLayer() == EntityLayer::Obstacle)
-			{
-				isColliding = true;
-			}
-		}
-	}
-	player = nullptr;
+	// Only the entities whose box overlaps the player's reach the rigid body test, the broadphase
+	// reads the world bounds straight from the contiguous arrays of the store
+	MyEntityStore const& store = m_pEntityMngr->GetEntityStore();
+	m_pGameLogic->UpdateBroadphase(store, m_eBroadphase);
+	m_pGameLogic->FindPlayerPairs(store, static_cast<uint>(nPlayer), m_eBroadphase, m_lCandidatePairs);
+
+	// If anything we just checked hit the player, then set isColldiing to true.
+	isColliding = m_pEntityMngr->CheckCollisions(m_lCandidatePairs, m_lPairColliding) > 0;
 
 	return isColliding;
 }
 
-void Application::UpdateObtacles(float & dt)
+void Application::UpdateLanes(float & dt)
 {
-	std::map<String, Simplex::vector3>::iterator it;
-
-	for (it = m_mObstacles.begin(); it != m_mObstacles.end(); ++it)
-	{
-		// Add to this position
-		it->second.z += m_fSpeed * dt;
-
-		// Check if we need to reset this obstacle
-		if (it->second.z >= OBSTACLE_Z_MAX)
-		{
-			it->second.z = OBSTACLE_Z_START;
-			// Put the X in a random position inside the lanes
-			it->second.x = GenerateRandomLaneX();
-		}
-
-		// Calculate new model matrix
-		matrix4 mObstacle = glm::translate(it->second) * glm::rotate(IDENTITY_M4, 90.f, AXIS_Y);
-
-		// Set the model matrix
-		m_pEntityMngr->SetModelMatrix(mObstacle, it->first);
-	}
+	MY_PROFILE_FUNCTION();
+	// The moves draw random numbers in order, the model matrices go to every core
+	m_pGameLogic->UpdateLanes(dt);
+	UpdateLaneMatrices(MyGameLogic::Obstacles, 1.0f);
+	UpdateLaneMatrices(MyGameLogic::Coins, 1.0f);
 }
 
-void Simplex::Application::UpdateCoins(float & dt)
+void Simplex::Application::ApplySimulationState(float a_fAlpha)
 {
-	// No need to check if the coins are emtpy
-	//if (m_mCoins.size() <= 0) return;
-
-	std::map<String, Simplex::vector3>::iterator it;
+	m_pEntityMngr->SetModelMatrix(m_pGameLogic->GetPlayerMatrix(a_fAlpha), m_hPlayer);
 
-	for (it = m_mCoins.begin(); it != m_mCoins.end(); ++it)
-	{
-		// Add to this position
-		it->second.z += m_fSpeed * dt;
-
-		// Check if we need to reset this obstacle
-		if (it->second.z >= OBSTACLE_Z_MAX)
-		{
-			it->second.z = OBSTACLE_Z_START;
-			// Put the X in a random position inside the lanes
-			it->second.x = GenerateRandomLaneX();
-		}
-		m_fCoinRotY += 1.0f;
-		// Calculate new model matrix
-		matrix4 mObstacle = glm::translate(it->second) * glm::rotate(IDENTITY_M4, m_fCoinRotY, AXIS_Y);
-
-		// Set the model matrix
-		m_pEntityMngr->SetModelMatrix(mObstacle, it->first);
-	}
-}
-
-float Simplex::Application::GenerateRandomLaneX()
-{
-	return LANE_X_MIN + static_cast <float> (rand()) / (static_cast <float> (RAND_MAX / (LANE_X_MAX - LANE_X_MIN)));
+	UpdateLaneMatrices(MyGameLogic::Obstacles, a_fAlpha);
+	UpdateLaneMatrices(MyGameLogic::Coins, a_fAlpha);
 }
 
-void Application::PlayerRespawn(void)
+void Simplex::Application::UpdateLaneMatrices(MyGameLogic::Lane a_eLane, float a_fAlpha)
 {
-	m_fPlayerInputDirection = 0.0f;
-	m_v3PlayerVelo = vector3(0.0f);
-
-	m_v3PlayerPos = vector3(0.0f);
-	m_fPlayerRotY = 180;
-
-	matrix4 mPlayer = glm::translate(m_v3PlayerPos) * glm::rotate(IDENTITY_M4, m_fPlayerRotY, AXIS_Y);
-	m_pEntityMngr->SetModelMatrix(mPlayer, PLAYER_UID);
-
-	score = 0;
+	MY_PROFILE_FUNCTION();
+	// Every object only touches its own entity, its rigid body and its slot in the store
+	std::vector<EntityHandle> const& lEntity = m_lLaneEntity[a_eLane];
+	MyJobSystem::GetInstance()->ParallelFor(lEntity.size(), 128, [&](uint a_uBegin, uint a_uEnd)
+	{
+		MY_PROFILE_ZONE("Lane matrices");
+		for (uint i = a_uBegin; i < a_uEnd; ++i)
+			m_pEntityMngr->SetModelMatrix(m_pGameLogic->GetLaneMatrix(a_eLane, i, a_fAlpha), lEntity[i]);
+	});
 }
 
 void Application::Display(void)
@@ -311,28 +264,64 @@ void Application::Display(void)
 	// Clear the screen
 	ClearScreen();
 
+	// The front frame is seen from the camera it was recorded with, the input keeps moving the live one
+	RenderFrame const& frame = m_Frame[m_uFrontFrame];
+	Camera* pCamera = m_pCameraMngr->GetCamera();
+	Camera liveCamera = *pCamera;
+	*pCamera = frame.m_Snapshot.GetCamera();
+
+	// hand the models and debug shapes of the front frame to the mesh manager
+	m_pEntityMngr->SubmitSnapshot(frame.m_Snapshot);
+
 	// draw a skybox
 	m_pMeshMngr->AddSkyboxToRenderList();
 
 	//render list call
-	m_uRenderCallCount = m_pMeshMngr->Render();
+	{
+		MY_PROFILE_ZONE("MeshManager::Render");
+		m_uRenderCallCount = m_pMeshMngr->Render();
+	}
 
 	//clear the render list
 	m_pMeshMngr->ClearRenderList();
 
+	// back to the camera of the input
+	*pCamera = liveCamera;
+
 	//draw gui
-	DrawGUI();
+	{
+		MY_PROFILE_ZONE("Application::DrawGUI");
+		DrawGUI();
+	}
 
 	//end the current frame (internally swaps the front and back buffers)
-	m_pWindow->display();
+	{
+		MY_PROFILE_ZONE("Window::display");
+		m_pWindow->display();
+	}
+
+	//collect the zones of every thread, the frame shown in the profiler is this one
+	MY_PROFILE_FRAME();
 }
 void Application::Release(void)
 {
+	//release the game logic and its broadphases
+	SafeDelete(m_pGameLogic);
+
 	//release the entity manager
 	m_pEntityMngr->ReleaseInstance();
 
+	//release the shared assets once no entity holds them
+	MyAssetCache::ReleaseInstance();
+
 	//release GUI
 	ShutdownGUI();
+
+	//stop the job system before the profiler its workers write to
+	MyJobSystem::ReleaseInstance();
+
+	//release the profiler, the workers are done by now
+	MyProfiler::ReleaseInstance();
 }
 
 void Application::SetGameState(const GameState a_gameState)
@@ -340,9 +329,10 @@ void Application::SetGameState(const GameState a_gameState)
 	switch (a_gameState)
 	{
 	case GameState::Playing:
-		ResetObstaclesAndCoins();
-		PlayerRespawn();
-		// TODO: reset score here
+		// Put the lanes and the player back where they start
+		m_pGameLogic->Restart();
+		ApplySimulationState(1.0f);
+		score = 0;
 		break;
 	case GameState::GameOver:
 		break;
@@ -350,24 +340,3 @@ void Application::SetGameState(const GameState a_gameState)
 
 	m_gameState = a_gameState;
 }
-
-void Application::ResetObstaclesAndCoins(void)
-{
-	std::map<String, Simplex::vector3>::iterator it;
-	int i = 0;
-
-	for (it = m_mCoins.begin(); it != m_mCoins.end(); ++it)
-	{
-		vector3 pos(GenerateRandomLaneX(), 0.f, -20.0f - (m_fCoinSpacing * i));
-		it->second = pos;
-		i++;
-	}
-
-	i = 0;
-	for (it = m_mObstacles.begin(); it != m_mObstacles.end(); ++it)
-	{
-		vector3 pos(GenerateRandomLaneX(), 0.f, -20.0f - (m_fObstacleSpacing * i));
-		it->second = pos;
-		i++;
-	}
-}
@@ -15,7 +15,11 @@ Date: 2018/04
 #include "imgui\ImGuiObject.h"
 
 #include "MyEntityManager.h"
-#include "MyOctant.h"
+#include "MyGameLogic.h"
+#include "MyFixedTimestep.h"
+#include "MyProfiler.h"
+#include "MyJobSystem.h"
+#include "MyRenderSnapshot.h"
 
 /* non-integral (can't be const) game constants */
 #define CAMERA_POS	vector3(0.0f, 3.0f, 5.0f)
@@ -25,12 +29,6 @@ Date: 2018/04
 #define PLAYER_MODEL_PATH "Minecraft\\Pig.obj"
 #define PLAYER_UID "Player"
 
-// width of "lane", bounds for player horizontal movement and object spawning
-#define LANE_X_MAX 3.5f
-#define LANE_X_MIN -LANE_X_MAX
-#define OBSTACLE_Z_MAX 5.0f
-#define OBSTACLE_Z_START -50.0f
-
 namespace Simplex
 {
 	//Adding Application to the Simplex namespace
@@ -46,33 +44,45 @@ class Application
 
 private:
 	/* Game variables */
-	// Physics
-	vector3 m_v3Gravity = vector3(0.0f, -9.8f, 0.0f);
-
-	// Player
-	vector3 m_v3PlayerPos = vector3(0.0f, 0.0f, 0.0f);
-	vector3 m_v3PlayerVelo = vector3(0.0f);
-	float m_fPlayerHorizSpeed = 1.0f;
-	float m_fPlayerInputDirection = 0.0f; // what direction (+/-) the player should be moving in, based on input
-	float m_fPlayerInputDampening = 0.86f; // the closer to 1, the slipperier the player feels
-	float m_fPlayerJumpVelo = 5.6f; // instantaneous y velocity applied when player jumps
-	bool m_bIsPlayerOnGround = false; // whether or not the player is on the ground
+	// Player physics, lanes and broadphases, the headless simulation plays the same game with it
+	MyGameLogic* m_pGameLogic = nullptr;
 	int score = 0;
 
-	// don't need a quat, b/c player won't be doing much rotating (if any)
-	float m_fPlayerRotY = 180.0f;
-
-	float m_fCoinRotY = 0.0f;
+	// The simulation moves in fixed steps of the steady clock, rendering interpolates between the
+	// last two; when off every frame is a single step as long as the frame
+	MyFixedTimestep m_FixedTimestep;
+	bool m_bFixedTimestep = true;
+	// Workers the job system started with, the frame runs on the main thread alone when the jobs are off
+	uint m_uJobWorkers = 0;
+	bool m_bJobs = true;
 
-	MyOctant * m_pRootOctant = nullptr;
-	uint m_uOctantLevels = 1;
+	// What a frame shows: the snapshot the simulation recorded and the state the GUI prints with it
+	struct RenderFrame
+	{
+		MyRenderSnapshot m_Snapshot; // models, debug shapes, camera and lights
+		GameState m_gameState = GameState::Playing; // state of the game when it was recorded
+		int m_nScore = 0; // score when it was recorded
+		uint m_uFrame = 0; // frame it was simulated on
+	};
+	// The simulation records the back frame on a worker while the main thread renders the front one,
+	// they swap once both are done; when off the frame is simulated and rendered one after the other
+	RenderFrame m_Frame[2];
+	uint m_uFrontFrame = 0;
+	bool m_bPipeline = true;
+	bool m_bSimulating = false; // the simulation of the back frame was sent to the job system
+
+	// Broadphase used by the optimized collisions, cycled with the period key to compare their costs
+	MyGameLogic::Broadphase m_eBroadphase = MyGameLogic::PackedScan;
+	std::vector<std::pair<uint, uint>> m_lCandidatePairs; // Pairs found by the last broadphase, kept to reuse its memory
+	std::vector<uint> m_lPairColliding; // Results of the pairs tested by the last collision check
 	// The flag that will determine if we are running optimal collisions or not
 	bool m_bRunOptimialCollision = true;
-	uint m_uFrameCount;
+	uint m_uFrameCount = 0;
+
+	// Handles of the obstacles and coins, in the order of their lanes in the game logic
+	std::vector<EntityHandle> m_lLaneEntity[MyGameLogic::LaneCount];
 
-	// Obstacles
-	std::map<String, Simplex::vector3> m_mObstacles;
-	std::map<String, Simplex::vector3> m_mCoins;
+	EntityHandle m_hPlayer; // handle of the player in the entity manager
 
 	const std::string m_sCowUID = "Cow";
 	const std::string m_sCowModelPath = "Minecraft\\Cow.obj";
@@ -85,9 +95,7 @@ private:
 	/* Fields about the generated objects */
 	uint m_uNumberObstacles = 8;
 	const uint m_uNumberOfCoins = 10;
-	float m_fObstacleSpacing = 10.f;
-	float m_fSpeed = 10.f;
-	float m_fCoinSpacing = 5.0f;
+	float m_fLoadBudget = 4.0f; // milliseconds of every frame given to loading requested models
 
 	/* Simplex variables */
 	String m_sProgrammer = "Team \"No Name\""; //programmer
@@ -97,6 +105,7 @@ private:
 	bool m_bGUI_Console = true; //show Credits GUI window?
 	bool m_bGUI_Test = false; //show Test GUI window?
 	bool m_bGUI_Controller = false; //show Controller GUI window?
+	bool m_bGUI_Profiler = false; //show Profiler GUI window?
 
 	uint m_uRenderCallCount = 0; //count of render calls per frame
 	uint m_uControllerCount = 0; //count of controllers connected
@@ -186,7 +195,17 @@ private:
 	*/
 	void InitVariables(void);
 
-	std::map<std::string, vector3> GenerateObjects(const std::string a_UID, const std::string a_ModelPath, const uint & a_Amount, float & a_Spacing, Simplex::EntityLayer a_layer);
+	/*
+	USAGE: Adds the entities of a lane, the game logic places them
+	ARGUMENTS:
+	-	const std::string a_UID -> prefix of their unique IDs
+	-	const std::string a_ModelPath -> model they use
+	-	const uint & a_Amount -> entities to add
+	-	MyGameLogic::Lane a_eLane -> lane they go to
+	-	Simplex::EntityLayer a_layer -> layer of the entities
+	OUTPUT: ---
+	*/
+	void GenerateObjects(const std::string a_UID, const std::string a_ModelPath, const uint & a_Amount, MyGameLogic::Lane a_eLane, Simplex::EntityLayer a_layer);
 
 	/*
 	USAGE: Reads the configuration of the application to a file
@@ -210,12 +229,30 @@ private:
 
 #pragma region Main Loop
 	/*
-	USAGE: Updates the scene
+	USAGE: Updates the scene: advances the clock and loads on the main thread, then simulates the
+	next frame into the back snapshot, on a worker when the pipeline is on
 	ARGUMENTS: ---
 	OUTPUT: ---
 	*/
 	void Update(void);
 	/*
+	USAGE: Moves the game and records the back snapshot, the only part of the frame that touches the
+	entities; runs on any thread while nothing else moves them
+	ARGUMENTS:
+	-	uint a_uSteps -> steps to simulate
+	-	float a_fDeltaTime -> seconds of each step
+	-	float a_fAlpha -> how far the frame is into the next step, to blend the state rendered
+	-	RenderFrame& a_Frame -> back frame to record
+	OUTPUT: ---
+	*/
+	void Simulate(uint a_uSteps, float a_fDeltaTime, float a_fAlpha, RenderFrame& a_Frame);
+	/*
+	USAGE: Waits for the simulation of the back frame and makes it the front one
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void SwapFrame(void);
+	/*
 	USAGE: Displays the scene
 	ARGUMENTS: ---
 	OUTPUT: ---
@@ -241,18 +278,28 @@ private:
 	void ReleaseControllers(void);
 
 	/*
-	USAGE: Will update the positions of the obstacles coming towards the player
+	USAGE: Will update the positions of the obstacles and coins coming towards the player
 	ARGUMENTS: dt = delta time
 	OUTPUT: ---
 	*/
-	void UpdateObtacles(float & dt);
+	void UpdateLanes(float & dt);
 
 	/*
-	USAGE: Will update the positions and rotations of the coins coming towards the player
-	ARGUMENTS: dt = delta time
+	USAGE: Sets the model matrices of the player, obstacles and coins blending the state before the
+	last simulation step into the current one
+	ARGUMENTS: float a_fAlpha -> 0 for the state before the last step, 1 for the current one
 	OUTPUT: ---
 	*/
-	void UpdateCoins(float & dt);
+	void ApplySimulationState(float a_fAlpha);
+
+	/*
+	USAGE: Sets the model matrices of the obstacles or the coins, spread over the job system
+	ARGUMENTS:
+	-	MyGameLogic::Lane a_eLane -> obstacles or coins
+	-	float a_fAlpha -> 0 for the state before the last step, 1 for the current one
+	OUTPUT: ---
+	*/
+	void UpdateLaneMatrices(MyGameLogic::Lane a_eLane, float a_fAlpha);
 
 	/*
 	USAGE: Will update the positions of the player and check if the player have collide with any incoming obstacles
@@ -277,33 +324,12 @@ private:
 	*/
 	bool OptimizedCollisionDetection();
 
-	/*
-	USAGE: Create a random X value between the lanes
-	ARGUMENTS: ---
-	OUTPUT: float that will be a random x value between the min and max lane values
-	*/
-	float GenerateRandomLaneX();
-
-	/*
-	USAGE: Respawns the player
-	ARGUMENTS: ---
-	OUTPUT: ---
-	*/
-	void PlayerRespawn(void);
-
 	/*
 	USAGE: Sets the current game state, and does any necessary initializing
 	ARGUMENTS: ---
 	OUTPUT: ---
 	*/
 	void SetGameState(const GameState a_gameState);
-
-	/*
-	USAGE: Forces all obstacles to be respawned
-	ARGUMENTS: ---
-	OUTPUT: ---
-	*/
-	void ResetObstaclesAndCoins(void);
 #pragma endregion
 
 #pragma region Application Controls
@@ -417,6 +443,12 @@ private:
 	*/
 	void DrawGUI(void);
 	/*
+	USAGE: Draws the profiler window, a timeline of the last frame and the time of each zone
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void DrawProfiler(void);
+	/*
 	USAGE: //release gui
 	ARGUMENTS: ---
 	OUTPUT: ---
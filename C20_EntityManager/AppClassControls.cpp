@@ -142,6 +142,36 @@ void Application::ProcessKeyReleased(sf::Event a_event)
 		std::cout << "reverse the collision detection check!" << std::endl;
 		m_bRunOptimialCollision = !m_bRunOptimialCollision;
 		break;
+	case sf::Keyboard::Period:
+		// Cycle the broadphase the optimal collision uses
+		m_eBroadphase = static_cast<MyGameLogic::Broadphase>((m_eBroadphase + 1) % MyGameLogic::BroadphaseCount);
+		break;
+	case sf::Keyboard::P:
+		// Show or hide the profiler
+		m_bGUI_Profiler = !m_bGUI_Profiler;
+		break;
+	case sf::Keyboard::Slash:
+		// Switch between the fixed and the variable simulation step, no time carries over
+		m_bFixedTimestep = !m_bFixedTimestep;
+		m_FixedTimestep.Reset();
+		break;
+	case sf::Keyboard::J:
+		// Run the frame on the main thread alone or on every core, to compare them
+		m_bJobs = !m_bJobs;
+		MyJobSystem::GetInstance()->SetWorkerCount(m_bJobs ? m_uJobWorkers : 0);
+		break;
+	case sf::Keyboard::K:
+		// Simulate the next frame while this one renders or one after the other, to compare them
+		m_bPipeline = !m_bPipeline;
+		break;
+	case sf::Keyboard::C:
+		// Draw every entity or only the ones inside the camera, to compare them
+		m_pEntityMngr->SetFrustumCulling(!m_pEntityMngr->IsFrustumCulling());
+		break;
+	case sf::Keyboard::L:
+		// Draw the far entities with their simpler levels of detail or every one with its source model
+		m_pEntityMngr->SetLevelOfDetail(!m_pEntityMngr->IsLevelOfDetail());
+		break;
 	case sf::Keyboard::LShift:
 	case sf::Keyboard::RShift:
 		m_bModifier = false;
@@ -410,17 +440,20 @@ void Application::ProcessKeyboard(void)
 	// player movement
 	if (m_gameState == GameState::Playing)
 	{
+		// the steps of the frame push the player the way held, nothing held lets the push fade
+		float fDirection = 0.0f;
 		if (sf::Keyboard::isKeyPressed(sf::Keyboard::D)
 			|| sf::Keyboard::isKeyPressed(sf::Keyboard::Right)) // right 
-			m_fPlayerInputDirection += 1.0f;
+			fDirection += 1.0f;
 
 		if (sf::Keyboard::isKeyPressed(sf::Keyboard::A)
 			|| sf::Keyboard::isKeyPressed(sf::Keyboard::Left)) // left
-			m_fPlayerInputDirection -= 1.0f;
+			fDirection -= 1.0f;
+
+		m_pGameLogic->MovePlayer(fDirection);
 
-		if (sf::Keyboard::isKeyPressed(sf::Keyboard::Space)
-			&& m_bIsPlayerOnGround) // jump
-			m_v3PlayerVelo.y = m_fPlayerJumpVelo;
+		if (sf::Keyboard::isKeyPressed(sf::Keyboard::Space)) // jump, only from the ground
+			m_pGameLogic->JumpPlayer();
 	}
 	else if (sf::Keyboard::isKeyPressed(sf::Keyboard::Space)
 		&& m_gameState == GameState::GameOver) // restart game
@@ -125,7 +125,8 @@ void Application::DrawGUI(void)
 		m_pMeshMngr->PrintLine("");//Add a line on top
 
 	// show game over if game is over
-	if (m_gameState == GameState::GameOver)
+	RenderFrame const& frame = m_Frame[m_uFrontFrame];
+	if (frame.m_gameState == GameState::GameOver)
 	{
 		m_pMeshMngr->PrintLine("Game Over!", C_WHITE);
 		m_pMeshMngr->PrintLine("Press space to restart.", C_WHITE);
@@ -138,7 +139,7 @@ void Application::DrawGUI(void)
 	//m_pMeshMngr->Print("						");
 
 	m_pMeshMngr->Print("Score: ");//Add a line on top
-	m_pMeshMngr->PrintLine(std::to_string(score), C_WHITE);
+	m_pMeshMngr->PrintLine(std::to_string(frame.m_nScore), C_WHITE);
 
 	//m_pMeshMngr->Print("						");
 	m_pMeshMngr->Print("RenderCalls: ");//Add a line on top
@@ -171,6 +172,23 @@ void Application::DrawGUI(void)
 			ImGui::Text("	Space: Jump\n");
 			ImGui::Separator();
 			ImGui::TextColored(ImColor(255, 255, 0), "Entity Manager\n");
+			static const char* szBroadphase[] = { "Loose Octree", "Spatial Grid", "Sweep and Prune", "SIMD Scan" };
+			ImGui::Text("Broadphase: %s %s\n", m_bRunOptimialCollision ? szBroadphase[m_eBroadphase] : "Pairs",
+				m_bRunOptimialCollision ? "(. to cycle)" : "(, for optimal)");
+			if (m_bFixedTimestep)
+				ImGui::Text("Simulation: %.0f Hz, %u steps (/ for variable)\n",
+					1.0f / m_FixedTimestep.GetStep(), m_FixedTimestep.GetStepCount());
+			else
+				ImGui::Text("Simulation: variable %.2f ms (/ for fixed)\n", m_FixedTimestep.GetFrameTime() * 1000.0f);
+			ImGui::Text("Jobs: %u threads (J for %u)\n", MyJobSystem::GetInstance()->GetWorkerCount() + 1,
+				m_bJobs ? 1 : m_uJobWorkers + 1);
+			ImGui::Text("Pipeline: %s, frame %u shown (K for %s)\n", m_bPipeline ? "on" : "off",
+				frame.m_Snapshot.GetFrame(), m_bPipeline ? "serial" : "pipelined");
+			ImGui::Text("Culling: %u visible, %u culled (C to turn %s)\n", frame.m_Snapshot.GetVisibleCount(),
+				frame.m_Snapshot.GetCulledCount(), m_pEntityMngr->IsFrustumCulling() ? "off" : "on");
+			ImGui::Text("LOD: %u/%u/%u/%u models, %u triangles (L to turn %s)\n", frame.m_Snapshot.GetLevelCount(0),
+				frame.m_Snapshot.GetLevelCount(1), frame.m_Snapshot.GetLevelCount(2), frame.m_Snapshot.GetLevelCount(3),
+				frame.m_Snapshot.GetTriangleCount(), m_pEntityMngr->IsLevelOfDetail() ? "off" : "on");
 		}
 		ImGui::End();
 	}
@@ -248,6 +266,12 @@ void Application::DrawGUI(void)
 		}
 		ImGui::End();
 	}
+
+	//Profiler
+	if (m_bGUI_Profiler)
+	{
+		DrawProfiler();
+	}
 	
 	//Examples
 	if (m_bGUI_Test)
@@ -489,6 +513,106 @@ void Application::NewFrame()
 	// Start the frame
 	ImGui::NewFrame();
 }
+void Application::DrawProfiler(void)
+{
+#if MY_PROFILE
+	MyProfiler* pProfiler = MyProfiler::GetInstance();
+	ImGui::SetNextWindowPos(ImVec2(1, 300), ImGuiSetCond_FirstUseEver);
+	ImGui::SetNextWindowSize(ImVec2(640, 400), ImGuiSetCond_FirstUseEver);
+	String sWindowName = m_pSystem->GetAppName() + " - Profiler";
+	ImGui::Begin(sWindowName.c_str(), &m_bGUI_Profiler);
+
+	// Time of the frames kept, the newest on the right
+	static float fFrameTime[120];
+	for (uint i = 0; i < 120; ++i)
+	{
+		MyProfileFrame const* pFrame = pProfiler->GetFrame(119 - i);
+		fFrameTime[i] = pFrame ? (pFrame->m_nEnd - pFrame->m_nStart) / 1e6f : 0.0f;
+	}
+	ImGui::PlotHistogram("##FrameTime", fFrameTime, 120, 0, "Frame time [0 - 33 ms]", 0.0f, 33.3f, ImVec2(0, 60));
+
+	MyProfileFrame const* pFrame = pProfiler->GetFrame(0);
+	if (pFrame != nullptr)
+	{
+		double dFrame = (pFrame->m_nEnd - pFrame->m_nStart) / 1e6;
+		ImGui::Text("Frame %u: %.3f ms, %u zones, %u dropped", pProfiler->GetFrameCount(), dFrame,
+			static_cast<uint>(pFrame->m_lEvent.size()), pProfiler->GetDroppedCount());
+
+		// Timeline of the last frame, a band per thread and a row per nesting level in it
+		const float fRow = 18.0f;
+		uint uThreads = pProfiler->GetThreadCount();
+		std::vector<float> lBand(uThreads + 1, 0.0f);
+		std::vector<uint> lRows(uThreads, 1);
+		for (uint i = 0; i < pFrame->m_lEvent.size(); ++i)
+		{
+			MyProfileEvent const& event = pFrame->m_lEvent[i];
+			if (event.m_uThread < uThreads && event.m_uDepth + 1 > lRows[event.m_uThread])
+				lRows[event.m_uThread] = event.m_uDepth + 1;
+		}
+		for (uint t = 0; t < uThreads; ++t)
+			lBand[t + 1] = lBand[t] + lRows[t] * fRow + 4.0f;
+
+		ImVec2 v2Origin = ImGui::GetCursorScreenPos();
+		float fWidth = ImGui::GetContentRegionAvailWidth();
+		ImGui::InvisibleButton("##Timeline", ImVec2(fWidth, lBand[uThreads]));
+		ImDrawList* pDrawList = ImGui::GetWindowDrawList();
+		for (uint i = 0; i < pFrame->m_lEvent.size(); ++i)
+		{
+			MyProfileEvent const& event = pFrame->m_lEvent[i];
+			if (event.m_uThread >= uThreads)
+				continue;
+
+			// Zones of the workers can start before the frame did, they are clipped to it
+			float fStart = static_cast<float>((event.m_nStart - pFrame->m_nStart) / 1e6 / dFrame);
+			float fEnd = static_cast<float>((event.m_nEnd - pFrame->m_nStart) / 1e6 / dFrame);
+			ImVec2 v2Min(v2Origin.x + (glm::max)(fStart, 0.0f) * fWidth, v2Origin.y + lBand[event.m_uThread] + event.m_uDepth * fRow);
+			ImVec2 v2Max(v2Origin.x + (glm::min)(fEnd, 1.0f) * fWidth, v2Min.y + fRow - 1.0f);
+			if (v2Max.x < v2Min.x + 1.0f)
+				v2Max.x = v2Min.x + 1.0f;
+
+			// Same zone, same color
+			float fHue = static_cast<float>(std::hash<String>()(event.m_sName) % 360) / 360.0f;
+			pDrawList->AddRectFilled(v2Min, v2Max, ImColor::HSV(fHue, 0.5f, 0.7f));
+			pDrawList->PushClipRect(v2Min, v2Max, true);
+			pDrawList->AddText(ImVec2(v2Min.x + 2.0f, v2Min.y + 2.0f), ImColor(255, 255, 255), event.m_sName);
+			pDrawList->PopClipRect();
+
+			if (ImGui::IsMouseHoveringRect(v2Min, v2Max))
+				ImGui::SetTooltip("%s\n%s: %.3f ms", pProfiler->GetThreadName(event.m_uThread).c_str(),
+					event.m_sName, (event.m_nEnd - event.m_nStart) / 1e6);
+		}
+
+		// Time of each zone in the frame adding its calls on every thread, the nested zones included
+		std::vector<std::pair<double, std::pair<String, uint>>> lTotal;
+		for (uint i = 0; i < pFrame->m_lEvent.size(); ++i)
+		{
+			MyProfileEvent const& event = pFrame->m_lEvent[i];
+			uint j = 0;
+			while (j < lTotal.size() && lTotal[j].second.first != event.m_sName)
+				++j;
+			if (j == lTotal.size())
+				lTotal.push_back(std::make_pair(0.0, std::make_pair(String(event.m_sName), 0u)));
+			lTotal[j].first += (event.m_nEnd - event.m_nStart) / 1e6;
+			++lTotal[j].second.second;
+		}
+		std::sort(lTotal.begin(), lTotal.end(), [](std::pair<double, std::pair<String, uint>> const& a,
+			std::pair<double, std::pair<String, uint>> const& b) { return a.first > b.first; });
+		ImGui::Separator();
+		for (uint i = 0; i < lTotal.size(); ++i)
+			ImGui::Text("%8.3f ms %6u  %s", lTotal[i].first, lTotal[i].second.second, lTotal[i].second.first.c_str());
+	}
+
+	// The frames kept go to a file to open in chrome://tracing or Perfetto
+	static String sSaved = "";
+	ImGui::Separator();
+	if (ImGui::Button("Save Chrome Trace"))
+		sSaved = pProfiler->SaveChromeTrace("Profile.json") ? "Saved to Profile.json" : "Could not write Profile.json";
+	ImGui::SameLine();
+	ImGui::Text("%s", sSaved.c_str());
+
+	ImGui::End();
+#endif
+}
 void Application::InitIMGUI(void)
 {
 	ImGuiIO& io = ImGui::GetIO();
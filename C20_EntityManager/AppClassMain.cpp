@@ -158,6 +158,8 @@ void Application::Run(void)
 		ProcessJoystick();//Continuous events
 		Update();
 		Display();
+		// The next frame was simulated while this one was drawn, it is the one shown next
+		SwapFrame();
 	}
 
 	//Write configuration of this program
@@ -0,0 +1,289 @@
+// Runs the game without a window and prints what each run measured as JSON
+#include "MyHeadlessSim.h"
+#include "MyProfiler.h"
+#include "MyJobSystem.h"
+#include "MyLODBuilder.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#ifndef HEADLESS_MODEL_FOLDER
+#define HEADLESS_MODEL_FOLDER "../_Binary/Data/MOBJ/Minecraft/"
+#endif
+
+using namespace Simplex;
+
+namespace
+{
+	void PrintUsage(void)
+	{
+		std::cerr <<
+			"Usage: C20_Headless [options]\n"
+			"  --frames N        frames simulated by each run (1000)\n"
+			"  --seed N          seed of the lanes and the input (1)\n"
+			"  --obstacles A,B   obstacles of each run (100,1000,10000,100000)\n"
+			"  --coins N         coins of each run (10)\n"
+			"  --workers N       job threads besides the main one (every core but one)\n"
+			"  --broadphase B    all, LooseOctree, SpatialGrid, SweepAndPrune, PackedScan or Pairs (all)\n"
+			"  --models DIR      folder of the Minecraft models (" HEADLESS_MODEL_FOLDER ")\n"
+			"  --out FILE        write the JSON there instead of the standard output\n"
+			"  --trace FILE      save a Chrome trace of the last run\n"
+			"  --build-lod A,B   write the levels of detail of these models of the models folder and quit\n";
+	}
+	bool ReadUint(const char* a_sValue, uint& a_uOutput)
+	{
+		char* pEnd = nullptr;
+		unsigned long uValue = strtoul(a_sValue, &pEnd, 10);
+		if (pEnd == a_sValue || *pEnd != '\0')
+			return false;
+		a_uOutput = static_cast<uint>(uValue);
+		return true;
+	}
+	bool ReadUintList(const char* a_sValue, std::vector<uint>& a_lOutput)
+	{
+		a_lOutput.clear();
+		std::stringstream stream(a_sValue);
+		String sItem;
+		while (std::getline(stream, sItem, ','))
+		{
+			uint uValue = 0;
+			if (!ReadUint(sItem.c_str(), uValue))
+				return false;
+			a_lOutput.push_back(uValue);
+		}
+		return !a_lOutput.empty();
+	}
+	String Escape(String const& a_sInput)
+	{
+		String sOutput;
+		for (uint i = 0; i < a_sInput.size(); ++i)
+		{
+			if (a_sInput[i] == '"' || a_sInput[i] == '\\')
+				sOutput += '\\';
+			sOutput += a_sInput[i];
+		}
+		return sOutput;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	MyHeadlessSim::Config config;
+	config.m_sModelFolder = HEADLESS_MODEL_FOLDER;
+	std::vector<uint> lObstacles = { 100, 1000, 10000, 100000 };
+	std::vector<MyHeadlessSim::Broadphase> lBroadphase;
+	String sOut = "";
+	String sTrace = "";
+	int nWorkers = -1;
+	std::vector<String> lBuildLOD;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		String sOption = argv[i];
+		if (sOption == "--help" || sOption == "-h")
+		{
+			PrintUsage();
+			return 0;
+		}
+		if (i + 1 >= argc)
+		{
+			std::cerr << "Missing value for " << sOption << "\n";
+			PrintUsage();
+			return 1;
+		}
+		const char* sValue = argv[++i];
+		bool bRead = true;
+		if (sOption == "--frames")
+			bRead = ReadUint(sValue, config.m_uFrames);
+		else if (sOption == "--seed")
+			bRead = ReadUint(sValue, config.m_uSeed);
+		else if (sOption == "--obstacles")
+			bRead = ReadUintList(sValue, lObstacles);
+		else if (sOption == "--coins")
+			bRead = ReadUint(sValue, config.m_uCoins);
+		else if (sOption == "--workers")
+		{
+			uint uWorkers = 0;
+			bRead = ReadUint(sValue, uWorkers);
+			nWorkers = static_cast<int>(uWorkers);
+		}
+		else if (sOption == "--models")
+			config.m_sModelFolder = sValue;
+		else if (sOption == "--out")
+			sOut = sValue;
+		else if (sOption == "--trace")
+			sTrace = sValue;
+		else if (sOption == "--build-lod")
+		{
+			std::stringstream stream(sValue);
+			String sItem;
+			while (std::getline(stream, sItem, ','))
+				lBuildLOD.push_back(sItem);
+			bRead = !lBuildLOD.empty();
+		}
+		else if (sOption == "--broadphase")
+		{
+			bRead = strcmp(sValue, "all") == 0;
+			for (uint b = 0; b < MyHeadlessSim::BroadphaseCount; ++b)
+			{
+				MyHeadlessSim::Broadphase eBroadphase = static_cast<MyHeadlessSim::Broadphase>(b);
+				if (MyHeadlessSim::GetBroadphaseName(eBroadphase) == sValue)
+				{
+					lBroadphase.push_back(eBroadphase);
+					bRead = true;
+				}
+			}
+		}
+		else
+		{
+			std::cerr << "Unknown option " << sOption << "\n";
+			PrintUsage();
+			return 1;
+		}
+		if (!bRead)
+		{
+			std::cerr << "Bad value for " << sOption << ": " << sValue << "\n";
+			return 1;
+		}
+	}
+	if (lBroadphase.empty())
+	{
+		for (uint b = 0; b < MyHeadlessSim::BroadphaseCount; ++b)
+			lBroadphase.push_back(static_cast<MyHeadlessSim::Broadphase>(b));
+	}
+	String& sFolder = config.m_sModelFolder;
+	if (!sFolder.empty() && sFolder.back() != '/' && sFolder.back() != '\\')
+		sFolder += '/';
+
+	// the game only loads the levels on disk, this is the step that writes them
+	if (!lBuildLOD.empty())
+	{
+		int nResult = 0;
+		for (uint m = 0; m < lBuildLOD.size(); ++m)
+		{
+			std::ifstream source((sFolder + lBuildLOD[m]).c_str());
+			if (!source.is_open())
+			{
+				std::cerr << "Could not read " << sFolder + lBuildLOD[m] << "\n";
+				nResult = 1;
+				continue;
+			}
+			std::cerr << lBuildLOD[m] << ": " << MyLODBuilder::BuildFiles(sFolder, lBuildLOD[m]) << " levels of detail\n";
+		}
+		return nResult;
+	}
+	if (config.m_uFrames == 0)
+	{
+		std::cerr << "Nothing to run with 0 frames\n";
+		return 1;
+	}
+
+	MY_PROFILE_THREAD("Main");
+	MyJobSystem* pJobs = MyJobSystem::GetInstance();
+	if (nWorkers >= 0)
+		pJobs->SetWorkerCount(static_cast<uint>(nWorkers));
+
+	std::ostringstream json;
+	json.precision(6);
+	json << std::fixed;
+	json << "{\n";
+	json << "  \"config\": { \"frames\": " << config.m_uFrames << ", \"seed\": " << config.m_uSeed
+		<< ", \"coins\": " << config.m_uCoins << ", \"workers\": " << pJobs->GetWorkerCount() << ", \"step\": " << config.m_fStep
+		<< ", \"models\": \"" << Escape(config.m_sModelFolder) << "\" },\n";
+
+	// levels of detail --build-lod writes next to the models, built in memory here so nothing is written
+	String sLODModel[3] = { "Pig.obj", "Cow.obj", "Coin.obj" };
+	json << "  \"lod\": {";
+	for (uint m = 0; m < 3; ++m)
+	{
+		MyLODBuilder builder;
+		auto start = std::chrono::steady_clock::now();
+		bool bRead = builder.Read(config.m_sModelFolder + sLODModel[m]);
+		if (bRead)
+			builder.Build();
+		std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+		json << (m == 0 ? "\n" : ",\n");
+		json << "    \"" << sLODModel[m] << "\": { \"triangles\": [";
+		for (uint l = 0; bRead && l < builder.GetLevelCount(); ++l)
+			json << (l == 0 ? "" : ", ") << builder.GetTriangleCount(l);
+		json << "], \"build_ms\": " << elapsed.count() << " }";
+	}
+	json << "\n  },\n";
+	json << "  \"runs\": [";
+
+	bool bFirst = true;
+	for (uint o = 0; o < lObstacles.size(); ++o)
+	{
+		for (uint b = 0; b < lBroadphase.size(); ++b)
+		{
+			config.m_uObstacles = lObstacles[o];
+			config.m_eBroadphase = lBroadphase[b];
+			std::cerr << MyHeadlessSim::GetBroadphaseName(config.m_eBroadphase) << " with "
+				<< config.m_uObstacles << " obstacles... ";
+
+			MyHeadlessSim::Result result;
+			{
+				MyHeadlessSim sim(config);
+				result = sim.Run();
+			}
+
+			double dPerFrame = result.m_dTotal / result.m_uFrames;
+			double dSeconds = result.m_dTotal / 1000.0;
+			std::cerr << dPerFrame << " ms a frame\n";
+
+			json << (bFirst ? "\n" : ",\n");
+			bFirst = false;
+			json << "    {\n";
+			json << "      \"broadphase\": \"" << MyHeadlessSim::GetBroadphaseName(config.m_eBroadphase) << "\",\n";
+			json << "      \"obstacles\": " << config.m_uObstacles << ",\n";
+			json << "      \"entities\": " << result.m_uEntities << ",\n";
+			json << "      \"frames\": " << result.m_uFrames << ",\n";
+			json << "      \"total_ms\": " << result.m_dTotal << ",\n";
+			json << "      \"ms_per_frame\": " << dPerFrame << ",\n";
+			json << "      \"max_frame_ms\": " << result.m_dFrameMax << ",\n";
+			json << "      \"frames_per_second\": " << (dSeconds > 0.0 ? result.m_uFrames / dSeconds : 0.0) << ",\n";
+			json << "      \"entity_updates_per_second\": "
+				<< (dSeconds > 0.0 ? static_cast<double>(result.m_uEntities) * result.m_uFrames / dSeconds : 0.0) << ",\n";
+			json << "      \"phases\": {";
+			for (uint p = 0; p < MyHeadlessSim::PhaseCount; ++p)
+			{
+				json << (p == 0 ? "\n" : ",\n");
+				json << "        \"" << MyHeadlessSim::GetPhaseName(static_cast<MyHeadlessSim::Phase>(p)) << "\": { "
+					<< "\"total_ms\": " << result.m_dPhase[p]
+					<< ", \"mean_ms\": " << result.m_dPhase[p] / result.m_uFrames
+					<< ", \"max_ms\": " << result.m_dPhaseMax[p] << " }";
+			}
+			json << "\n      },\n";
+			json << "      \"candidates\": " << result.m_uCandidates << ",\n";
+			json << "      \"collision_frames\": " << result.m_uCollisionFrames << ",\n";
+			json << "      \"game_overs\": " << result.m_uGameOvers << ",\n";
+			json << "      \"models_loaded\": " << (result.m_bModels ? "true" : "false") << "\n";
+			json << "    }";
+		}
+	}
+	json << "\n  ]\n}\n";
+
+	if (sTrace != "" && !MyProfiler::GetInstance()->SaveChromeTrace(sTrace))
+		std::cerr << "Could not write " << sTrace << "\n";
+	MyJobSystem::ReleaseInstance();
+	MyProfiler::ReleaseInstance();
+
+	if (sOut == "")
+	{
+		std::cout << json.str();
+		return 0;
+	}
+	std::ofstream file(sOut.c_str());
+	if (!file.is_open())
+	{
+		std::cerr << "Could not write " << sOut << "\n";
+		return 1;
+	}
+	file << json.str();
+	return 0;
+}
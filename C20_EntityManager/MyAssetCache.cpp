@@ -0,0 +1,307 @@
+#include "MyAssetCache.h"
+#include "MyProfiler.h"
+#include "MyLODBuilder.h"
+#include "MyJobSystem.h"
+#include <chrono>
+#include <fstream>
+using namespace Simplex;
+//  MyAssetCache
+MyAssetCache* MyAssetCache::m_pInstance = nullptr;
+void MyAssetCache::Init(void)
+{
+	m_mAssetMap.clear();
+	m_mPendingMap.clear();
+}
+void MyAssetCache::Release(void)
+{
+	//the reads cannot be cancelled, wait for them before dropping the requests
+	for (auto it = m_mPendingMap.begin(); it != m_mPendingMap.end(); ++it)
+	{
+		MyJobSystem::GetInstance()->Wait(it->second->m_Read);
+		it->second->m_Loaded.set_value(nullptr);
+		SafeDelete(it->second);
+	}
+	m_mPendingMap.clear();
+
+	for (auto it = m_mAssetMap.begin(); it != m_mAssetMap.end(); ++it)
+	{
+		DeleteAsset(it->second);
+	}
+	m_mAssetMap.clear();
+}
+MyAssetCache* MyAssetCache::GetInstance()
+{
+	if (m_pInstance == nullptr)
+	{
+		m_pInstance = new MyAssetCache();
+	}
+	return m_pInstance;
+}
+void MyAssetCache::ReleaseInstance()
+{
+	if (m_pInstance != nullptr)
+	{
+		delete m_pInstance;
+		m_pInstance = nullptr;
+	}
+}
+//The big 3
+MyAssetCache::MyAssetCache() { Init(); }
+MyAssetCache::MyAssetCache(MyAssetCache const& other) { }
+MyAssetCache& MyAssetCache::operator=(MyAssetCache const& other) { return *this; }
+MyAssetCache::~MyAssetCache() { Release(); };
+// other methods
+ModelAsset const* Simplex::MyAssetCache::Acquire(String a_sFileName)
+{
+	//if it was already loaded just add the reference
+	auto asset = m_mAssetMap.find(a_sFileName);
+	ModelAsset* pAsset = asset != m_mAssetMap.end() ? asset->second : nullptr;
+
+	//first time we see this file, load it now, finishing the request if there was one
+	if (pAsset == nullptr)
+	{
+		if (m_mPendingMap.count(a_sFileName) > 0)
+			pAsset = Complete(a_sFileName);
+		else
+		{
+			//not requested, everything is read here
+			ModelFiles files;
+			ReadModelFiles(a_sFileName, files);
+			pAsset = Load(a_sFileName, files);
+		}
+	}
+	if (pAsset == nullptr)
+		return nullptr;
+
+	++pAsset->m_uReferences;
+	return pAsset;
+}
+std::shared_future<ModelAsset const*> Simplex::MyAssetCache::Request(String a_sFileName)
+{
+	//already asked for
+	auto pending = m_mPendingMap.find(a_sFileName);
+	if (pending != m_mPendingMap.end())
+		return pending->second->m_Asset;
+
+	PendingAsset* pPending = new PendingAsset();
+	pPending->m_Asset = pPending->m_Loaded.get_future().share();
+
+	//already loaded, nothing to read
+	auto asset = m_mAssetMap.find(a_sFileName);
+	if (asset != m_mAssetMap.end())
+	{
+		pPending->m_Loaded.set_value(asset->second);
+		std::shared_future<ModelAsset const*> loaded = pPending->m_Asset;
+		SafeDelete(pPending);
+		return loaded;
+	}
+
+	//the request is not freed before the job is done, the job can write to it
+	pPending->m_Read = MyJobSystem::GetInstance()->RunBackground([pPending, a_sFileName]()
+	{
+		ReadModelFiles(a_sFileName, pPending->m_Files);
+	});
+	m_mPendingMap[a_sFileName] = pPending;
+	return pPending->m_Asset;
+}
+uint Simplex::MyAssetCache::Update(float a_fBudget)
+{
+	auto start = std::chrono::steady_clock::now();
+	uint uLoaded = 0;
+	while (!m_mPendingMap.empty())
+	{
+		//the first request whose files are already in memory
+		auto pending = m_mPendingMap.begin();
+		while (pending != m_mPendingMap.end() &&
+			pending->second->m_Read.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+			++pending;
+		//without workers no job runs until someone waits on it, Complete does
+		if (pending == m_mPendingMap.end() && MyJobSystem::GetInstance()->GetWorkerCount() == 0 && uLoaded == 0)
+			pending = m_mPendingMap.begin();
+		if (pending == m_mPendingMap.end())
+			break;
+
+		Complete(pending->first);
+		++uLoaded;
+
+		std::chrono::duration<float, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+		if (elapsed.count() >= a_fBudget)
+			break;
+	}
+	return uLoaded;
+}
+uint Simplex::MyAssetCache::GetPendingCount(void) { return m_mPendingMap.size(); }
+ModelAsset* Simplex::MyAssetCache::Load(String a_sFileName, ModelFiles const& a_Files)
+{
+	Model* pModel = new Model();
+	pModel->Load(a_sFileName);
+	//if the model could not be loaded there is nothing to cache
+	if (pModel->GetName() == "")
+	{
+		SafeDelete(pModel);
+		return nullptr;
+	}
+
+	ModelAsset* pAsset = new ModelAsset();
+	pAsset->m_sFileName = a_sFileName;
+	pAsset->m_pModel = pModel;
+	//entities copy this rigid body; the points were picked from the vertices when the files were read,
+	//the vertices of the model are only scanned if the source could not be read then
+	pAsset->m_pRigidBody = new RigidBody(a_Files.m_bRead ? a_Files.m_lBoundingPoint : pModel->GetVertexList());
+	pAsset->m_v3MinLocal = pAsset->m_pRigidBody->GetMinLocal();
+	pAsset->m_v3MaxLocal = pAsset->m_pRigidBody->GetMaxLocal();
+	pAsset->m_v3CenterLocal = pAsset->m_pRigidBody->GetCenterLocal();
+	pAsset->m_v3HalfWidth = pAsset->m_pRigidBody->GetHalfWidth();
+	pAsset->m_fRadius = pAsset->m_pRigidBody->GetRadius();
+	pAsset->m_uReferences = 0;
+
+	//the meshes are drawn as triangle lists, three vertices each
+	pAsset->m_lLODModel.push_back(pModel);
+	pAsset->m_lLODTriangles.push_back(a_Files.m_bRead ? a_Files.m_lLODTriangles[0] :
+		static_cast<uint>(pModel->GetVertexList().size() / 3));
+	for (uint l = 1; l < a_Files.m_lLODTriangles.size(); ++l)
+	{
+		Model* pLevel = new Model();
+		pLevel->Load(MyLODBuilder::GetLevelFileName(a_sFileName, l));
+		if (pLevel->GetName() == "")
+		{
+			SafeDelete(pLevel);
+			break;
+		}
+		pAsset->m_lLODModel.push_back(pLevel);
+		pAsset->m_lLODTriangles.push_back(a_Files.m_lLODTriangles[l]);
+	}
+
+	m_mAssetMap[a_sFileName] = pAsset;
+	return pAsset;
+}
+ModelAsset* Simplex::MyAssetCache::Complete(String a_sFileName)
+{
+	MY_PROFILE_FUNCTION();
+	auto pending = m_mPendingMap.find(a_sFileName);
+	if (pending == m_mPendingMap.end())
+		return nullptr;
+
+	PendingAsset* pPending = pending->second;
+	m_mPendingMap.erase(pending);
+
+	//Model::Load parses and uploads in one go, so only what is around it could be moved off this thread
+	MyJobSystem::GetInstance()->Wait(pPending->m_Read);
+	ModelAsset* pAsset = Load(a_sFileName, pPending->m_Files);
+	pPending->m_Loaded.set_value(pAsset);
+	SafeDelete(pPending);
+	return pAsset;
+}
+void Simplex::MyAssetCache::ReadModelFiles(String a_sFileName, ModelFiles& a_Files)
+{
+	MY_PROFILE_FUNCTION();
+
+	//same folders the loader looks in
+	Folder* pFolder = SystemSingleton::GetInstance()->m_pFolder;
+	String sData = pFolder->GetFolderRoot() + pFolder->GetFolderData();
+	String sMOBJ = sData + pFolder->GetFolderMOBJ();
+	size_t uDot = a_sFileName.find_last_of('.');
+	String sBase = uDot == String::npos ? a_sFileName : a_sFileName.substr(0, uDot);
+
+	MyLODBuilder source;
+	a_Files.m_bRead = source.Read(sMOBJ + a_sFileName);
+	if (a_Files.m_bRead)
+	{
+		std::vector<vector3> lPosition;
+		source.GetUsedPositions(lPosition);
+		vector3 v3Min = lPosition[0];
+		vector3 v3Max = lPosition[0];
+		for (uint i = 1; i < lPosition.size(); ++i)
+		{
+			v3Min = (glm::min)(v3Min, lPosition[i]);
+			v3Max = (glm::max)(v3Max, lPosition[i]);
+		}
+		vector3 v3Center = (v3Min + v3Max) * 0.5f;
+		uint uFarthest = 0;
+		for (uint i = 1; i < lPosition.size(); ++i)
+		{
+			if (glm::distance(v3Center, lPosition[i]) > glm::distance(v3Center, lPosition[uFarthest]))
+				uFarthest = i;
+		}
+
+		//the middle of each face of the box is no further from the center than the vertex touching that
+		//face, with the farthest vertex they make the same box and sphere as all of the vertices
+		a_Files.m_lBoundingPoint.clear();
+		for (uint a = 0; a < 3; ++a)
+		{
+			vector3 v3Point = v3Center;
+			v3Point[a] = v3Min[a];
+			a_Files.m_lBoundingPoint.push_back(v3Point);
+			v3Point[a] = v3Max[a];
+			a_Files.m_lBoundingPoint.push_back(v3Point);
+		}
+		a_Files.m_lBoundingPoint.push_back(lPosition[uFarthest]);
+
+		//the levels were written by C20_Headless --build-lod, the ones older than the source are left out
+		a_Files.m_lLODTriangles.push_back(source.GetTriangleCount(0));
+		uint uLevels = MyLODBuilder::CountFiles(sMOBJ, a_sFileName);
+		for (uint l = 1; l <= uLevels; ++l)
+		{
+			MyLODBuilder level;
+			if (!level.Read(sMOBJ + MyLODBuilder::GetLevelFileName(a_sFileName, l)))
+				break;
+			a_Files.m_lLODTriangles.push_back(level.GetTriangleCount(0));
+		}
+	}
+
+	//the loader parses these itself, reading them here only puts them in the file cache of the system
+	String sFile[2] = {
+		sMOBJ + sBase + ".mtl",
+		sData + pFolder->GetFolderMBTO() + sBase + ".bto" };
+	std::vector<char> lBlock(1 << 20);
+	for (uint i = 0; i < 2; ++i)
+	{
+		std::ifstream file(sFile[i].c_str(), std::ios::binary);
+		while (file.read(lBlock.data(), lBlock.size()))
+		{
+		}
+	}
+}
+void Simplex::MyAssetCache::ReleaseAsset(ModelAsset const* a_pAsset)
+{
+	if (a_pAsset == nullptr)
+		return;
+
+	auto asset = m_mAssetMap.find(a_pAsset->m_sFileName);
+	//if it is not ours there is nothing to do
+	if (asset == m_mAssetMap.end() || asset->second != a_pAsset)
+		return;
+
+	//drop the asset with the last reference
+	if (--asset->second->m_uReferences == 0)
+	{
+		DeleteAsset(asset->second);
+		m_mAssetMap.erase(asset);
+	}
+}
+ModelAsset const* Simplex::MyAssetCache::GetAsset(String a_sFileName)
+{
+	auto asset = m_mAssetMap.find(a_sFileName);
+	//if not found return nullptr, if found return it
+	return asset == m_mAssetMap.end() ? nullptr : asset->second;
+}
+uint Simplex::MyAssetCache::GetReferenceCount(String a_sFileName)
+{
+	auto asset = m_mAssetMap.find(a_sFileName);
+	return asset == m_mAssetMap.end() ? 0 : asset->second->m_uReferences;
+}
+uint Simplex::MyAssetCache::GetAssetCount(void) { return m_mAssetMap.size(); }
+void Simplex::MyAssetCache::DeleteAsset(ModelAsset* a_pAsset)
+{
+	if (a_pAsset == nullptr)
+		return;
+
+	//the mesh manager does not own the models, they were loaded for the asset alone; the first
+	//level is the source model
+	for (uint l = 0; l < a_pAsset->m_lLODModel.size(); ++l)
+		SafeDelete(a_pAsset->m_lLODModel[l]);
+	a_pAsset->m_lLODModel.clear();
+	a_pAsset->m_pModel = nullptr;
+	SafeDelete(a_pAsset->m_pRigidBody);
+	SafeDelete(a_pAsset);
+}
@@ -0,0 +1,202 @@
+/*----------------------------------------------
+Programmer: Team "No Name"
+Date: 2018/04
+----------------------------------------------*/
+#ifndef __MYASSETCACHE_H_
+#define __MYASSETCACHE_H_
+
+#include "Simplex\Simplex.h"
+#include "MyDefinitions.h"
+#include <unordered_map>
+#include <future>
+
+namespace Simplex
+{
+
+//Immutable data shared by every entity created from the same file
+struct ModelAsset
+{
+	String m_sFileName = ""; //file the asset was loaded from, key in the cache
+	Model* m_pModel = nullptr; //source model, entities draw it instead of loading the file again
+	RigidBody* m_pRigidBody = nullptr; //prototype rigid body, entities copy it instead of scanning the vertices
+	std::vector<Model*> m_lLODModel; //levels of detail, the source model first, simpler ones found on disk after
+	std::vector<uint> m_lLODTriangles; //triangles of every level of detail
+
+	vector3 m_v3MinLocal = ZERO_V3; //min corner of the model space bounding box
+	vector3 m_v3MaxLocal = ZERO_V3; //max corner of the model space bounding box
+	vector3 m_v3CenterLocal = ZERO_V3; //center of the model space bounding box
+	vector3 m_v3HalfWidth = ZERO_V3; //half extents of the model space bounding box
+	float m_fRadius = 0.0f; //radius of the model space bounding sphere
+
+	uint m_uReferences = 0; //number of holders of this asset
+};
+
+//What is read of the files of a model before it is loaded: all but the meshes, which only Model::Load reads
+struct ModelFiles
+{
+	bool m_bRead = false; //could the source be read? If not the load scans the vertices of the model
+	std::vector<vector3> m_lBoundingPoint; //a few of the vertices with the same bounding box and sphere as all of them
+	std::vector<uint> m_lLODTriangles; //triangles of the source and of every level of detail up to date on disk
+};
+
+//Asset asked for ahead of time. A job reads and parses its files on a worker, but Model::Load of the
+//prebuilt library parses the meshes and uploads them to OpenGL in one call, so the models themselves
+//are still loaded on the main thread; only what is around them is done ahead
+struct PendingAsset
+{
+	ModelFiles m_Files; //written by the job until m_Read is ready
+	std::shared_future<void> m_Read; //background job of the job system reading the files
+	std::promise<ModelAsset const*> m_Loaded; //set once the asset is in the cache
+	std::shared_future<ModelAsset const*> m_Asset; //handed out to whoever asked for it
+};
+
+//System Class
+class MyAssetCache
+{
+	static MyAssetCache* m_pInstance; // Singleton pointer
+	std::unordered_map<String, ModelAsset*> m_mAssetMap; //file name to loaded asset
+	std::unordered_map<String, PendingAsset*> m_mPendingMap; //file name to asset being read
+public:
+	/*
+	Usage: Gets the singleton pointer
+	Arguments: ---
+	Output: singleton pointer
+	*/
+	static MyAssetCache* GetInstance();
+	/*
+	Usage: Releases the content of the singleton
+	Arguments: ---
+	Output: ---
+	*/
+	static void ReleaseInstance(void);
+	/*
+	USAGE: Gets the asset of the file adding a reference to it, the file is only loaded the first time
+	ARGUMENTS: String a_sFileName -> Name of the model to load
+	OUTPUT: shared asset, nullptr if the file could not be loaded
+	*/
+	ModelAsset const* Acquire(String a_sFileName);
+	/*
+	USAGE: Reads the files of the model ahead on a worker of the job system, so a later Acquire does not
+	wait on the disk or scan the model; the model itself is loaded by Update, Model::Load needs the
+	OpenGL context. Does not add a reference
+	ARGUMENTS: String a_sFileName -> Name of the model to load
+	OUTPUT: set to the asset once it is in the cache, nullptr if the file could not be loaded
+	*/
+	std::shared_future<ModelAsset const*> Request(String a_sFileName);
+	/*
+	USAGE: Loads the requested models whose files have been read, call once a frame from the main
+	thread; without workers it reads and loads one a call so requests always advance
+	ARGUMENTS: float a_fBudget -> milliseconds it can take
+	OUTPUT: number of models loaded
+	*/
+	uint Update(float a_fBudget);
+	/*
+	USAGE: Gets the number of requested models that are not in the cache yet
+	ARGUMENTS: ---
+	OUTPUT: number of pending models
+	*/
+	uint GetPendingCount(void);
+	/*
+	USAGE: Removes a reference from the asset, the asset is dropped from the cache with the last one
+	ARGUMENTS: ModelAsset const* a_pAsset -> asset previously acquired
+	OUTPUT: ---
+	*/
+	void ReleaseAsset(ModelAsset const* a_pAsset);
+	/*
+	USAGE: Gets the asset of the file without adding a reference
+	ARGUMENTS: String a_sFileName -> Name of the model
+	OUTPUT: asset, nullptr if the file is not in the cache
+	*/
+	ModelAsset const* GetAsset(String a_sFileName);
+	/*
+	USAGE: Gets the number of references to the asset of the file
+	ARGUMENTS: String a_sFileName -> Name of the model
+	OUTPUT: number of references, 0 if the file is not in the cache
+	*/
+	uint GetReferenceCount(String a_sFileName);
+	/*
+	USAGE: Gets the number of assets in the cache
+	ARGUMENTS: ---
+	OUTPUT: number of assets
+	*/
+	uint GetAssetCount(void);
+
+private:
+	/*
+	Usage: constructor
+	Arguments: ---
+	Output: class object instance
+	*/
+	MyAssetCache(void);
+	/*
+	Usage: copy constructor
+	Arguments: class object to copy
+	Output: class object instance
+	*/
+	MyAssetCache(MyAssetCache const& other);
+	/*
+	Usage: copy assignment operator
+	Arguments: class object to copy
+	Output: ---
+	*/
+	MyAssetCache& operator=(MyAssetCache const& other);
+	/*
+	Usage: destructor
+	Arguments: ---
+	Output: ---
+	*/
+	~MyAssetCache(void);
+	/*
+	Usage: releases the allocated member pointers
+	Arguments: ---
+	Output: ---
+	*/
+	void Release(void);
+	/*
+	Usage: initializes the singleton
+	Arguments: ---
+	Output: ---
+	*/
+	void Init(void);
+	/*
+	USAGE: Frees the data owned by the asset
+	ARGUMENTS: ModelAsset* a_pAsset -> asset to free
+	OUTPUT: ---
+	*/
+	void DeleteAsset(ModelAsset* a_pAsset);
+	/*
+	USAGE: Loads the model of the file and adds its asset to the cache without references, with the
+	levels of detail already on disk; it does not build missing ones
+	ARGUMENTS:
+	-	String a_sFileName -> Name of the model to load
+	-	ModelFiles const& a_Files -> what was read of its files
+	OUTPUT: asset, nullptr if the file could not be loaded
+	*/
+	ModelAsset* Load(String a_sFileName, ModelFiles const& a_Files);
+	/*
+	USAGE: Finishes a requested model, waiting for its files if they are still being read
+	ARGUMENTS: String a_sFileName -> Name of the requested model
+	OUTPUT: asset, nullptr if the file could not be loaded
+	*/
+	ModelAsset* Complete(String a_sFileName);
+	/*
+	USAGE: Parses the source of a model and its levels of detail on disk for their bounds and triangles,
+	and reads its material library and binary twin into the file cache of the system; safe on any
+	thread, it writes nothing
+	ARGUMENTS:
+	-	String a_sFileName -> Name of the model
+	-	ModelFiles& a_Files -> what was read
+	OUTPUT: ---
+	*/
+	static void ReadModelFiles(String a_sFileName, ModelFiles& a_Files);
+};//class
+
+} //namespace Simplex
+
+#endif //__MYASSETCACHE_H_
+
+/*
+USAGE:
+ARGUMENTS: ---
+OUTPUT: ---
+*/
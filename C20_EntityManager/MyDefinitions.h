@@ -0,0 +1,89 @@
+/*----------------------------------------------
+Programmer: Team "No Name"
+Date: 2018/04
+----------------------------------------------*/
+#ifndef __MYDEFINITIONS_H_
+#define __MYDEFINITIONS_H_
+
+// Platform free subset of the Simplex definitions, only depends on the STL and glm
+// so the game core (entity store, broadphase) can be compiled without the framework
+#include <vector>
+#include <string>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+namespace Simplex
+{
+	typedef unsigned int uint;
+	typedef std::string String;
+	typedef glm::vec2 vector2;
+	typedef glm::vec3 vector3;
+	typedef glm::vec4 vector4;
+	typedef glm::mat3 matrix3;
+	typedef glm::mat4 matrix4;
+	typedef glm::quat quaternion;
+
+	enum EntityLayer
+	{
+		None,
+		Player,
+		Obstacle,
+		Coin
+	};
+	static const uint ENTITY_LAYER_COUNT = 4; //number of values in EntityLayer
+	static const uint LOD_LEVEL_COUNT = 4; //levels of detail a model can have, the source included
+
+	//Symmetric table of which layers are tested against which, one bit per pair of layers
+	struct EntityLayerFilter
+	{
+		uint m_uMask[ENTITY_LAYER_COUNT]; //bit b of entry a is set if layer a collides with layer b
+
+		EntityLayerFilter(bool a_bAll = true)
+		{
+			for (uint i = 0; i < ENTITY_LAYER_COUNT; ++i)
+				m_uMask[i] = a_bAll ? (1u << ENTITY_LAYER_COUNT) - 1 : 0u;
+		}
+		void Set(EntityLayer a_eA, EntityLayer a_eB, bool a_bCollide = true)
+		{
+			if (a_bCollide)
+			{
+				m_uMask[a_eA] |= 1u << a_eB;
+				m_uMask[a_eB] |= 1u << a_eA;
+			}
+			else
+			{
+				m_uMask[a_eA] &= ~(1u << a_eB);
+				m_uMask[a_eB] &= ~(1u << a_eA);
+			}
+		}
+		bool Test(EntityLayer a_eA, EntityLayer a_eB) const { return (m_uMask[a_eA] >> a_eB) & 1u; }
+	};
+
+	//Generational reference to an entity, stays valid through swaps in the dense lists
+	//and goes stale (instead of aliasing another entity) once the entity is removed
+	struct EntityHandle
+	{
+		uint m_uSlot = static_cast<uint>(-1); //slot in the manager's handle table
+		uint m_uGeneration = 0; //generation of the slot when the handle was given out
+
+		bool IsValid(void) const { return m_uSlot != static_cast<uint>(-1); }
+		bool operator==(EntityHandle const& other) const { return m_uSlot == other.m_uSlot && m_uGeneration == other.m_uGeneration; }
+		bool operator!=(EntityHandle const& other) const { return !(*this == other); }
+	};
+} //namespace Simplex
+
+#ifndef IDENTITY_M4
+#define IDENTITY_M4 matrix4(1.0f)
+#endif
+#ifndef ZERO_V3
+#define ZERO_V3 vector3(0.0f, 0.0f, 0.0f)
+#endif
+
+// width of "lane", bounds for player horizontal movement and object spawning
+#define LANE_X_MAX 3.5f
+#define LANE_X_MIN -LANE_X_MAX
+#define OBSTACLE_Z_MAX 5.0f
+#define OBSTACLE_Z_START -50.0f
+
+#endif //__MYDEFINITIONS_H_
@@ -1,6 +1,6 @@
 #include "MyEntity.h"
 using namespace Simplex;
-std::map<String, MyEntity*> MyEntity::m_IDMap;
+std::unordered_map<String, MyEntity*> MyEntity::m_IDMap;
 //  Accessors
 matrix4 Simplex::MyEntity::GetModelMatrix(void){ return m_m4ToWorld; }
 void Simplex::MyEntity::SetModelMatrix(matrix4 a_m4ToWorld)
@@ -9,11 +9,11 @@ void Simplex::MyEntity::SetModelMatrix(matrix4 a_m4ToWorld)
 		return;
 
 	m_m4ToWorld = a_m4ToWorld;
-	m_pModel->SetModelMatrix(m_m4ToWorld);
 	m_pRigidBody->SetModelMatrix(m_m4ToWorld);
 }
 Model* Simplex::MyEntity::GetModel(void){return m_pModel;}
 RigidBody* Simplex::MyEntity::GetRigidBody(void){	return m_pRigidBody; }
+ModelAsset const* Simplex::MyEntity::GetAsset(void) { return m_pAsset; }
 bool Simplex::MyEntity::IsInitialized(void){ return m_bInMemory; }
 String Simplex::MyEntity::GetUniqueID(void) { return m_sUniqueID; }
 void Simplex::MyEntity::SetAxisVisible(bool a_bSetAxis) { m_bSetAxis = a_bSetAxis; }
@@ -31,6 +31,7 @@ void Simplex::MyEntity::Init(void)
 	m_pMeshMngr = MeshManager::GetInstance();
 	m_bInMemory = false;
 	m_bSetAxis = false;
+	m_pAsset = nullptr;
 	m_pModel = nullptr;
 	m_pRigidBody = nullptr;
 	m_m4ToWorld = IDENTITY_M4;
@@ -39,6 +40,7 @@ void Simplex::MyEntity::Init(void)
 void Simplex::MyEntity::Swap(MyEntity& other)
 {
 	m_bInMemory = false;
+	std::swap(m_pAsset, other.m_pAsset);
 	std::swap(m_pModel, other.m_pModel);
 	std::swap(m_pRigidBody, other.m_pRigidBody);
 	std::swap(m_m4ToWorld, other.m_m4ToWorld);
@@ -50,34 +52,43 @@ void Simplex::MyEntity::Swap(MyEntity& other)
 void Simplex::MyEntity::Release(void)
 {
 	m_pMeshMngr = nullptr;
-	//it is not the job of the entity to release the model, 
-	//it is for the mesh manager to do so.
-	m_pModel = nullptr; 
+	//the model belongs to the asset, the cache deletes it once no entity holds the asset
+	m_pModel = nullptr;
 	SafeDelete(m_pRigidBody);
+	//give the shared asset back to the cache
+	if (m_pAsset)
+	{
+		MyAssetCache::GetInstance()->ReleaseAsset(m_pAsset);
+		m_pAsset = nullptr;
+	}
 	m_IDMap.erase(m_sUniqueID);
 }
 //The big 3
 Simplex::MyEntity::MyEntity(String a_sFileName, String a_sUniqueID)
 {
 	Init();
-	m_pModel = new Model();
-	m_pModel->Load(a_sFileName);
+	//the file is only parsed for the first entity that uses it
+	m_pAsset = MyAssetCache::GetInstance()->Acquire(a_sFileName);
 	//if the model is loaded
-	if (m_pModel->GetName() != "")
+	if (m_pAsset)
 	{
 		GenUniqueID(a_sUniqueID);
 		m_sUniqueID = a_sUniqueID;
 		m_IDMap[a_sUniqueID] = this;
-		m_pRigidBody = new RigidBody(m_pModel->GetVertexList()); //generate a rigid body
+		m_pModel = m_pAsset->m_pModel; //the model only gets its matrix when it is drawn, so it is shared
+		m_pRigidBody = new RigidBody(*m_pAsset->m_pRigidBody); //copy the precomputed bounding volume
 		m_bInMemory = true; //mark this entity as viable
 	}
 }
 Simplex::MyEntity::MyEntity(MyEntity const& other)
 {
 	m_bInMemory = other.m_bInMemory;
+	m_pAsset = other.m_pAsset;
+	if (m_pAsset)
+		MyAssetCache::GetInstance()->Acquire(m_pAsset->m_sFileName);
 	m_pModel = other.m_pModel;
 	//generate a new rigid body we do not share the same rigid body as we do the model
-	m_pRigidBody = new RigidBody(m_pModel->GetVertexList()); 
+	m_pRigidBody = new RigidBody(*other.m_pRigidBody); 
 	m_m4ToWorld = other.m_m4ToWorld;
 	m_pMeshMngr = other.m_pMeshMngr;
 	m_sUniqueID = other.m_sUniqueID;
@@ -102,7 +113,8 @@ void Simplex::MyEntity::AddToRenderList(bool a_bDrawRigidBody)
 	if (!m_bInMemory)
 		return;
 
-	//draw model
+	//draw model, it only gets its matrix when it is drawn
+	m_pModel->SetModelMatrix(m_m4ToWorld);
 	m_pModel->AddToRenderList();
 	
 	//draw rigid body
@@ -112,6 +124,38 @@ void Simplex::MyEntity::AddToRenderList(bool a_bDrawRigidBody)
 	if (m_bSetAxis)
 		m_pMeshMngr->AddAxisToRenderList(m_m4ToWorld);
 }
+void Simplex::MyEntity::AddToSnapshot(MyRenderSnapshot& a_Snapshot, bool a_bDrawRigidBody, uint a_uLevel)
+{
+	//if not in memory return
+	if (!m_bInMemory)
+		return;
+
+	//draw the model of the level, each level has meshes of its own so the mesh manager batches them apart
+	std::vector<Model*> const& lLevel = m_pAsset->m_lLODModel;
+	uint uLevel = (glm::min)(a_uLevel, static_cast<uint>(lLevel.size()) - 1);
+	a_Snapshot.AddInstance(lLevel[uLevel], m_m4ToWorld, uLevel, m_pAsset->m_lLODTriangles[uLevel]);
+
+	//draw rigid body, as RigidBody::AddToRenderList does but out of its getters
+	if (a_bDrawRigidBody)
+	{
+		bool bColliding = m_pRigidBody->GetCollidingCount() > 0;
+		matrix4 m4Center = glm::translate(m_m4ToWorld, m_pRigidBody->GetCenterLocal());
+		if (m_pRigidBody->GetVisibleBS())
+			a_Snapshot.AddDebugDraw(MyRenderSnapshot::WireSphere,
+				m4Center * glm::scale(vector3(m_pRigidBody->GetRadius() * 2.0f)), C_BLUE_CORNFLOWER);
+		if (m_pRigidBody->GetVisibleOBB())
+			a_Snapshot.AddDebugDraw(MyRenderSnapshot::WireCube,
+				m4Center * glm::scale(m_pRigidBody->GetHalfWidth() * 2.0f),
+				bColliding ? m_pRigidBody->GetColorColliding() : m_pRigidBody->GetColorNotColliding());
+		if (m_pRigidBody->GetVisibleARBB())
+			a_Snapshot.AddDebugDraw(MyRenderSnapshot::WireCube,
+				glm::translate(m_pRigidBody->GetCenterGlobal()) *
+				glm::scale(m_pRigidBody->GetMaxGlobal() - m_pRigidBody->GetMinGlobal()), C_YELLOW);
+	}
+
+	if (m_bSetAxis)
+		a_Snapshot.AddDebugDraw(MyRenderSnapshot::Axis, m_m4ToWorld);
+}
 bool Simplex::MyEntity::IsColliding(MyEntity* const other)
 {
 	//if not in memory return
@@ -120,6 +164,23 @@ bool Simplex::MyEntity::IsColliding(MyEntity* const other)
 
 	return m_pRigidBody->IsColliding(other->GetRigidBody());
 }
+void Simplex::MyEntity::SetColliding(MyEntity* const other, bool a_bColliding)
+{
+	//if not in memory there is no rigid body to tell
+	if (!m_bInMemory || !other->m_bInMemory)
+		return;
+
+	if (a_bColliding)
+	{
+		m_pRigidBody->AddCollisionWith(other->GetRigidBody());
+		other->GetRigidBody()->AddCollisionWith(m_pRigidBody);
+	}
+	else
+	{
+		m_pRigidBody->RemoveCollisionWith(other->GetRigidBody());
+		other->GetRigidBody()->RemoveCollisionWith(m_pRigidBody);
+	}
+}
 MyEntity* Simplex::MyEntity::GetEntity(String a_sUniqueID)
 {
 	//look the entity based on the unique id
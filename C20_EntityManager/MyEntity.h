@@ -6,16 +6,13 @@ Date: 2017/07
 #define __MYENTITY_H_
 
 #include "Simplex\Simplex.h"
+#include "MyDefinitions.h"
+#include "MyAssetCache.h"
+#include "MyRenderSnapshot.h"
+#include <unordered_map>
 
 namespace Simplex
 {
-	enum EntityLayer
-	{
-		None,
-		Player,
-		Obstacle,
-		Coin
-	};
 //System Class
 class MyEntity
 {
@@ -25,13 +22,14 @@ class MyEntity
 	bool m_bSetAxis = false; //render axis flag
 	String m_sUniqueID = ""; //Unique identifier name
 
-	Model* m_pModel = nullptr; //Model associated with this Entity
+	ModelAsset const* m_pAsset = nullptr; //Shared asset this Entity was created from
+	Model* m_pModel = nullptr; //Model of the asset, every Entity of the same file draws it
 	RigidBody* m_pRigidBody = nullptr; //Rigid Body associated with this Entity
 
 	matrix4 m_m4ToWorld = IDENTITY_M4; //Model matrix associated with this Entity
 	MeshManager* m_pMeshMngr = nullptr; //For rendering shapes
 
-	static std::map<String, MyEntity*> m_IDMap; //a map of the unique ID's
+	static std::unordered_map<String, MyEntity*> m_IDMap; //a hash map of the unique ID's
 
 public:
 	/*
@@ -73,7 +71,8 @@ public:
 	*/
 	matrix4 GetModelMatrix(void);
 	/*
-	USAGE: Sets the model matrix associated with this entity
+	USAGE: Sets the model matrix associated with this entity and its rigid body, the model only gets it
+	when it is drawn so the simulation can move the entity while the last frame renders
 	ARGUMENTS: matrix4 a_m4ToWorld -> model matrix to set
 	OUTPUT: ---
 	*/
@@ -91,6 +90,12 @@ public:
 	*/
 	RigidBody* GetRigidBody(void);
 	/*
+	USAGE: Gets the shared asset this entity was created from, holds the local bounds
+	ARGUMENTS: ---
+	OUTPUT: asset, nullptr if the entity is not initialized
+	*/
+	ModelAsset const* GetAsset(void);
+	/*
 	USAGE: Will reply to the question, is the Entity Initialized?
 	ARGUMENTS: ---
 	OUTPUT: initialized?
@@ -103,12 +108,31 @@ public:
 	*/
 	void AddToRenderList(bool a_bDrawRigidBody = false);
 	/*
+	USAGE: Records the model of the entity and its debug shapes in a snapshot, the rigid body shapes are
+	the ones its own AddToRenderList would draw; reads the entity only, it can run on any thread
+	ARGUMENTS:
+	-	MyRenderSnapshot& a_Snapshot -> snapshot being recorded
+	-	bool a_bDrawRigidBody = false -> draw rigid body?
+	-	uint a_uLevel = 0 -> level of detail to draw, the simplest one the asset has if it has fewer
+	OUTPUT: ---
+	*/
+	void AddToSnapshot(MyRenderSnapshot& a_Snapshot, bool a_bDrawRigidBody = false, uint a_uLevel = 0);
+	/*
 	USAGE: Tells if this entity is colliding with the incoming one
 	ARGUMENTS: MyEntity* const other -> inspected entity
 	OUTPUT: are they colliding?
 	*/
 	bool IsColliding(MyEntity* const other);
 	/*
+	USAGE: Records the result of a collision test done somewhere else on both rigid bodies, the
+	same way IsColliding does with its own
+	ARGUMENTS:
+	-	MyEntity* const other -> inspected entity
+	-	bool a_bColliding -> are they colliding?
+	OUTPUT: ---
+	*/
+	void SetColliding(MyEntity* const other, bool a_bColliding);
+	/*
 	USAGE: Gets the Entity specified by unique ID, nullptr if not exists
 	ARGUMENTS: String a_sUniqueID -> unique ID if the queried entity
 	OUTPUT: Entity specified by unique ID, nullptr if not exists
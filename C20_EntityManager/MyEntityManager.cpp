@@ -1,4 +1,6 @@
 #include "MyEntityManager.h"
+#include "MyJobSystem.h"
+#include "MyProfiler.h"
 using namespace Simplex;
 //  MyEntityManager
 MyEntityManager* MyEntityManager::m_pInstance = nullptr;
@@ -6,6 +8,13 @@ void MyEntityManager::Init(void)
 {
 	m_uEntityCount = 0;
 	m_entityList.clear();
+	m_store.Clear();
+	m_mNameMap.clear();
+	m_lSlotIndex.clear();
+	m_lSlotGeneration.clear();
+	m_lFreeSlot.clear();
+	m_lIndexSlot.clear();
+	m_lCollidingEntity.clear();
 }
 void MyEntityManager::Release(void)
 {
@@ -16,6 +25,13 @@ void MyEntityManager::Release(void)
 	}
 	m_uEntityCount = 0;
 	m_entityList.clear();
+	m_store.Clear();
+	m_mNameMap.clear();
+	m_lSlotIndex.clear();
+	m_lSlotGeneration.clear();
+	m_lFreeSlot.clear();
+	m_lIndexSlot.clear();
+	m_lCollidingEntity.clear();
 }
 MyEntityManager* MyEntityManager::GetInstance()
 {
@@ -35,15 +51,41 @@ void MyEntityManager::ReleaseInstance()
 }
 int Simplex::MyEntityManager::GetEntityIndex(String a_sUniqueID)
 {
-	//look one by one for the specified unique id
-	for (uint uIndex = 0; uIndex < m_uEntityCount; ++uIndex)
-	{
-		if (a_sUniqueID == m_entityList[uIndex]->GetUniqueID())
-			return uIndex;
-	}
-	//if not found return -1
-	return -1;
+	//look the handle based on the unique id and resolve it
+	return GetEntityIndex(GetEntityHandle(a_sUniqueID));
+}
+int Simplex::MyEntityManager::GetEntityIndex(EntityHandle a_hEntity)
+{
+	//the slot has to exist and still be on the generation the handle was given out with
+	if (a_hEntity.m_uSlot >= m_lSlotIndex.size() ||
+		m_lSlotGeneration[a_hEntity.m_uSlot] != a_hEntity.m_uGeneration)
+		return -1;
+
+	return static_cast<int>(m_lSlotIndex[a_hEntity.m_uSlot]);
+}
+EntityHandle Simplex::MyEntityManager::GetEntityHandle(String a_sUniqueID)
+{
+	//look the entity based on the unique id
+	auto handle = m_mNameMap.find(a_sUniqueID);
+	//if not found return an invalid handle
+	return handle == m_mNameMap.end() ? EntityHandle() : handle->second;
 }
+EntityHandle Simplex::MyEntityManager::GetEntityHandle(uint a_uIndex)
+{
+	//if the list is empty return an invalid handle
+	if (m_uEntityCount == 0)
+		return EntityHandle();
+
+	//if the index is larger than the number of entries we are asking for the last one
+	if (a_uIndex >= m_uEntityCount)
+		a_uIndex = m_uEntityCount - 1;
+
+	EntityHandle hEntity;
+	hEntity.m_uSlot = m_lIndexSlot[a_uIndex];
+	hEntity.m_uGeneration = m_lSlotGeneration[hEntity.m_uSlot];
+	return hEntity;
+}
+bool Simplex::MyEntityManager::IsValid(EntityHandle a_hEntity) { return GetEntityIndex(a_hEntity) >= 0; }
 //Accessors
 Model* Simplex::MyEntityManager::GetModel(uint a_uIndex)
 {
@@ -59,12 +101,15 @@ Model* Simplex::MyEntityManager::GetModel(uint a_uIndex)
 }
 Model* Simplex::MyEntityManager::GetModel(String a_sUniqueID)
 {
-	//Get the entity
-	MyEntity* pTemp = MyEntity::GetEntity(a_sUniqueID);
+	return GetModel(GetEntityHandle(a_sUniqueID));
+}
+Model* Simplex::MyEntityManager::GetModel(EntityHandle a_hEntity)
+{
+	int nIndex = GetEntityIndex(a_hEntity);
 	//if the entity exists
-	if (pTemp)
+	if (nIndex >= 0)
 	{
-		return pTemp->GetModel();
+		return m_entityList[nIndex]->GetModel();
 	}
 	return nullptr;
 }
@@ -82,12 +127,15 @@ RigidBody* Simplex::MyEntityManager::GetRigidBody(uint a_uIndex)
 }
 RigidBody* Simplex::MyEntityManager::GetRigidBody(String a_sUniqueID)
 {
-	//Get the entity
-	MyEntity* pTemp = MyEntity::GetEntity(a_sUniqueID);
+	return GetRigidBody(GetEntityHandle(a_sUniqueID));
+}
+RigidBody* Simplex::MyEntityManager::GetRigidBody(EntityHandle a_hEntity)
+{
+	int nIndex = GetEntityIndex(a_hEntity);
 	//if the entity exists
-	if (pTemp)
+	if (nIndex >= 0)
 	{
-		return pTemp->GetRigidBody();
+		return m_entityList[nIndex]->GetRigidBody();
 	}
 	return nullptr;
 }
@@ -101,27 +149,34 @@ matrix4 Simplex::MyEntityManager::GetModelMatrix(uint a_uIndex)
 	if (a_uIndex >= m_uEntityCount)
 		a_uIndex = m_uEntityCount - 1;
 
-	return m_entityList[a_uIndex]->GetModelMatrix();
+	return m_store.GetModelMatrixArray()[a_uIndex];
 }
 matrix4 Simplex::MyEntityManager::GetModelMatrix(String a_sUniqueID)
 {
-	//Get the entity
-	MyEntity* pTemp = MyEntity::GetEntity(a_sUniqueID);
+	return GetModelMatrix(GetEntityHandle(a_sUniqueID));
+}
+matrix4 Simplex::MyEntityManager::GetModelMatrix(EntityHandle a_hEntity)
+{
+	int nIndex = GetEntityIndex(a_hEntity);
 	//if the entity exists
-	if (pTemp)
+	if (nIndex >= 0)
 	{
-		return pTemp->GetModelMatrix();
+		return m_store.GetModelMatrixArray()[nIndex];
 	}
 	return IDENTITY_M4;
 }
 void Simplex::MyEntityManager::SetModelMatrix(matrix4 a_m4ToWorld, String a_sUniqueID)
 {
-	//Get the entity
-	MyEntity* pTemp = MyEntity::GetEntity(a_sUniqueID);
+	SetModelMatrix(a_m4ToWorld, GetEntityHandle(a_sUniqueID));
+}
+void Simplex::MyEntityManager::SetModelMatrix(matrix4 a_m4ToWorld, EntityHandle a_hEntity)
+{
+	int nIndex = GetEntityIndex(a_hEntity);
 	//if the entity exists
-	if (pTemp)
+	if (nIndex >= 0)
 	{
-		pTemp->SetModelMatrix(a_m4ToWorld);
+		m_store.SetModelMatrix(nIndex, a_m4ToWorld);
+		m_entityList[nIndex]->SetModelMatrix(a_m4ToWorld);
 	}
 }
 void Simplex::MyEntityManager::SetAxisVisibility(bool a_bVisibility, uint a_uIndex)
@@ -138,12 +193,15 @@ void Simplex::MyEntityManager::SetAxisVisibility(bool a_bVisibility, uint a_uInd
 }
 void Simplex::MyEntityManager::SetAxisVisibility(bool a_bVisibility, String a_sUniqueID)
 {
-	//Get the entity
-	MyEntity* pTemp = MyEntity::GetEntity(a_sUniqueID);
+	SetAxisVisibility(a_bVisibility, GetEntityHandle(a_sUniqueID));
+}
+void Simplex::MyEntityManager::SetAxisVisibility(bool a_bVisibility, EntityHandle a_hEntity)
+{
+	int nIndex = GetEntityIndex(a_hEntity);
 	//if the entity exists
-	if (pTemp)
+	if (nIndex >= 0)
 	{
-		pTemp->SetAxisVisible(a_bVisibility);
+		m_entityList[nIndex]->SetAxisVisible(a_bVisibility);
 	}
 }
 void Simplex::MyEntityManager::SetModelMatrix(matrix4 a_m4ToWorld, uint a_uIndex)
@@ -156,6 +214,7 @@ void Simplex::MyEntityManager::SetModelMatrix(matrix4 a_m4ToWorld, uint a_uIndex
 	if (a_uIndex >= m_uEntityCount)
 		a_uIndex = m_uEntityCount -1;
 
+	m_store.SetModelMatrix(a_uIndex, a_m4ToWorld);
 	m_entityList[a_uIndex]->SetModelMatrix(a_m4ToWorld);
 }
 //The big 3
@@ -166,27 +225,106 @@ MyEntityManager::~MyEntityManager(){Release();};
 // other methods
 void Simplex::MyEntityManager::Update(void)
 {
-	//check collisions. This is brute force and checking every object in the scene.
-	for (uint i = 0; i < m_uEntityCount - 1; i++)
+	//check collisions, the sweep and prune only lets through the pairs whose bounds overlap
+	GetCandidatePairs(m_lPair);
+	CheckCollisions(m_lPair, m_lPairColliding);
+}
+uint Simplex::MyEntityManager::GetCandidatePairs(std::vector<std::pair<uint, uint>>& a_lPair)
+{
+	m_SweepAndPrune.Update(m_store.GetMinGlobalArray(), m_store.GetMaxGlobalArray(), m_store.GetLayerArray(), m_uEntityCount);
+	return m_SweepAndPrune.FindPairs(a_lPair, m_LayerFilter);
+}
+uint Simplex::MyEntityManager::CheckCollisions(std::vector<std::pair<uint, uint>> const& a_lPair, std::vector<uint>& a_lColliding)
+{
+	MY_PROFILE_FUNCTION();
+	a_lColliding.resize(a_lPair.size());
+
+	//the test only reads the store, so the pairs can go to any thread
+	MyJobSystem::GetInstance()->ParallelFor(a_lPair.size(), 64, [&](uint a_uBegin, uint a_uEnd)
 	{
-		for (uint j = i + 1; j < m_uEntityCount; j++)
+		MY_PROFILE_ZONE("Narrow phase");
+		for (uint i = a_uBegin; i < a_uEnd; ++i)
 		{
-			m_entityList[i]->IsColliding(m_entityList[j]);
+			uint uA = a_lPair[i].first;
+			uint uB = a_lPair[i].second;
+			//an entity that is not in memory collides with everything, as IsColliding says
+			bool bColliding = !m_entityList[uA]->IsInitialized() || !m_entityList[uB]->IsInitialized() ||
+				m_store.AreBoxesOverlapping(uA, uB);
+			a_lColliding[i] = bColliding ? 1 : 0;
 		}
+	});
+
+	//the colliding lists of the rigid bodies are not safe to touch from several threads; they start
+	//empty every pass, pairs that stopped being candidates would otherwise stay in them. Only the
+	//entities the last pass put in a list have anything to clear, handles skip the removed ones
+	for (uint i = 0; i < m_lCollidingEntity.size(); ++i)
+	{
+		int nIndex = GetEntityIndex(m_lCollidingEntity[i]);
+		if (nIndex >= 0 && m_entityList[nIndex]->IsInitialized())
+			m_entityList[nIndex]->GetRigidBody()->ClearCollidingList();
+	}
+	m_lCollidingEntity.clear();
+	uint uColliding = 0;
+	for (uint i = 0; i < a_lPair.size(); ++i)
+	{
+		if (a_lColliding[i] == 0)
+			continue;
+		m_entityList[a_lPair[i].first]->SetColliding(m_entityList[a_lPair[i].second], true);
+		m_lCollidingEntity.push_back(GetEntityHandle(a_lPair[i].first));
+		m_lCollidingEntity.push_back(GetEntityHandle(a_lPair[i].second));
+		++uColliding;
 	}
+	return uColliding;
 }
-void Simplex::MyEntityManager::AddEntity(String a_sFileName, String a_sUniqueID, Simplex::EntityLayer a_Layer)
+void Simplex::MyEntityManager::SetLayerFilter(EntityLayerFilter const& a_Filter) { m_LayerFilter = a_Filter; }
+EntityLayerFilter const& Simplex::MyEntityManager::GetLayerFilter(void) { return m_LayerFilter; }
+void Simplex::MyEntityManager::SetFrustumCulling(bool a_bCulling) { m_bFrustumCulling = a_bCulling; }
+bool Simplex::MyEntityManager::IsFrustumCulling(void) { return m_bFrustumCulling; }
+void Simplex::MyEntityManager::SetLevelOfDetail(bool a_bLevelOfDetail) { m_bLevelOfDetail = a_bLevelOfDetail; }
+bool Simplex::MyEntityManager::IsLevelOfDetail(void) { return m_bLevelOfDetail; }
+void Simplex::MyEntityManager::SetLODScreenSize(uint a_uLevel, float a_fScreenSize)
+{
+	if (a_uLevel == 0 || a_uLevel >= LOD_LEVEL_COUNT)
+		return;
+	m_fLODScreenSize[a_uLevel - 1] = a_fScreenSize;
+}
+EntityHandle Simplex::MyEntityManager::AddEntity(String a_sFileName, String a_sUniqueID, Simplex::EntityLayer a_Layer)
 {
 	//Create a temporal entity to store the object
 	MyEntity* pTemp = new MyEntity(a_sFileName, a_sUniqueID);
 
-	//if I was able to generate it add it to the list
-	if (pTemp->IsInitialized())
+	//if I was not able to generate it there is nothing to add
+	if (!pTemp->IsInitialized())
 	{
-		pTemp->SetEntityLayer(a_Layer);
-		m_entityList.push_back(pTemp);
-		m_uEntityCount = m_entityList.size();
+		SafeDelete(pTemp);
+		return EntityHandle();
 	}
+
+	pTemp->SetEntityLayer(a_Layer);
+	ModelAsset const* pAsset = pTemp->GetAsset();
+	uint uIndex = m_store.Add(a_Layer, pAsset->m_v3MinLocal, pAsset->m_v3MaxLocal);
+	m_entityList.push_back(pTemp);
+	m_uEntityCount = m_entityList.size();
+
+	//reuse a free slot if there is one, the generation was bumped when it was freed
+	EntityHandle hEntity;
+	if (m_lFreeSlot.size() > 0)
+	{
+		hEntity.m_uSlot = m_lFreeSlot.back();
+		m_lFreeSlot.pop_back();
+	}
+	else
+	{
+		hEntity.m_uSlot = m_lSlotIndex.size();
+		m_lSlotIndex.push_back(0);
+		m_lSlotGeneration.push_back(0);
+	}
+	hEntity.m_uGeneration = m_lSlotGeneration[hEntity.m_uSlot];
+	m_lSlotIndex[hEntity.m_uSlot] = uIndex;
+	m_lIndexSlot.push_back(hEntity.m_uSlot);
+
+	m_mNameMap[pTemp->GetUniqueID()] = hEntity;
+	return hEntity;
 }
 void Simplex::MyEntityManager::RemoveEntity(uint a_uIndex)
 {
@@ -198,22 +336,41 @@ void Simplex::MyEntityManager::RemoveEntity(uint a_uIndex)
 	if (a_uIndex >= m_uEntityCount)
 		a_uIndex = m_uEntityCount - 1;
 
+	//free the slot, bumping the generation makes every handle to it stale
+	uint uSlot = m_lIndexSlot[a_uIndex];
+	m_lSlotIndex[uSlot] = static_cast<uint>(-1);
+	++m_lSlotGeneration[uSlot];
+	m_lFreeSlot.push_back(uSlot);
+
 	// if the entity is not the very last we swap it for the last one
 	if (a_uIndex != m_uEntityCount - 1)
 	{
 		std::swap(m_entityList[a_uIndex], m_entityList[m_uEntityCount - 1]);
+		std::swap(m_lIndexSlot[a_uIndex], m_lIndexSlot[m_uEntityCount - 1]);
+		m_lSlotIndex[m_lIndexSlot[a_uIndex]] = a_uIndex;
 	}
-	
+	//the store does the same swap internally
+	m_store.Remove(a_uIndex);
+
 	//and then pop the last one
 	MyEntity* pTemp = m_entityList[m_uEntityCount - 1];
+	m_mNameMap.erase(pTemp->GetUniqueID());
 	SafeDelete(pTemp);
 	m_entityList.pop_back();
+	m_lIndexSlot.pop_back();
 	--m_uEntityCount;
 	return;
 }
 void Simplex::MyEntityManager::RemoveEntity(String a_sUniqueID)
 {
-	int nIndex = GetEntityIndex(a_sUniqueID);
+	RemoveEntity(GetEntityHandle(a_sUniqueID));
+}
+void Simplex::MyEntityManager::RemoveEntity(EntityHandle a_hEntity)
+{
+	int nIndex = GetEntityIndex(a_hEntity);
+	//if not found there is nothing to remove
+	if (nIndex < 0)
+		return;
 	RemoveEntity((uint)nIndex);
 }
 uint & Simplex::MyEntityManager::GetEntityCount(void)
@@ -230,6 +387,16 @@ String Simplex::MyEntityManager::GetUniqueID(uint a_uIndex)
 		a_uIndex = m_entityList.size() - 1;
 	return m_entityList[a_uIndex]->GetUniqueID();
 }
+String Simplex::MyEntityManager::GetUniqueID(EntityHandle a_hEntity)
+{
+	int nIndex = GetEntityIndex(a_hEntity);
+	//if the entity exists
+	if (nIndex >= 0)
+	{
+		return m_entityList[nIndex]->GetUniqueID();
+	}
+	return "";
+}
 MyEntity* Simplex::MyEntityManager::GetEntity(uint a_uIndex)
 {
 	//if the list is empty return blank
@@ -242,6 +409,61 @@ MyEntity* Simplex::MyEntityManager::GetEntity(uint a_uIndex)
 
 	return m_entityList[a_uIndex];
 }
+MyEntity* Simplex::MyEntityManager::GetEntity(EntityHandle a_hEntity)
+{
+	int nIndex = GetEntityIndex(a_hEntity);
+	//if the entity exists
+	if (nIndex >= 0)
+	{
+		return m_entityList[nIndex];
+	}
+	return nullptr;
+}
+MyEntityStore const& Simplex::MyEntityManager::GetEntityStore(void) { return m_store; }
+EntityLayer Simplex::MyEntityManager::GetEntityLayer(uint a_uIndex)
+{
+	//if the list is empty return blank
+	if (m_uEntityCount == 0)
+		return EntityLayer::None;
+
+	//if the index is larger than the number of entries we are asking for the last one
+	if (a_uIndex >= m_uEntityCount)
+		a_uIndex = m_uEntityCount - 1;
+
+	return m_store.GetLayerArray()[a_uIndex];
+}
+EntityLayer Simplex::MyEntityManager::GetEntityLayer(EntityHandle a_hEntity)
+{
+	int nIndex = GetEntityIndex(a_hEntity);
+	//if the entity exists
+	if (nIndex >= 0)
+	{
+		return m_store.GetLayerArray()[nIndex];
+	}
+	return EntityLayer::None;
+}
+void Simplex::MyEntityManager::SetEntityLayer(EntityLayer a_eLayer, uint a_uIndex)
+{
+	//if the list is empty return
+	if (m_uEntityCount == 0)
+		return;
+
+	//if the index is larger than the number of entries we are asking for the last one
+	if (a_uIndex >= m_uEntityCount)
+		a_uIndex = m_uEntityCount - 1;
+
+	m_store.SetLayer(a_uIndex, a_eLayer);
+	m_entityList[a_uIndex]->SetEntityLayer(a_eLayer);
+}
+void Simplex::MyEntityManager::SetEntityLayer(EntityLayer a_eLayer, EntityHandle a_hEntity)
+{
+	int nIndex = GetEntityIndex(a_hEntity);
+	//if the entity exists
+	if (nIndex >= 0)
+	{
+		SetEntityLayer(a_eLayer, static_cast<uint>(nIndex));
+	}
+}
 void Simplex::MyEntityManager::AddEntityToRenderList(uint a_uIndex, bool a_bRigidBody)
 {
 	//if out of bounds will do it for all
@@ -260,11 +482,91 @@ void Simplex::MyEntityManager::AddEntityToRenderList(uint a_uIndex, bool a_bRigi
 }
 void Simplex::MyEntityManager::AddEntityToRenderList(String a_sUniqueID, bool a_bRigidBody)
 {
-	//Get the entity
-	MyEntity* pTemp = MyEntity::GetEntity(a_sUniqueID);
+	AddEntityToRenderList(GetEntityHandle(a_sUniqueID), a_bRigidBody);
+}
+void Simplex::MyEntityManager::AddEntityToRenderList(EntityHandle a_hEntity, bool a_bRigidBody)
+{
+	int nIndex = GetEntityIndex(a_hEntity);
 	//if the entity exists
-	if (pTemp)
+	if (nIndex >= 0)
+	{
+		m_entityList[nIndex]->AddToRenderList(a_bRigidBody);
+	}
+}
+void Simplex::MyEntityManager::CaptureSnapshot(MyRenderSnapshot& a_Snapshot, uint a_uFrame, bool a_bRigidBody)
+{
+	MY_PROFILE_FUNCTION();
+	a_Snapshot.Clear(a_uFrame);
+	//the keys can flip the options while a worker records this, the whole snapshot uses what they were now
+	bool bFrustumCulling = m_bFrustumCulling.load();
+	bool bLevelOfDetail = m_bLevelOfDetail.load();
+	if (!bFrustumCulling)
+	{
+		for (uint i = 0; i < m_uEntityCount; ++i)
+		{
+			m_entityList[i]->AddToSnapshot(a_Snapshot, a_bRigidBody, bLevelOfDetail ? SelectLOD(a_Snapshot, i) : 0);
+		}
+		a_Snapshot.SetCullCount(m_uEntityCount, 0);
+		return;
+	}
+
+	//the planes come from the camera the snapshot is going to be seen from
+	MyFrustum frustum(a_Snapshot.GetViewProjection());
+	uint uVisible = m_store.GetPackedBounds().QueryFrustumMask(frustum, m_lVisibleMask);
+	for (uint w = 0; w < m_lVisibleMask.size(); ++w)
+	{
+		uint uIndex = w * 32;
+		for (uint uMask = m_lVisibleMask[w]; uMask != 0; ++uIndex, uMask >>= 1)
+		{
+			if (uMask & 1u)
+				m_entityList[uIndex]->AddToSnapshot(a_Snapshot, a_bRigidBody,
+					bLevelOfDetail ? SelectLOD(a_Snapshot, uIndex) : 0);
+		}
+	}
+	a_Snapshot.SetCullCount(uVisible, m_uEntityCount - uVisible);
+}
+uint Simplex::MyEntityManager::SelectLOD(MyRenderSnapshot const& a_Snapshot, uint a_uIndex) const
+{
+	//the sphere around the global box, it already has the scale of the entity
+	vector3 const& v3Min = m_store.GetMinGlobalArray()[a_uIndex];
+	vector3 const& v3Max = m_store.GetMaxGlobalArray()[a_uIndex];
+	float fSize = a_Snapshot.GetScreenSize((v3Min + v3Max) * 0.5f, glm::length(v3Max - v3Min) * 0.5f);
+
+	uint uLevel = 0;
+	while (uLevel < LOD_LEVEL_COUNT - 1 && fSize < m_fLODScreenSize[uLevel])
+		++uLevel;
+	return uLevel;
+}
+void Simplex::MyEntityManager::SubmitSnapshot(MyRenderSnapshot const& a_Snapshot)
+{
+	MY_PROFILE_FUNCTION();
+	MeshManager* pMeshMngr = MeshManager::GetInstance();
+
+	//the models are only touched here, the simulation keeps its matrices in the entities
+	std::vector<MyRenderSnapshot::Instance> const& lInstance = a_Snapshot.GetInstanceList();
+	for (uint i = 0; i < lInstance.size(); ++i)
 	{
-		pTemp->AddToRenderList(a_bRigidBody);
+		lInstance[i].m_pModel->SetModelMatrix(lInstance[i].m_m4ToWorld);
+		lInstance[i].m_pModel->AddToRenderList();
 	}
-}
\ No newline at end of file
+
+	std::vector<MyRenderSnapshot::DebugDraw> const& lDebugDraw = a_Snapshot.GetDebugDrawList();
+	for (uint i = 0; i < lDebugDraw.size(); ++i)
+	{
+		MyRenderSnapshot::DebugDraw const& draw = lDebugDraw[i];
+		switch (draw.m_eShape)
+		{
+		case MyRenderSnapshot::WireSphere:
+			pMeshMngr->AddWireSphereToRenderList(draw.m_m4ToWorld, draw.m_v3Color);
+			break;
+		case MyRenderSnapshot::Axis:
+			pMeshMngr->AddAxisToRenderList(draw.m_m4ToWorld);
+			break;
+		default:
+			pMeshMngr->AddWireCubeToRenderList(draw.m_m4ToWorld, draw.m_v3Color);
+			break;
+		}
+	}
+
+	a_Snapshot.ApplyLights();
+}
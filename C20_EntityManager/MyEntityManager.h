@@ -6,6 +6,9 @@ Date: 2017/07
 #define __MYENTITYMANAGER_H_
 
 #include "MyEntity.h"
+#include "MyEntityStore.h"
+#include "MySweepAndPrune.h"
+#include <atomic>
 
 namespace Simplex
 {
@@ -15,7 +18,24 @@ class MyEntityManager
 {
 	uint m_uEntityCount = 0; //number of elements in the list
 	static MyEntityManager* m_pInstance; // Singleton pointer
-	std::vector<MyEntity*> m_entityList; //entities list
+	std::vector<MyEntity*> m_entityList; //entities list, cold data (model and rigid body) indexed as the store
+	MyEntityStore m_store; //hot data of the entities (transforms, layers and bounds) in contiguous arrays
+	std::unordered_map<String, EntityHandle> m_mNameMap; //unique ID to handle, for the by name lookups
+
+	std::vector<uint> m_lSlotIndex; //index in the lists of the entity in each handle slot, -1 if free
+	std::vector<uint> m_lSlotGeneration; //current generation of each handle slot
+	std::vector<uint> m_lFreeSlot; //handle slots available for reuse
+	std::vector<uint> m_lIndexSlot; //handle slot of each entity, indexed as the lists
+
+	MySweepAndPrune m_SweepAndPrune; //broadphase over the bounds in the store
+	EntityLayerFilter m_LayerFilter; //layers tested against each other by the broadphase
+	std::vector<std::pair<uint, uint>> m_lPair; //candidate pairs of the last update, kept to reuse its memory
+	std::vector<uint> m_lPairColliding; //results of the pairs of the last update
+	std::vector<EntityHandle> m_lCollidingEntity; //entities the last collision pass put in a colliding list
+	std::atomic<bool> m_bFrustumCulling{ true }; //snapshots only keep the entities inside the camera, set while one may be recorded
+	std::vector<uint> m_lVisibleMask; //bit per entity inside the camera of the last snapshot, kept to reuse its memory
+	std::atomic<bool> m_bLevelOfDetail{ true }; //snapshots draw the entities that look small with simpler models, set while one may be recorded
+	float m_fLODScreenSize[LOD_LEVEL_COUNT - 1] = { 0.12f, 0.06f, 0.03f }; //screen size under which each level from the first is drawn
 public:
 	/*
 	Usage: Gets the singleton pointer
@@ -36,13 +56,38 @@ public:
 	*/
 	int GetEntityIndex(String a_sUniqueID);
 	/*
+	USAGE: Gets the index (from the list of entities) of the entity specified by handle, O(1)
+	ARGUMENTS: EntityHandle a_hEntity -> queried entity
+	OUTPUT: index from the list of entities, -1 if the handle is stale
+	*/
+	int GetEntityIndex(EntityHandle a_hEntity);
+	/*
+	USAGE: Gets the handle of the entity specified by UniqueID
+	ARGUMENTS: String a_sUniqueID -> unique identifier of the queried entity
+	OUTPUT: handle of the entity, invalid handle if not found
+	*/
+	EntityHandle GetEntityHandle(String a_sUniqueID);
+	/*
+	USAGE: Gets the handle of the entity indexed
+	ARGUMENTS: uint a_uIndex = -1 -> index of the queried entry, if < 0 asks for the last one added
+	OUTPUT: handle of the entity, invalid handle if the list is empty
+	*/
+	EntityHandle GetEntityHandle(uint a_uIndex = -1);
+	/*
+	USAGE: Tells if the handle still refers to an entity in the manager
+	ARGUMENTS: EntityHandle a_hEntity -> queried entity
+	OUTPUT: is it alive?
+	*/
+	bool IsValid(EntityHandle a_hEntity);
+	/*
 	USAGE: Will add an entity to the list
 	ARGUMENTS:
 	-	String a_sFileName -> Name of the model to load
 	-	String a_sUniqueID -> Name wanted as identifier, if not available will generate one
-	OUTPUT: ---
+	-	EntityLayer a_Layer -> layer of the entity
+	OUTPUT: handle of the new entity, invalid handle if the model could not be loaded
 	*/
-	void AddEntity(String a_sFileName, String a_sUniqueID = "NA", Simplex::EntityLayer a_Layer = Simplex::EntityLayer::None);
+	EntityHandle AddEntity(String a_sFileName, String a_sUniqueID = "NA", Simplex::EntityLayer a_Layer = Simplex::EntityLayer::None);
 	/*
 	USAGE: Deletes the Entity Specified by unique ID and removes it from the list
 	ARGUMENTS: uint a_uIndex -> index of the queried entry, if < 0 asks for the last one added
@@ -56,6 +101,12 @@ public:
 	*/
 	void RemoveEntity(String a_sUniqueID);
 	/*
+	USAGE: Deletes the Entity Specified by handle and removes it from the list
+	ARGUMENTS: EntityHandle a_hEntity -> handle of the entity
+	OUTPUT: ---
+	*/
+	void RemoveEntity(EntityHandle a_hEntity);
+	/*
 	USAGE: Get the current entity count
 	ARGUMENTS: ---
 	OUTPUT: uint & -> The number of total entities in this manager
@@ -68,18 +119,128 @@ public:
 	*/
 	String GetUniqueID(uint a_uIndex = -1);
 	/*
+	USAGE: Gets the uniqueID name of the entity specified by handle
+	ARGUMENTS: EntityHandle a_hEntity -> handle of the entity
+	OUTPUT: UniqueID of the entity, blank if the handle is stale
+	*/
+	String GetUniqueID(EntityHandle a_hEntity);
+	/*
 	USAGE: Gets the uniqueID name of the entity indexed
 	ARGUMENTS: uint a_uIndex = -1 -> index of the queried entry, if < 0 asks for the last one added
 	OUTPUT: UniqueID of the entity, if the list is empty will return blank
 	*/
 	MyEntity* GetEntity(uint a_uIndex = -1);
 	/*
+	USAGE: Gets the entity specified by handle
+	ARGUMENTS: EntityHandle a_hEntity -> handle of the entity
+	OUTPUT: entity, nullptr if the handle is stale
+	*/
+	MyEntity* GetEntity(EntityHandle a_hEntity);
+	/*
+	USAGE: Gets the store holding the per frame data of every entity, arrays are indexed as the entity list
+	ARGUMENTS: ---
+	OUTPUT: entity store
+	*/
+	MyEntityStore const& GetEntityStore(void);
+	/*
+	USAGE: Gets the layer of the entity indexed
+	ARGUMENTS: uint a_uIndex = -1 -> index of the queried entry, if < 0 asks for the last one added
+	OUTPUT: layer of the entity, None if the list is empty
+	*/
+	EntityLayer GetEntityLayer(uint a_uIndex = -1);
+	/*
+	USAGE: Gets the layer of the entity specified by handle
+	ARGUMENTS: EntityHandle a_hEntity -> handle of the entity
+	OUTPUT: layer of the entity, None if the handle is stale
+	*/
+	EntityLayer GetEntityLayer(EntityHandle a_hEntity);
+	/*
+	USAGE: Sets the layer of the entity indexed
+	ARGUMENTS:
+	-	EntityLayer a_eLayer -> layer to set
+	-	uint a_uIndex = -1 -> index of the queried entry, if < 0 asks for the last one added
+	OUTPUT: ---
+	*/
+	void SetEntityLayer(EntityLayer a_eLayer, uint a_uIndex = -1);
+	/*
+	USAGE: Sets the layer of the entity specified by handle
+	ARGUMENTS:
+	-	EntityLayer a_eLayer -> layer to set
+	-	EntityHandle a_hEntity -> handle of the entity
+	OUTPUT: ---
+	*/
+	void SetEntityLayer(EntityLayer a_eLayer, EntityHandle a_hEntity);
+	/*
 	USAGE: Will update the Entity manager
 	ARGUMENTS: ---
 	OUTPUT: ---
 	*/
 	void Update(void);
 	/*
+	USAGE: Refreshes the broadphase with the bounds in the store and gets the pairs of entities whose
+	bounds overlap and whose layers pass the layer filter
+	ARGUMENTS: std::vector<std::pair<uint, uint>>& a_lPair -> indices of the pairs, cleared first, reuses its capacity
+	OUTPUT: number of pairs
+	*/
+	uint GetCandidatePairs(std::vector<std::pair<uint, uint>>& a_lPair);
+	/*
+	USAGE: Tests pairs of entities, the oriented boxes on every thread of the job system, then records
+	the colliding ones on their rigid bodies; the colliding lists of every entity are cleared first so
+	they only hold what collides this pass
+	ARGUMENTS:
+	-	std::vector<std::pair<uint, uint>> const& a_lPair -> indices of the pairs to test
+	-	std::vector<uint>& a_lColliding -> 1 for each pair colliding, 0 for the rest
+	OUTPUT: number of pairs colliding
+	*/
+	uint CheckCollisions(std::vector<std::pair<uint, uint>> const& a_lPair, std::vector<uint>& a_lColliding);
+	/*
+	USAGE: Sets which layers the broadphase tests against each other
+	ARGUMENTS: EntityLayerFilter const& a_Filter -> layer filter
+	OUTPUT: ---
+	*/
+	void SetLayerFilter(EntityLayerFilter const& a_Filter);
+	/*
+	USAGE: Gets which layers the broadphase tests against each other
+	ARGUMENTS: ---
+	OUTPUT: layer filter
+	*/
+	EntityLayerFilter const& GetLayerFilter(void);
+	/*
+	USAGE: Sets if the snapshots leave out the entities outside of their camera, a snapshot being
+	recorded on another thread keeps what it read when it started
+	ARGUMENTS: bool a_bCulling -> cull?
+	OUTPUT: ---
+	*/
+	void SetFrustumCulling(bool a_bCulling);
+	/*
+	USAGE: Tells if the snapshots leave out the entities outside of their camera
+	ARGUMENTS: ---
+	OUTPUT: culling?
+	*/
+	bool IsFrustumCulling(void);
+	/*
+	USAGE: Sets if the snapshots draw the entities that look small with their simpler levels of detail,
+	a snapshot being recorded on another thread keeps what it read when it started
+	ARGUMENTS: bool a_bLevelOfDetail -> use the levels?
+	OUTPUT: ---
+	*/
+	void SetLevelOfDetail(bool a_bLevelOfDetail);
+	/*
+	USAGE: Tells if the snapshots draw the entities that look small with their simpler levels of detail
+	ARGUMENTS: ---
+	OUTPUT: using the levels?
+	*/
+	bool IsLevelOfDetail(void);
+	/*
+	USAGE: Sets the screen size under which a level of detail is drawn, the fraction of the height of
+	the screen the bounding sphere of the entity covers
+	ARGUMENTS:
+	-	uint a_uLevel -> level, from 1
+	-	float a_fScreenSize -> screen size, smaller for every next level
+	OUTPUT: ---
+	*/
+	void SetLODScreenSize(uint a_uLevel, float a_fScreenSize);
+	/*
 	USAGE: Gets the model associated with this entity
 	ARGUMENTS: uint a_uIndex = -1 -> index in the list of entities; if less than 0 it will add it to the last in the list
 	OUTPUT: Model
@@ -92,6 +253,12 @@ public:
 	*/
 	Model* GetModel(String a_sUniqueID);
 	/*
+	USAGE: Gets the model associated with this entity
+	ARGUMENTS: EntityHandle a_hEntity -> handle of the queried entity
+	OUTPUT: Model
+	*/
+	Model* GetModel(EntityHandle a_hEntity);
+	/*
 	USAGE: Gets the Rigid Body associated with this entity
 	ARGUMENTS: uint a_uIndex = -1 -> index in the list of entities; if less than 0 it will add it to the last in the list
 	OUTPUT: Rigid Body
@@ -104,6 +271,12 @@ public:
 	*/
 	RigidBody* GetRigidBody(String a_sUniqueID);
 	/*
+	USAGE: Gets the Rigid Body associated with this entity
+	ARGUMENTS: EntityHandle a_hEntity -> handle of the queried entity
+	OUTPUT: Rigid Body
+	*/
+	RigidBody* GetRigidBody(EntityHandle a_hEntity);
+	/*
 	USAGE: Gets the model matrix associated with this entity
 	ARGUMENTS: uint a_uIndex = -1 -> index in the list of entities; if less than 0 it will add it to the last in the list
 	OUTPUT: model to world matrix
@@ -116,6 +289,12 @@ public:
 	*/
 	matrix4 GetModelMatrix(String a_sUniqueID);
 	/*
+	USAGE: Gets the model matrix associated with this entity
+	ARGUMENTS: EntityHandle a_hEntity -> handle of the queried entity
+	OUTPUT: model to world matrix
+	*/
+	matrix4 GetModelMatrix(EntityHandle a_hEntity);
+	/*
 	USAGE: Sets the model matrix associated to the entity specified in the ID
 	ARGUMENTS:
 	-	matrix4 a_m4ToWorld -> model matrix to set
@@ -132,6 +311,14 @@ public:
 	*/
 	void SetModelMatrix(matrix4 a_m4ToWorld, String a_sUniqueID);
 	/*
+	USAGE: Sets the model matrix associated to the entity specified by handle
+	ARGUMENTS:
+	-	matrix4 a_m4ToWorld -> model matrix to set
+	-	EntityHandle a_hEntity -> handle of the queried entity
+	OUTPUT: ---
+	*/
+	void SetModelMatrix(matrix4 a_m4ToWorld, EntityHandle a_hEntity);
+	/*
 	USAGE: Sets the axis visibility associated to the entity specified in the ID
 	ARGUMENTS: 
 	-	bool a_bVisibility -> visibility of the axis
@@ -148,6 +335,14 @@ public:
 	*/
 	void SetAxisVisibility(bool a_bVisibility, String a_sUniqueID);
 	/*
+	USAGE: Sets the axis visibility associated to the entity specified by handle
+	ARGUMENTS:
+	-	bool a_bVisibility -> visibility of the axis
+	-	EntityHandle a_hEntity -> handle of the queried entity
+	OUTPUT: ---
+	*/
+	void SetAxisVisibility(bool a_bVisibility, EntityHandle a_hEntity);
+	/*
 	USAGE: Will add the specified entity to the render list
 	ARGUMENTS:
 	-	uint a_uIndex = -1 -> index (from the list) of the entity queried if < 0 will add all
@@ -163,6 +358,34 @@ public:
 	OUTPUT: ---
 	*/
 	void AddEntityToRenderList(String a_sUniqueID, bool a_bRigidBody = false);
+	/*
+	USAGE: Will add the specified entity by handle to the render list
+	ARGUMENTS:
+	-	EntityHandle a_hEntity -> handle of the entity queried
+	-	bool a_bRigidBody = false -> draw rigid body?
+	OUTPUT: ---
+	*/
+	void AddEntityToRenderList(EntityHandle a_hEntity, bool a_bRigidBody = false);
+	/*
+	USAGE: Records what every entity inside the camera of the snapshot draws, the end of the simulation
+	of a frame; the packed bounds of the store are tested against the frustum several at a time. It only
+	reads the entities so it can run on a worker while the main thread renders another snapshot
+	ARGUMENTS:
+	-	MyRenderSnapshot& a_Snapshot -> snapshot to record, its camera is already captured, its models,
+		debug shapes and counts are replaced; the models are the levels of detail the size of each
+		entity on its screen asks for
+	-	uint a_uFrame -> frame being recorded
+	-	bool a_bRigidBody = false -> draw rigid bodies?
+	OUTPUT: ---
+	*/
+	void CaptureSnapshot(MyRenderSnapshot& a_Snapshot, uint a_uFrame, bool a_bRigidBody = false);
+	/*
+	USAGE: Hands a snapshot to the mesh manager, the models get the matrices recorded in it and go to the
+	render list with the debug shapes, the lights are set as they were; from the main thread
+	ARGUMENTS: MyRenderSnapshot const& a_Snapshot -> snapshot to render
+	OUTPUT: ---
+	*/
+	void SubmitSnapshot(MyRenderSnapshot const& a_Snapshot);
 	
 private:
 	/*
@@ -201,6 +424,15 @@ private:
 	Output: ---
 	*/
 	void Init(void);
+	/*
+	USAGE: Picks the level of detail of an entity from how much of the screen of the snapshot its
+	bounding box covers
+	ARGUMENTS:
+	-	MyRenderSnapshot const& a_Snapshot -> snapshot being recorded, its camera is captured
+	-	uint a_uIndex -> index of the entity
+	OUTPUT: level, 0 for the source
+	*/
+	uint SelectLOD(MyRenderSnapshot const& a_Snapshot, uint a_uIndex) const;
 };//class
 
 } //namespace Simplex
@@ -0,0 +1,229 @@
+#include "MyEntityStore.h"
+using namespace Simplex;
+//  MyEntityStore
+Simplex::MyEntityStore::MyEntityStore(void) { m_uCount = 0; }
+void Simplex::MyEntityStore::Reserve(uint a_uCapacity)
+{
+	m_v3Position.reserve(a_uCapacity);
+	m_qRotation.reserve(a_uCapacity);
+	m_eLayer.reserve(a_uCapacity);
+	m_v3MinLocal.reserve(a_uCapacity);
+	m_v3MaxLocal.reserve(a_uCapacity);
+	m_v3MinGlobal.reserve(a_uCapacity);
+	m_v3MaxGlobal.reserve(a_uCapacity);
+	m_m4ToWorld.reserve(a_uCapacity);
+	m_PackedBounds.Reserve(a_uCapacity);
+}
+uint Simplex::MyEntityStore::Add(EntityLayer a_eLayer, vector3 a_v3MinLocal, vector3 a_v3MaxLocal)
+{
+	m_v3Position.push_back(ZERO_V3);
+	m_qRotation.push_back(quaternion());
+	m_eLayer.push_back(a_eLayer);
+	m_v3MinLocal.push_back(a_v3MinLocal);
+	m_v3MaxLocal.push_back(a_v3MaxLocal);
+	m_v3MinGlobal.push_back(a_v3MinLocal);
+	m_v3MaxGlobal.push_back(a_v3MaxLocal);
+	m_m4ToWorld.push_back(IDENTITY_M4);
+	m_PackedBounds.Add(a_v3MinLocal, a_v3MaxLocal);
+	return m_uCount++;
+}
+void Simplex::MyEntityStore::Remove(uint a_uIndex)
+{
+	if (a_uIndex >= m_uCount)
+		return;
+
+	uint uLast = m_uCount - 1;
+	// if the entry is not the very last we move the last one into its slot
+	if (a_uIndex != uLast)
+	{
+		m_v3Position[a_uIndex] = m_v3Position[uLast];
+		m_qRotation[a_uIndex] = m_qRotation[uLast];
+		m_eLayer[a_uIndex] = m_eLayer[uLast];
+		m_v3MinLocal[a_uIndex] = m_v3MinLocal[uLast];
+		m_v3MaxLocal[a_uIndex] = m_v3MaxLocal[uLast];
+		m_v3MinGlobal[a_uIndex] = m_v3MinGlobal[uLast];
+		m_v3MaxGlobal[a_uIndex] = m_v3MaxGlobal[uLast];
+		m_m4ToWorld[a_uIndex] = m_m4ToWorld[uLast];
+	}
+
+	m_v3Position.pop_back();
+	m_qRotation.pop_back();
+	m_eLayer.pop_back();
+	m_v3MinLocal.pop_back();
+	m_v3MaxLocal.pop_back();
+	m_v3MinGlobal.pop_back();
+	m_v3MaxGlobal.pop_back();
+	m_m4ToWorld.pop_back();
+	m_PackedBounds.Remove(a_uIndex);
+	--m_uCount;
+}
+void Simplex::MyEntityStore::Clear(void)
+{
+	m_v3Position.clear();
+	m_qRotation.clear();
+	m_eLayer.clear();
+	m_v3MinLocal.clear();
+	m_v3MaxLocal.clear();
+	m_v3MinGlobal.clear();
+	m_v3MaxGlobal.clear();
+	m_m4ToWorld.clear();
+	m_PackedBounds.Clear();
+	m_uCount = 0;
+}
+uint Simplex::MyEntityStore::GetCount(void) const { return m_uCount; }
+void Simplex::MyEntityStore::SetModelMatrix(uint a_uIndex, matrix4 const& a_m4ToWorld)
+{
+	if (a_uIndex >= m_uCount)
+		return;
+
+	m_m4ToWorld[a_uIndex] = a_m4ToWorld;
+	m_v3Position[a_uIndex] = vector3(a_m4ToWorld[3]);
+
+	//remove the scale from the basis before extracting the orientation
+	matrix3 m3Rotation(a_m4ToWorld);
+	for (uint i = 0; i < 3; ++i)
+	{
+		float fLength = glm::length(m3Rotation[i]);
+		if (fLength > 0.0f)
+			m3Rotation[i] /= fLength;
+	}
+	m_qRotation[a_uIndex] = glm::quat_cast(m3Rotation);
+
+	UpdateGlobalBounds(a_uIndex);
+}
+void Simplex::MyEntityStore::SetTransform(uint a_uIndex, vector3 const& a_v3Position, quaternion const& a_qRotation)
+{
+	if (a_uIndex >= m_uCount)
+		return;
+
+	m_v3Position[a_uIndex] = a_v3Position;
+	m_qRotation[a_uIndex] = a_qRotation;
+	matrix4 m4ToWorld = glm::mat4_cast(a_qRotation);
+	m4ToWorld[3] = vector4(a_v3Position, 1.0f);
+	m_m4ToWorld[a_uIndex] = m4ToWorld;
+
+	UpdateGlobalBounds(a_uIndex);
+}
+void Simplex::MyEntityStore::SetLayer(uint a_uIndex, EntityLayer a_eLayer)
+{
+	if (a_uIndex >= m_uCount)
+		return;
+
+	m_eLayer[a_uIndex] = a_eLayer;
+}
+bool Simplex::MyEntityStore::AreBoundsOverlapping(uint a_uA, uint a_uB) const
+{
+	vector3 const& v3MinA = m_v3MinGlobal[a_uA];
+	vector3 const& v3MaxA = m_v3MaxGlobal[a_uA];
+	vector3 const& v3MinB = m_v3MinGlobal[a_uB];
+	vector3 const& v3MaxB = m_v3MaxGlobal[a_uB];
+
+	return	v3MinA.x <= v3MaxB.x && v3MaxA.x >= v3MinB.x &&
+			v3MinA.y <= v3MaxB.y && v3MaxA.y >= v3MinB.y &&
+			v3MinA.z <= v3MaxB.z && v3MaxA.z >= v3MinB.z;
+}
+bool Simplex::MyEntityStore::AreBoxesOverlapping(uint a_uA, uint a_uB) const
+{
+	// centers in world space, axes without the scale and half sizes with it
+	matrix4 const& m4A = m_m4ToWorld[a_uA];
+	matrix4 const& m4B = m_m4ToWorld[a_uB];
+	vector3 v3CenterA = vector3(m4A * vector4((m_v3MinLocal[a_uA] + m_v3MaxLocal[a_uA]) * 0.5f, 1.0f));
+	vector3 v3CenterB = vector3(m4B * vector4((m_v3MinLocal[a_uB] + m_v3MaxLocal[a_uB]) * 0.5f, 1.0f));
+	vector3 v3HalfA = (m_v3MaxLocal[a_uA] - m_v3MinLocal[a_uA]) * 0.5f;
+	vector3 v3HalfB = (m_v3MaxLocal[a_uB] - m_v3MinLocal[a_uB]) * 0.5f;
+	vector3 v3AxisA[3];
+	vector3 v3AxisB[3];
+	for (uint i = 0; i < 3; ++i)
+	{
+		v3AxisA[i] = vector3(m4A[i]);
+		v3AxisB[i] = vector3(m4B[i]);
+		float fLengthA = glm::length(v3AxisA[i]);
+		float fLengthB = glm::length(v3AxisB[i]);
+		if (fLengthA > 0.0f)
+			v3AxisA[i] /= fLengthA;
+		if (fLengthB > 0.0f)
+			v3AxisB[i] /= fLengthB;
+		v3HalfA[i] *= fLengthA;
+		v3HalfB[i] *= fLengthB;
+	}
+
+	// B in the frame of A, the epsilon keeps parallel edges from making a null cross product pass
+	float fR[3][3];
+	float fAbsR[3][3];
+	for (uint i = 0; i < 3; ++i)
+	{
+		for (uint j = 0; j < 3; ++j)
+		{
+			fR[i][j] = glm::dot(v3AxisA[i], v3AxisB[j]);
+			fAbsR[i][j] = glm::abs(fR[i][j]) + 0.000001f;
+		}
+	}
+	vector3 v3Distance = v3CenterB - v3CenterA;
+	float fT[3] = { glm::dot(v3Distance, v3AxisA[0]), glm::dot(v3Distance, v3AxisA[1]), glm::dot(v3Distance, v3AxisA[2]) };
+	float fRA, fRB;
+
+	// axes of A
+	for (uint i = 0; i < 3; ++i)
+	{
+		fRA = v3HalfA[i];
+		fRB = v3HalfB[0] * fAbsR[i][0] + v3HalfB[1] * fAbsR[i][1] + v3HalfB[2] * fAbsR[i][2];
+		if (glm::abs(fT[i]) > fRA + fRB)
+			return false;
+	}
+
+	// axes of B
+	for (uint j = 0; j < 3; ++j)
+	{
+		fRA = v3HalfA[0] * fAbsR[0][j] + v3HalfA[1] * fAbsR[1][j] + v3HalfA[2] * fAbsR[2][j];
+		fRB = v3HalfB[j];
+		if (glm::abs(fT[0] * fR[0][j] + fT[1] * fR[1][j] + fT[2] * fR[2][j]) > fRA + fRB)
+			return false;
+	}
+
+	// cross products of an axis of A with an axis of B
+	for (uint i = 0; i < 3; ++i)
+	{
+		uint i1 = (i + 1) % 3;
+		uint i2 = (i + 2) % 3;
+		for (uint j = 0; j < 3; ++j)
+		{
+			uint j1 = (j + 1) % 3;
+			uint j2 = (j + 2) % 3;
+			fRA = v3HalfA[i1] * fAbsR[i2][j] + v3HalfA[i2] * fAbsR[i1][j];
+			fRB = v3HalfB[j1] * fAbsR[i][j2] + v3HalfB[j2] * fAbsR[i][j1];
+			if (glm::abs(fT[i2] * fR[i1][j] - fT[i1] * fR[i2][j]) > fRA + fRB)
+				return false;
+		}
+	}
+
+	// no axis separates them
+	return true;
+}
+void Simplex::MyEntityStore::UpdateGlobalBounds(uint a_uIndex)
+{
+	matrix4 const& m4ToWorld = m_m4ToWorld[a_uIndex];
+
+	//transform the center and project the half extents on the world axes
+	vector3 v3Center = (m_v3MinLocal[a_uIndex] + m_v3MaxLocal[a_uIndex]) * 0.5f;
+	vector3 v3HalfWidth = (m_v3MaxLocal[a_uIndex] - m_v3MinLocal[a_uIndex]) * 0.5f;
+
+	vector3 v3CenterG = vector3(m4ToWorld * vector4(v3Center, 1.0f));
+	vector3 v3HalfWidthG =
+		glm::abs(vector3(m4ToWorld[0])) * v3HalfWidth.x +
+		glm::abs(vector3(m4ToWorld[1])) * v3HalfWidth.y +
+		glm::abs(vector3(m4ToWorld[2])) * v3HalfWidth.z;
+
+	m_v3MinGlobal[a_uIndex] = v3CenterG - v3HalfWidthG;
+	m_v3MaxGlobal[a_uIndex] = v3CenterG + v3HalfWidthG;
+	m_PackedBounds.Set(a_uIndex, m_v3MinGlobal[a_uIndex], m_v3MaxGlobal[a_uIndex]);
+}
+//Raw array access
+vector3 const* Simplex::MyEntityStore::GetPositionArray(void) const { return m_v3Position.data(); }
+quaternion const* Simplex::MyEntityStore::GetRotationArray(void) const { return m_qRotation.data(); }
+EntityLayer const* Simplex::MyEntityStore::GetLayerArray(void) const { return m_eLayer.data(); }
+vector3 const* Simplex::MyEntityStore::GetMinLocalArray(void) const { return m_v3MinLocal.data(); }
+vector3 const* Simplex::MyEntityStore::GetMaxLocalArray(void) const { return m_v3MaxLocal.data(); }
+vector3 const* Simplex::MyEntityStore::GetMinGlobalArray(void) const { return m_v3MinGlobal.data(); }
+vector3 const* Simplex::MyEntityStore::GetMaxGlobalArray(void) const { return m_v3MaxGlobal.data(); }
+matrix4 const* Simplex::MyEntityStore::GetModelMatrixArray(void) const { return m_m4ToWorld.data(); }
+MyPackedBounds const& Simplex::MyEntityStore::GetPackedBounds(void) const { return m_PackedBounds; }
@@ -0,0 +1,142 @@
+/*----------------------------------------------
+Programmer: Team "No Name"
+Date: 2018/04
+----------------------------------------------*/
+#ifndef __MYENTITYSTORE_H_
+#define __MYENTITYSTORE_H_
+
+#include "MyDefinitions.h"
+#include "MyPackedBounds.h"
+
+namespace Simplex
+{
+
+//Structure of arrays holding the per frame (hot) data of every entity, each array is contiguous
+//and addressed by the same dense index, removal swaps the last element into the hole
+class MyEntityStore
+{
+	uint m_uCount = 0; //number of entries in every array
+
+	std::vector<vector3> m_v3Position; //world position of each entry
+	std::vector<quaternion> m_qRotation; //world orientation of each entry
+	std::vector<EntityLayer> m_eLayer; //layer of each entry
+	std::vector<vector3> m_v3MinLocal; //min corner of the model space bounding box
+	std::vector<vector3> m_v3MaxLocal; //max corner of the model space bounding box
+	std::vector<vector3> m_v3MinGlobal; //min corner of the world axis realigned bounding box
+	std::vector<vector3> m_v3MaxGlobal; //max corner of the world axis realigned bounding box
+	std::vector<matrix4> m_m4ToWorld; //model matrix of each entry
+	MyPackedBounds m_PackedBounds; //world bounds again, one array per component for the batched tests
+
+public:
+	/*
+	Usage: Constructor
+	Arguments: ---
+	Output: class object instance
+	*/
+	MyEntityStore(void);
+	/*
+	USAGE: Reserves space in every array to avoid reallocations while adding
+	ARGUMENTS: uint a_uCapacity -> number of entries expected
+	OUTPUT: ---
+	*/
+	void Reserve(uint a_uCapacity);
+	/*
+	USAGE: Adds an entry at the end of the arrays
+	ARGUMENTS:
+	-	EntityLayer a_eLayer -> layer of the entry
+	-	vector3 a_v3MinLocal -> min corner of the model space bounding box
+	-	vector3 a_v3MaxLocal -> max corner of the model space bounding box
+	OUTPUT: dense index of the new entry
+	*/
+	uint Add(EntityLayer a_eLayer, vector3 a_v3MinLocal, vector3 a_v3MaxLocal);
+	/*
+	USAGE: Removes the entry by moving the last one into its slot
+	ARGUMENTS: uint a_uIndex -> dense index of the entry to remove
+	OUTPUT: ---
+	*/
+	void Remove(uint a_uIndex);
+	/*
+	USAGE: Removes every entry
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void Clear(void);
+	/*
+	USAGE: Gets the number of entries
+	ARGUMENTS: ---
+	OUTPUT: number of entries
+	*/
+	uint GetCount(void) const;
+	/*
+	USAGE: Sets the model matrix of the entry, updates position, rotation and world bounds
+	ARGUMENTS:
+	-	uint a_uIndex -> dense index of the entry
+	-	matrix4 const& a_m4ToWorld -> model matrix to set
+	OUTPUT: ---
+	*/
+	void SetModelMatrix(uint a_uIndex, matrix4 const& a_m4ToWorld);
+	/*
+	USAGE: Sets the position and rotation of the entry, rebuilds the model matrix and world bounds
+	ARGUMENTS:
+	-	uint a_uIndex -> dense index of the entry
+	-	vector3 const& a_v3Position -> world position
+	-	quaternion const& a_qRotation -> world orientation
+	OUTPUT: ---
+	*/
+	void SetTransform(uint a_uIndex, vector3 const& a_v3Position, quaternion const& a_qRotation);
+	/*
+	USAGE: Sets the layer of the entry
+	ARGUMENTS:
+	-	uint a_uIndex -> dense index of the entry
+	-	EntityLayer a_eLayer -> layer to set
+	OUTPUT: ---
+	*/
+	void SetLayer(uint a_uIndex, EntityLayer a_eLayer);
+	/*
+	USAGE: Tells if the world bounding boxes of both entries overlap
+	ARGUMENTS:
+	-	uint a_uA -> dense index of the first entry
+	-	uint a_uB -> dense index of the second entry
+	OUTPUT: are the boxes overlapping?
+	*/
+	bool AreBoundsOverlapping(uint a_uA, uint a_uB) const;
+	/*
+	USAGE: Tells if the oriented boxes of both entries overlap, their model space boxes under their
+	model matrices tested on the 15 separating axes; it only reads the store, so pairs can be tested
+	from any thread
+	ARGUMENTS:
+	-	uint a_uA -> dense index of the first entry
+	-	uint a_uB -> dense index of the second entry
+	OUTPUT: are the boxes overlapping?
+	*/
+	bool AreBoxesOverlapping(uint a_uA, uint a_uB) const;
+
+	// Raw array access, valid until the next Add / Remove
+	vector3 const* GetPositionArray(void) const;
+	quaternion const* GetRotationArray(void) const;
+	EntityLayer const* GetLayerArray(void) const;
+	vector3 const* GetMinLocalArray(void) const;
+	vector3 const* GetMaxLocalArray(void) const;
+	vector3 const* GetMinGlobalArray(void) const;
+	vector3 const* GetMaxGlobalArray(void) const;
+	matrix4 const* GetModelMatrixArray(void) const;
+	MyPackedBounds const& GetPackedBounds(void) const;
+
+private:
+	/*
+	USAGE: Recomputes the world bounds of the entry from its local bounds and model matrix
+	ARGUMENTS: uint a_uIndex -> dense index of the entry
+	OUTPUT: ---
+	*/
+	void UpdateGlobalBounds(uint a_uIndex);
+};//class
+
+} //namespace Simplex
+
+#endif //__MYENTITYSTORE_H_
+
+/*
+USAGE:
+ARGUMENTS: ---
+OUTPUT: ---
+*/
@@ -0,0 +1,62 @@
+#include "MyFixedTimestep.h"
+#include <chrono>
+#include <cmath>
+using namespace Simplex;
+//  MyFixedTimestep
+Simplex::MyFixedTimestep::MyFixedTimestep(float a_fStep, uint a_uMaxSteps)
+{
+	SetStep(a_fStep);
+	m_uMaxSteps = a_uMaxSteps > 0 ? a_uMaxSteps : 1;
+}
+long long Simplex::MyFixedTimestep::GetTimeNanoseconds(void)
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+float Simplex::MyFixedTimestep::Tick(void)
+{
+	long long nCurrentTime = GetTimeNanoseconds();
+	if (m_nLastTime < 0)
+		m_nLastTime = nCurrentTime;
+
+	//the difference is taken in double, a float of nanoseconds would lose the small frames
+	double dElapsed = (nCurrentTime - m_nLastTime) / 1e9;
+	m_nLastTime = nCurrentTime;
+
+	m_fFrameTime = static_cast<float>(dElapsed < m_fMaxFrameTime ? dElapsed : m_fMaxFrameTime);
+	return m_fFrameTime;
+}
+uint Simplex::MyFixedTimestep::Advance(float a_fElapsed)
+{
+	if (a_fElapsed > 0.0f)
+		m_dAccumulator += a_fElapsed;
+
+	m_uStepCount = static_cast<uint>(m_dAccumulator / m_fStep);
+	if (m_uStepCount > m_uMaxSteps)
+	{
+		//too far behind to catch up, the simulation slows down instead of falling further back
+		m_uStepCount = m_uMaxSteps;
+		m_dAccumulator = std::fmod(m_dAccumulator, static_cast<double>(m_fStep));
+	}
+	else
+	{
+		m_dAccumulator -= m_uStepCount * static_cast<double>(m_fStep);
+	}
+	return m_uStepCount;
+}
+float Simplex::MyFixedTimestep::GetAlpha(void) const
+{
+	float fAlpha = static_cast<float>(m_dAccumulator / m_fStep);
+	return fAlpha < 1.0f ? fAlpha : 1.0f;
+}
+void Simplex::MyFixedTimestep::Reset(void)
+{
+	m_dAccumulator = 0.0;
+	m_nLastTime = -1;
+	m_fFrameTime = 0.0f;
+	m_uStepCount = 0;
+}
+void Simplex::MyFixedTimestep::SetStep(float a_fStep) { m_fStep = a_fStep > 0.001f ? a_fStep : 0.001f; }
+float Simplex::MyFixedTimestep::GetStep(void) const { return m_fStep; }
+float Simplex::MyFixedTimestep::GetFrameTime(void) const { return m_fFrameTime; }
+uint Simplex::MyFixedTimestep::GetStepCount(void) const { return m_uStepCount; }
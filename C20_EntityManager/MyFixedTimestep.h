@@ -0,0 +1,95 @@
+/*----------------------------------------------
+Programmer: Team "No Name"
+Date: 2018/04
+----------------------------------------------*/
+#ifndef __MYFIXEDTIMESTEP_H_
+#define __MYFIXEDTIMESTEP_H_
+
+#include "MyDefinitions.h"
+
+namespace Simplex
+{
+
+//Splits the real time between frames into simulation steps of a fixed length. The time that does
+//not make a whole step is carried to the next frame, and how far it got into the next step is the
+//factor to interpolate the rendered state between the last two steps. Time is read from the steady
+//clock in nanoseconds, the system clock of the framework only moves every 10 to 16 ms.
+class MyFixedTimestep
+{
+	float m_fStep = 1.0f / 60.0f; //seconds simulated by each step
+	uint m_uMaxSteps = 5; //steps a frame can ask for, the time past that is dropped
+	float m_fMaxFrameTime = 0.25f; //longest frame measured, a stall does not turn into a burst of steps
+	double m_dAccumulator = 0.0; //seconds measured but not simulated yet
+	long long m_nLastTime = -1; //time of the last tick in nanoseconds, -1 before the first
+	float m_fFrameTime = 0.0f; //seconds measured by the last tick
+	uint m_uStepCount = 0; //steps asked for by the last advance
+
+public:
+	/*
+	Usage: Constructor
+	Arguments:
+	-	float a_fStep = 1.0f / 60.0f -> seconds simulated by each step
+	-	uint a_uMaxSteps = 5 -> steps a frame can ask for
+	Output: class object instance
+	*/
+	MyFixedTimestep(float a_fStep = 1.0f / 60.0f, uint a_uMaxSteps = 5);
+	/*
+	USAGE: Reads the steady clock
+	ARGUMENTS: ---
+	OUTPUT: nanoseconds since an arbitrary point, never goes back
+	*/
+	static long long GetTimeNanoseconds(void);
+	/*
+	USAGE: Measures the time since the last tick, the first one measures nothing
+	ARGUMENTS: ---
+	OUTPUT: seconds since the last tick, capped to the longest frame
+	*/
+	float Tick(void);
+	/*
+	USAGE: Adds time to simulate and takes out the whole steps it makes
+	ARGUMENTS: float a_fElapsed -> seconds to add, from Tick or a fixed value when replaying
+	OUTPUT: number of steps to run now
+	*/
+	uint Advance(float a_fElapsed);
+	/*
+	USAGE: Gets how far the time left is into the next step, the factor to blend the state before
+	the last step into the state after it; what is rendered is up to a step behind
+	ARGUMENTS: ---
+	OUTPUT: factor from 0 (state before the last step) to 1 (state after it)
+	*/
+	float GetAlpha(void) const;
+	/*
+	USAGE: Drops the time left and starts measuring again from the next tick
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void Reset(void);
+	/*
+	USAGE: Sets the seconds simulated by each step
+	ARGUMENTS: float a_fStep -> seconds, clamped to a millisecond at least
+	OUTPUT: ---
+	*/
+	void SetStep(float a_fStep);
+	/*
+	USAGE: Gets the seconds simulated by each step
+	ARGUMENTS: ---
+	OUTPUT: seconds
+	*/
+	float GetStep(void) const;
+	/*
+	USAGE: Gets the seconds measured by the last tick
+	ARGUMENTS: ---
+	OUTPUT: seconds
+	*/
+	float GetFrameTime(void) const;
+	/*
+	USAGE: Gets the steps asked for by the last advance
+	ARGUMENTS: ---
+	OUTPUT: steps
+	*/
+	uint GetStepCount(void) const;
+};
+
+}//namespace Simplex
+
+#endif //__MYFIXEDTIMESTEP_H_
@@ -0,0 +1,48 @@
+#include "MyFrustum.h"
+using namespace Simplex;
+//  MyFrustum
+Simplex::MyFrustum::MyFrustum(void)
+{
+	for (uint i = 0; i < PlaneCount; ++i)
+		m_v4Plane[i] = vector4(0.0f, 0.0f, 0.0f, 1.0f);
+}
+Simplex::MyFrustum::MyFrustum(matrix4 const& a_m4ViewProjection) { Set(a_m4ViewProjection); }
+void Simplex::MyFrustum::Set(matrix4 const& a_m4ViewProjection)
+{
+	//a point is inside when -w <= x, y, z <= w in clip space, each side of that is a row plus or
+	//minus the last one; glm keeps the matrix by columns so the rows are read across them
+	vector4 v4Row[4];
+	for (uint r = 0; r < 4; ++r)
+		v4Row[r] = vector4(a_m4ViewProjection[0][r], a_m4ViewProjection[1][r], a_m4ViewProjection[2][r], a_m4ViewProjection[3][r]);
+
+	m_v4Plane[Left] = v4Row[3] + v4Row[0];
+	m_v4Plane[Right] = v4Row[3] - v4Row[0];
+	m_v4Plane[Bottom] = v4Row[3] + v4Row[1];
+	m_v4Plane[Top] = v4Row[3] - v4Row[1];
+	m_v4Plane[Near] = v4Row[3] + v4Row[2];
+	m_v4Plane[Far] = v4Row[3] - v4Row[2];
+
+	//normalized so the distance is in world units
+	for (uint i = 0; i < PlaneCount; ++i)
+	{
+		float fLength = glm::length(vector3(m_v4Plane[i]));
+		if (fLength > 0.0f)
+			m_v4Plane[i] /= fLength;
+	}
+}
+vector4 const& Simplex::MyFrustum::GetPlane(Plane a_ePlane) const { return m_v4Plane[a_ePlane]; }
+bool Simplex::MyFrustum::TestBox(vector3 const& a_v3Min, vector3 const& a_v3Max) const
+{
+	for (uint i = 0; i < PlaneCount; ++i)
+	{
+		//the corner furthest along the normal is the last one to leave the plane
+		vector4 const& v4Plane = m_v4Plane[i];
+		vector3 v3Corner(
+			v4Plane.x > 0.0f ? a_v3Max.x : a_v3Min.x,
+			v4Plane.y > 0.0f ? a_v3Max.y : a_v3Min.y,
+			v4Plane.z > 0.0f ? a_v3Max.z : a_v3Min.z);
+		if (glm::dot(vector3(v4Plane), v3Corner) + v4Plane.w < 0.0f)
+			return false;
+	}
+	return true;
+}
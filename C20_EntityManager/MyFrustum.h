@@ -0,0 +1,77 @@
+/*----------------------------------------------
+Programmer: Team "No Name"
+Date: 2018/04
+----------------------------------------------*/
+#ifndef __MYFRUSTUM_H_
+#define __MYFRUSTUM_H_
+
+#include "MyDefinitions.h"
+
+namespace Simplex
+{
+
+//The six planes bounding what a camera sees, taken from its view projection matrix. Each plane is
+//(normal, distance) with the normal pointing inside, a point is in front of it when the dot product
+//plus the distance is not negative.
+class MyFrustum
+{
+public:
+	//Planes in the order they are stored
+	enum Plane
+	{
+		Left,
+		Right,
+		Bottom,
+		Top,
+		Near,
+		Far,
+		PlaneCount
+	};
+
+private:
+	vector4 m_v4Plane[PlaneCount]; //normal in xyz and distance in w, normalized
+
+public:
+	/*
+	Usage: Constructor, a frustum that keeps everything
+	Arguments: ---
+	Output: class object instance
+	*/
+	MyFrustum(void);
+	/*
+	Usage: Constructor
+	Arguments: matrix4 const& a_m4ViewProjection -> projection times view of the camera
+	Output: class object instance
+	*/
+	MyFrustum(matrix4 const& a_m4ViewProjection);
+	/*
+	USAGE: Takes the planes from a view projection matrix, clip space is the one of OpenGL
+	ARGUMENTS: matrix4 const& a_m4ViewProjection -> projection times view of the camera
+	OUTPUT: ---
+	*/
+	void Set(matrix4 const& a_m4ViewProjection);
+	/*
+	USAGE: Gets a plane
+	ARGUMENTS: Plane a_ePlane -> plane queried
+	OUTPUT: normal pointing inside in xyz, distance in w
+	*/
+	vector4 const& GetPlane(Plane a_ePlane) const;
+	/*
+	USAGE: Tells if a box is at least partly inside, boxes near a corner outside of it can still pass
+	ARGUMENTS:
+	-	vector3 const& a_v3Min -> min corner of the box
+	-	vector3 const& a_v3Max -> max corner of the box
+	OUTPUT: is it visible?
+	*/
+	bool TestBox(vector3 const& a_v3Min, vector3 const& a_v3Max) const;
+};//class
+
+} //namespace Simplex
+
+#endif //__MYFRUSTUM_H_
+
+/*
+USAGE:
+ARGUMENTS: ---
+OUTPUT: ---
+*/
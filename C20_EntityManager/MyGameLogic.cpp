@@ -0,0 +1,295 @@
+#include "MyGameLogic.h"
+#include "MyProfiler.h"
+#include <glm/gtx/transform.hpp>
+using namespace Simplex;
+//  MyGameLogic
+Simplex::MyGameLogic::MyGameLogic(uint a_uSeed)
+{
+	m_Random.seed(a_uSeed);
+
+	// The player only cares about obstacles
+	m_PlayerFilter = EntityLayerFilter(false);
+	m_PlayerFilter.Set(EntityLayer::Player, EntityLayer::Obstacle);
+}
+Simplex::MyGameLogic::MyGameLogic(MyGameLogic const& other) { }
+MyGameLogic& Simplex::MyGameLogic::operator=(MyGameLogic const& other) { return *this; }
+Simplex::MyGameLogic::~MyGameLogic(void)
+{
+	if (m_pOctree != nullptr)
+	{
+		delete m_pOctree;
+		m_pOctree = nullptr;
+	}
+	if (m_pGrid != nullptr)
+	{
+		delete m_pGrid;
+		m_pGrid = nullptr;
+	}
+}
+uint Simplex::MyGameLogic::AddLaneObject(Lane a_eLane)
+{
+	uint uIndex = static_cast<uint>(m_lLane[a_eLane].size());
+	m_lLane[a_eLane].push_back(LaneObject());
+	PlaceLaneObject(a_eLane, uIndex);
+	return uIndex;
+}
+uint Simplex::MyGameLogic::GetLaneCount(Lane a_eLane) const { return static_cast<uint>(m_lLane[a_eLane].size()); }
+void Simplex::MyGameLogic::PlaceLaneObject(Lane a_eLane, uint a_uIndex)
+{
+	LaneObject& object = m_lLane[a_eLane][a_uIndex];
+	object.m_v3Position = vector3(GenerateRandomLaneX(), 0.f, -20.0f - (m_fSpacing[a_eLane] * a_uIndex));
+	object.m_v3PrevPosition = object.m_v3Position;
+}
+void Simplex::MyGameLogic::Restart(void)
+{
+	for (uint l = 0; l < LaneCount; ++l)
+	{
+		for (uint i = 0; i < m_lLane[l].size(); ++i)
+			PlaceLaneObject(static_cast<Lane>(l), i);
+	}
+
+	m_fPlayerInputHeld = 0.0f;
+	m_fPlayerInputDirection = 0.0f;
+	m_v3PlayerVelo = vector3(0.0f);
+	m_v3PlayerPos = vector3(0.0f);
+	m_fPlayerRotY = 180;
+	m_v3PlayerPrevPos = m_v3PlayerPos;
+	m_fPlayerPrevRotY = m_fPlayerRotY;
+}
+void Simplex::MyGameLogic::MovePlayer(float a_fDirection) { m_fPlayerInputHeld = a_fDirection; }
+void Simplex::MyGameLogic::JumpPlayer(void)
+{
+	if (m_bIsPlayerOnGround)
+		m_v3PlayerVelo.y = m_fPlayerJumpVelo;
+}
+void Simplex::MyGameLogic::UpdatePlayer(float a_fDeltaTime, bool a_bColliding)
+{
+	MY_PROFILE_FUNCTION();
+	// keep where the player was for the interpolation
+	m_v3PlayerPrevPos = m_v3PlayerPos;
+	m_fPlayerPrevRotY = m_fPlayerRotY;
+
+	if (a_bColliding)
+	{
+		m_v3PlayerPos.z += m_fSpeed * a_fDeltaTime;
+		if (m_fPlayerRotY < 270)
+		{
+			m_fPlayerRotY += 20.0f;
+		}
+	}
+	else
+	{
+		//rotate the player back
+		if (m_fPlayerRotY > 180)
+		{
+			m_fPlayerRotY -= 20.0f;
+		}
+		// the input held is added once a step, so it pushes and fades the same at any frame rate
+		m_fPlayerInputDirection += m_fPlayerInputHeld;
+
+		// update player velocity from input
+		m_v3PlayerVelo.x = m_fPlayerInputDirection * m_fPlayerHorizSpeed;
+
+		// update player position from velocity
+		m_v3PlayerPos += m_v3PlayerVelo * a_fDeltaTime;
+
+		// clamp player to ground
+		if (m_v3PlayerPos.y < 0)
+			m_v3PlayerPos.y = 0;
+
+		// check if player is on ground
+		m_bIsPlayerOnGround = m_v3PlayerPos.y == 0;
+
+		// clamp player x to lane bounds
+		if (m_v3PlayerPos.x > LANE_X_MAX)
+		{
+			m_v3PlayerPos.x = LANE_X_MAX;
+			m_fPlayerInputDirection = 0.0f;
+		}
+		else if (m_v3PlayerPos.x < LANE_X_MIN)
+		{
+			m_v3PlayerPos.x = LANE_X_MIN;
+			m_fPlayerInputDirection = 0.0f;
+		}
+		else
+		{
+			m_fPlayerInputDirection *= m_fPlayerInputDampening;
+		}
+	}
+
+	// apply gravity to player velo
+	m_v3PlayerVelo += m_v3Gravity * a_fDeltaTime;
+}
+void Simplex::MyGameLogic::UpdateLanes(float a_fDeltaTime)
+{
+	MY_PROFILE_FUNCTION();
+	for (uint l = 0; l < LaneCount; ++l)
+	{
+		std::vector<LaneObject>::iterator it;
+		for (it = m_lLane[l].begin(); it != m_lLane[l].end(); ++it)
+		{
+			// Add to this position
+			it->m_v3PrevPosition = it->m_v3Position;
+			it->m_fPrevRotY = it->m_fRotY;
+			it->m_v3Position.z += m_fSpeed * a_fDeltaTime;
+
+			// Check if we need to reset this object
+			if (it->m_v3Position.z >= OBSTACLE_Z_MAX)
+			{
+				it->m_v3Position.z = OBSTACLE_Z_START;
+				// Put the X in a random position inside the lanes
+				it->m_v3Position.x = GenerateRandomLaneX();
+				// Do not interpolate the jump back to the start
+				it->m_v3PrevPosition = it->m_v3Position;
+			}
+			// the coins spin, each one a degree further than the one before
+			if (l == Coins)
+			{
+				m_fCoinRotY += 1.0f;
+				it->m_fRotY = m_fCoinRotY;
+			}
+		}
+	}
+}
+bool Simplex::MyGameLogic::IsPlayerOffScreen(void) const { return m_v3PlayerPos.z > 5.0f; }
+matrix4 Simplex::MyGameLogic::GetPlayerMatrix(float a_fAlpha) const
+{
+	vector3 v3Position = glm::mix(m_v3PlayerPrevPos, m_v3PlayerPos, a_fAlpha);
+	float fRotY = glm::mix(m_fPlayerPrevRotY, m_fPlayerRotY, a_fAlpha);
+	return glm::translate(v3Position) * glm::rotate(IDENTITY_M4, fRotY, vector3(0.0f, 1.0f, 0.0f));
+}
+matrix4 Simplex::MyGameLogic::GetLaneMatrix(Lane a_eLane, uint a_uIndex, float a_fAlpha) const
+{
+	LaneObject const& object = m_lLane[a_eLane][a_uIndex];
+	vector3 v3Position = glm::mix(object.m_v3PrevPosition, object.m_v3Position, a_fAlpha);
+	float fRotY = glm::mix(object.m_fPrevRotY, object.m_fRotY, a_fAlpha);
+	return glm::translate(v3Position) * glm::rotate(IDENTITY_M4, fRotY, vector3(0.0f, 1.0f, 0.0f));
+}
+void Simplex::MyGameLogic::BuildBroadphase(MyEntityStore const& a_Store)
+{
+	if (a_Store.GetCount() == 0)
+		return;
+
+	// Octree around everything where it is now
+	vector3 const* pMin = a_Store.GetMinGlobalArray();
+	vector3 const* pMax = a_Store.GetMaxGlobalArray();
+	vector3 v3Min = pMin[0];
+	vector3 v3Max = pMax[0];
+	for (uint i = 1; i < a_Store.GetCount(); ++i)
+	{
+		v3Min = (glm::min)(v3Min, pMin[i]);
+		v3Max = (glm::max)(v3Max, pMax[i]);
+	}
+	vector3 v3HalfSize = (v3Max - v3Min) * 0.5f;
+	float fHalfSize = v3HalfSize.x > v3HalfSize.y ? v3HalfSize.x : v3HalfSize.y;
+	fHalfSize = (fHalfSize > v3HalfSize.z ? fHalfSize : v3HalfSize.z) + 1.0f;
+
+	// Go down until the cells are about the size of a cow
+	uint uDepth = 0;
+	for (float fCell = fHalfSize; fCell > m_fOctreeLeafSize && uDepth < 16; fCell *= 0.5f)
+		++uDepth;
+
+	if (m_pOctree != nullptr)
+		delete m_pOctree;
+	m_pOctree = new MyLooseOctree((v3Min + v3Max) * 0.5f, fHalfSize, uDepth);
+	m_pOctree->Refit(pMin, pMax, a_Store.GetCount());
+
+	// The grid does not need to know the size of the world
+	if (m_pGrid != nullptr)
+		delete m_pGrid;
+	m_pGrid = new MySpatialGrid(m_fGridCellSize);
+	m_pGrid->Update(pMin, pMax, a_Store.GetCount());
+	m_SweepAndPrune.Update(pMin, pMax, a_Store.GetLayerArray(), a_Store.GetCount());
+}
+void Simplex::MyGameLogic::UpdateBroadphase(MyEntityStore const& a_Store, Broadphase a_eBroadphase)
+{
+	MY_PROFILE_FUNCTION();
+	vector3 const* pMin = a_Store.GetMinGlobalArray();
+	vector3 const* pMax = a_Store.GetMaxGlobalArray();
+	switch (a_eBroadphase)
+	{
+	case LooseOctree:
+		// Refit the octree in place, only the entities that left the loose bounds
+		// of their node get relinked, so there is no need to rebuild it every frame
+		if (m_pOctree != nullptr)
+			m_pOctree->Refit(pMin, pMax, a_Store.GetCount());
+		break;
+	case SpatialGrid:
+		// Only the entities whose center changed cell get relinked
+		if (m_pGrid != nullptr)
+			m_pGrid->Update(pMin, pMax, a_Store.GetCount());
+		break;
+	case SweepAndPrune:
+		// The order from last frame is almost sorted, the sort is close to linear
+		m_SweepAndPrune.Update(pMin, pMax, a_Store.GetLayerArray(), a_Store.GetCount());
+		break;
+	default:
+		// the store keeps the packed bounds in sync, there is nothing to update
+		break;
+	}
+}
+uint Simplex::MyGameLogic::FindPlayerPairs(MyEntityStore const& a_Store, uint a_uPlayer, Broadphase a_eBroadphase,
+	std::vector<std::pair<uint, uint>>& a_lPair)
+{
+	MY_PROFILE_FUNCTION();
+	vector3 const* pMin = a_Store.GetMinGlobalArray();
+	vector3 const* pMax = a_Store.GetMaxGlobalArray();
+	EntityLayer const* pLayer = a_Store.GetLayerArray();
+
+	// Only the entities whose box overlaps the player's reach the narrow phase
+	m_lHits.clear();
+	switch (a_eBroadphase)
+	{
+	case LooseOctree:
+		if (m_pOctree != nullptr)
+			m_pOctree->Query(pMin[a_uPlayer], pMax[a_uPlayer], m_lHits);
+		break;
+	case SpatialGrid:
+		if (m_pGrid != nullptr)
+			m_pGrid->Query(pMin[a_uPlayer], pMax[a_uPlayer], m_lHits);
+		break;
+	case SweepAndPrune:
+		// the layers are left out below, as for the others, so every broadphase counts the same hits
+		m_SweepAndPrune.Query(pMin[a_uPlayer], pMax[a_uPlayer], EntityLayer::Player, m_lHits);
+		break;
+	default:
+		// No structure to keep up, test the player's box against every entity 4 or 8 at a time
+		a_Store.GetPackedBounds().QueryBox(pMin[a_uPlayer], pMax[a_uPlayer], m_lHits);
+		break;
+	}
+
+	a_lPair.clear();
+	for (uint i = 0; i < m_lHits.size(); ++i)
+	{
+		uint uEntity = m_lHits[i];
+		// Only obstacles stop the player
+		if (!m_PlayerFilter.Test(EntityLayer::Player, pLayer[uEntity]))
+			continue;
+		a_lPair.push_back(std::pair<uint, uint>(a_uPlayer, uEntity));
+	}
+	return static_cast<uint>(m_lHits.size());
+}
+uint Simplex::MyGameLogic::FindPairs(std::vector<std::pair<uint, uint>>& a_lPair)
+{
+	return m_SweepAndPrune.FindPairs(a_lPair);
+}
+bool Simplex::MyGameLogic::IsPlayerHit(std::vector<std::pair<uint, uint>> const& a_lPair, std::vector<uint> const& a_lColliding,
+	EntityLayer const* a_pLayer, uint a_uPlayer)
+{
+	for (uint p = 0; p < a_lPair.size() && p < a_lColliding.size(); ++p)
+	{
+		uint i = a_lPair[p].first;
+		uint j = a_lPair[p].second;
+		// the player against an obstacle, the rest of the pairs do not push it
+		if (a_lColliding[p] != 0 &&
+			(a_pLayer[i] == EntityLayer::Obstacle || a_pLayer[j] == EntityLayer::Obstacle) &&
+			(i == a_uPlayer || j == a_uPlayer))
+			return true;
+	}
+	return false;
+}
+float Simplex::MyGameLogic::GenerateRandomLaneX(void)
+{
+	std::uniform_real_distribution<float> distribution(LANE_X_MIN, LANE_X_MAX);
+	return distribution(m_Random);
+}
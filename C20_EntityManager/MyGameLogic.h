@@ -0,0 +1,248 @@
+/*----------------------------------------------
+Programmer: Team "No Name"
+Date: 2018/04
+----------------------------------------------*/
+#ifndef __MYGAMELOGIC_H_
+#define __MYGAMELOGIC_H_
+
+#include "MyDefinitions.h"
+#include "MyEntityStore.h"
+#include "MyLooseOctree.h"
+#include "MySpatialGrid.h"
+#include "MySweepAndPrune.h"
+#include <random>
+
+namespace Simplex
+{
+
+//The rules of the game: the player's physics, the lanes of obstacles and coins moving towards it
+//and the broadphases that find what the player runs into. It only keeps positions and reads the
+//bounds of the entity store, the Application and the headless simulation keep the entities and
+//write the matrices it hands out, so both play the same game.
+class MyGameLogic
+{
+public:
+	// Broadphase used for the player's collisions
+	enum Broadphase
+	{
+		LooseOctree,
+		SpatialGrid,
+		SweepAndPrune,
+		PackedScan,
+		BroadphaseCount
+	};
+
+	// Lanes of objects moving towards the player
+	enum Lane
+	{
+		Obstacles,
+		Coins,
+		LaneCount
+	};
+
+private:
+	// An object moving down the lanes towards the player
+	struct LaneObject
+	{
+		vector3 m_v3Position; // current world position
+		float m_fRotY = 90.0f; // current rotation around Y
+		vector3 m_v3PrevPosition; // position before the last step
+		float m_fPrevRotY = 90.0f; // rotation before the last step
+	};
+
+	// Random numbers of the lanes, the simulation can run on any thread and rand() is per thread
+	std::mt19937 m_Random;
+
+	// Physics
+	vector3 m_v3Gravity = vector3(0.0f, -9.8f, 0.0f);
+
+	// Player
+	vector3 m_v3PlayerPos = vector3(0.0f, 0.0f, 0.0f);
+	vector3 m_v3PlayerVelo = vector3(0.0f);
+	float m_fPlayerHorizSpeed = 1.0f;
+	float m_fPlayerInputHeld = 0.0f; // direction (+/-) held down, every step adds it to the input direction
+	float m_fPlayerInputDirection = 0.0f; // what direction (+/-) the player should be moving in, based on input
+	float m_fPlayerInputDampening = 0.86f; // the closer to 1, the slipperier the player feels
+	float m_fPlayerJumpVelo = 5.6f; // instantaneous y velocity applied when player jumps
+	bool m_bIsPlayerOnGround = false; // whether or not the player is on the ground
+	// don't need a quat, b/c player won't be doing much rotating (if any)
+	float m_fPlayerRotY = 180.0f;
+	// state of the player before the last step, rendering blends it into the current one
+	vector3 m_v3PlayerPrevPos = vector3(0.0f);
+	float m_fPlayerPrevRotY = 180.0f;
+
+	// Lanes
+	std::vector<LaneObject> m_lLane[LaneCount];
+	float m_fSpacing[LaneCount] = { 10.0f, 5.0f }; // distance between the objects of each lane at the start
+	float m_fSpeed = 10.f;
+	float m_fCoinRotY = 0.0f;
+
+	// Broadphases
+	MyLooseOctree* m_pOctree = nullptr; // refit every step
+	float m_fOctreeLeafSize = 2.0f; // half size the deepest cells of the octree get to
+	MySpatialGrid* m_pGrid = nullptr; // relinks the entities that changed cell
+	float m_fGridCellSize = 2.0f; // side of the cells of the grid
+	MySweepAndPrune m_SweepAndPrune; // sorted along Z
+	EntityLayerFilter m_PlayerFilter; // layers the player collides with
+	std::vector<uint> m_lHits; // entities found by the last query, kept to reuse its memory
+
+public:
+	/*
+	Usage: Constructor
+	Arguments: uint a_uSeed -> seed of the lanes
+	Output: class object instance
+	*/
+	MyGameLogic(uint a_uSeed);
+	/*
+	Usage: Destructor
+	Arguments: ---
+	Output: ---
+	*/
+	~MyGameLogic(void);
+	/*
+	USAGE: Adds an object at the end of a lane, behind the ones it has
+	ARGUMENTS: Lane a_eLane -> lane
+	OUTPUT: index of the object in the lane
+	*/
+	uint AddLaneObject(Lane a_eLane);
+	/*
+	USAGE: Gets the number of objects of a lane
+	ARGUMENTS: Lane a_eLane -> lane
+	OUTPUT: objects
+	*/
+	uint GetLaneCount(Lane a_eLane) const;
+	/*
+	USAGE: Puts the lanes and the player back at the start
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void Restart(void);
+	/*
+	USAGE: Sets the direction held down, each step pushes the player that way until it changes; once
+	released the push fades. Set it every frame, the steps of a frame share it
+	ARGUMENTS: float a_fDirection -> +1 right, -1 left, 0 none
+	OUTPUT: ---
+	*/
+	void MovePlayer(float a_fDirection);
+	/*
+	USAGE: Makes the player jump if it is on the ground
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void JumpPlayer(void);
+	/*
+	USAGE: Moves the player, pushed back if it collides
+	ARGUMENTS:
+	-	float a_fDeltaTime -> seconds of the step
+	-	bool a_bColliding -> is the player colliding with an obstacle?
+	OUTPUT: ---
+	*/
+	void UpdatePlayer(float a_fDeltaTime, bool a_bColliding);
+	/*
+	USAGE: Moves the obstacles and coins towards the player, recycling the ones that passed it
+	ARGUMENTS: float a_fDeltaTime -> seconds of the step
+	OUTPUT: ---
+	*/
+	void UpdateLanes(float a_fDeltaTime);
+	/*
+	USAGE: Tells if the player was pushed off the screen, which ends the game
+	ARGUMENTS: ---
+	OUTPUT: is it off the screen?
+	*/
+	bool IsPlayerOffScreen(void) const;
+	/*
+	USAGE: Gets the model matrix of the player
+	ARGUMENTS: float a_fAlpha = 1.0f -> how far between the last two steps, 1 is the last one
+	OUTPUT: model matrix
+	*/
+	matrix4 GetPlayerMatrix(float a_fAlpha = 1.0f) const;
+	/*
+	USAGE: Gets the model matrix of an object of a lane
+	ARGUMENTS:
+	-	Lane a_eLane -> lane
+	-	uint a_uIndex -> index of the object in the lane
+	-	float a_fAlpha = 1.0f -> how far between the last two steps, 1 is the last one
+	OUTPUT: model matrix
+	*/
+	matrix4 GetLaneMatrix(Lane a_eLane, uint a_uIndex, float a_fAlpha = 1.0f) const;
+	/*
+	USAGE: Creates the broadphases around every entity of the store where it is now
+	ARGUMENTS: MyEntityStore const& a_Store -> entities of the game
+	OUTPUT: ---
+	*/
+	void BuildBroadphase(MyEntityStore const& a_Store);
+	/*
+	USAGE: Updates a broadphase with the bounds the entities have now
+	ARGUMENTS:
+	-	MyEntityStore const& a_Store -> entities of the game
+	-	Broadphase a_eBroadphase -> broadphase to update
+	OUTPUT: ---
+	*/
+	void UpdateBroadphase(MyEntityStore const& a_Store, Broadphase a_eBroadphase);
+	/*
+	USAGE: Queries a broadphase for the player, pairing it with the obstacles it finds
+	ARGUMENTS:
+	-	MyEntityStore const& a_Store -> entities of the game
+	-	uint a_uPlayer -> index of the player in the store
+	-	Broadphase a_eBroadphase -> broadphase to query, updated beforehand
+	-	std::vector<std::pair<uint, uint>>& a_lPair -> pairs of the player and the obstacles, cleared first
+	OUTPUT: entities the broadphase found, before leaving out the ones the player does not collide with
+	*/
+	uint FindPlayerPairs(MyEntityStore const& a_Store, uint a_uPlayer, Broadphase a_eBroadphase,
+		std::vector<std::pair<uint, uint>>& a_lPair);
+	/*
+	USAGE: Finds every pair whose bounds overlap with the sweep and prune, updated beforehand
+	ARGUMENTS: std::vector<std::pair<uint, uint>>& a_lPair -> pairs found, cleared first
+	OUTPUT: pairs found
+	*/
+	uint FindPairs(std::vector<std::pair<uint, uint>>& a_lPair);
+	/*
+	USAGE: Tells if any of the pairs tested has the player colliding with an obstacle
+	ARGUMENTS:
+	-	std::vector<std::pair<uint, uint>> const& a_lPair -> pairs tested
+	-	std::vector<uint> const& a_lColliding -> 1 for the pairs colliding, 0 for the rest
+	-	EntityLayer const* a_pLayer -> layers of the store
+	-	uint a_uPlayer -> index of the player in the store
+	OUTPUT: is the player colliding with an obstacle?
+	*/
+	static bool IsPlayerHit(std::vector<std::pair<uint, uint>> const& a_lPair, std::vector<uint> const& a_lColliding,
+		EntityLayer const* a_pLayer, uint a_uPlayer);
+
+private:
+	/*
+	Usage: Copy Constructor
+	Arguments: class object to copy
+	Output: class object instance
+	*/
+	MyGameLogic(MyGameLogic const& other);
+	/*
+	Usage: Copy Assignment Operator
+	Arguments: class object to copy
+	Output: ---
+	*/
+	MyGameLogic& operator=(MyGameLogic const& other);
+	/*
+	USAGE: Puts an object of a lane where it starts, the further back the later it was added
+	ARGUMENTS:
+	-	Lane a_eLane -> lane
+	-	uint a_uIndex -> index of the object in the lane
+	OUTPUT: ---
+	*/
+	void PlaceLaneObject(Lane a_eLane, uint a_uIndex);
+	/*
+	USAGE: Create a random X value between the lanes
+	ARGUMENTS: ---
+	OUTPUT: x between the min and max lane values
+	*/
+	float GenerateRandomLaneX(void);
+};
+
+}//namespace Simplex
+
+#endif //__MYGAMELOGIC_H_
+
+/*
+USAGE:
+ARGUMENTS: ---
+OUTPUT: ---
+*/
@@ -0,0 +1,192 @@
+#include "MyHeadlessSim.h"
+#include "MyProfiler.h"
+#include "MyJobSystem.h"
+#include <fstream>
+#include <cstdlib>
+using namespace Simplex;
+//  MyHeadlessSim
+Simplex::MyHeadlessSim::MyHeadlessSim(Config const& a_Config) : m_GameLogic(a_Config.m_uSeed)
+{
+	m_Config = a_Config;
+	m_Random.seed(m_Config.m_uSeed);
+
+	// Bounds of the models, a unit box for the ones that cannot be read
+	String sModel[3] = { "Pig.obj", "Cow.obj", "Coin.obj" };
+	vector3 v3Min[3];
+	vector3 v3Max[3];
+	m_Result.m_bModels = true;
+	for (uint i = 0; i < 3; ++i)
+	{
+		if (!ReadOBJBounds(m_Config.m_sModelFolder + sModel[i], v3Min[i], v3Max[i]))
+		{
+			v3Min[i] = vector3(-0.5f, 0.0f, -0.5f);
+			v3Max[i] = vector3(0.5f, 1.0f, 0.5f);
+			m_Result.m_bModels = false;
+		}
+	}
+
+	// Same entities in the same order as the Application
+	m_Store.Reserve(1 + m_Config.m_uObstacles + m_Config.m_uCoins);
+	m_uPlayer = m_Store.Add(EntityLayer::Player, v3Min[0], v3Max[0]);
+	GenerateObjects(MyGameLogic::Obstacles, m_Config.m_uObstacles, EntityLayer::Obstacle, v3Min[1], v3Max[1]);
+	GenerateObjects(MyGameLogic::Coins, m_Config.m_uCoins, EntityLayer::Coin, v3Min[2], v3Max[2]);
+	m_Store.SetModelMatrix(m_uPlayer, m_GameLogic.GetPlayerMatrix());
+	UpdateLaneMatrices();
+
+	// Broadphases around everything where it spawned
+	m_GameLogic.BuildBroadphase(m_Store);
+
+	m_Result.m_uEntities = m_Store.GetCount();
+}
+Simplex::MyHeadlessSim::MyHeadlessSim(MyHeadlessSim const& other) : m_GameLogic(other.m_Config.m_uSeed) { }
+MyHeadlessSim& Simplex::MyHeadlessSim::operator=(MyHeadlessSim const& other) { return *this; }
+Simplex::MyHeadlessSim::~MyHeadlessSim(void) { }
+void Simplex::MyHeadlessSim::GenerateObjects(MyGameLogic::Lane a_eLane, uint a_uAmount, EntityLayer a_eLayer,
+	vector3 const& a_v3Min, vector3 const& a_v3Max)
+{
+	m_lLaneEntity[a_eLane].reserve(a_uAmount);
+	for (uint i = 0; i < a_uAmount; ++i)
+	{
+		m_lLaneEntity[a_eLane].push_back(m_Store.Add(a_eLayer, a_v3Min, a_v3Max));
+		m_GameLogic.AddLaneObject(a_eLane);
+	}
+}
+MyHeadlessSim::Result const& Simplex::MyHeadlessSim::Run(void)
+{
+	for (uint i = 0; i < m_Config.m_uFrames; ++i)
+	{
+		Step();
+		//like Application::SwapFrame, hands the chunks of the ParallelFor calls back every frame
+		MyJobSystem::GetInstance()->WaitFrame();
+		MY_PROFILE_FRAME();
+	}
+	return m_Result;
+}
+void Simplex::MyHeadlessSim::Step(void)
+{
+	MY_PROFILE_FUNCTION();
+	long long nTime[PhaseCount + 1];
+	ProcessInput();
+
+	// Same order as Application::Simulate: the player collides and moves, then the lanes move
+	nTime[0] = MyProfiler::GetTimeNanoseconds();
+	// the brute force path sweeps every entity, the others only the broadphase they query
+	m_GameLogic.UpdateBroadphase(m_Store, m_Config.m_eBroadphase == Pairs ? MyGameLogic::SweepAndPrune :
+		static_cast<MyGameLogic::Broadphase>(m_Config.m_eBroadphase));
+	nTime[1] = MyProfiler::GetTimeNanoseconds();
+	bool bColliding = DetectCollision();
+	nTime[2] = MyProfiler::GetTimeNanoseconds();
+	m_GameLogic.UpdatePlayer(m_Config.m_fStep, bColliding);
+	m_Store.SetModelMatrix(m_uPlayer, m_GameLogic.GetPlayerMatrix());
+	nTime[3] = MyProfiler::GetTimeNanoseconds();
+	m_GameLogic.UpdateLanes(m_Config.m_fStep);
+	UpdateLaneMatrices();
+	nTime[4] = MyProfiler::GetTimeNanoseconds();
+
+	if (bColliding)
+		++m_Result.m_uCollisionFrames;
+
+	double dFrame = 0.0;
+	for (uint p = 0; p < PhaseCount; ++p)
+	{
+		double dPhase = (nTime[p + 1] - nTime[p]) / 1e6;
+		m_Result.m_dPhase[p] += dPhase;
+		if (dPhase > m_Result.m_dPhaseMax[p])
+			m_Result.m_dPhaseMax[p] = dPhase;
+		dFrame += dPhase;
+	}
+	m_Result.m_dTotal += dFrame;
+	if (dFrame > m_Result.m_dFrameMax)
+		m_Result.m_dFrameMax = dFrame;
+	++m_Result.m_uFrames;
+
+	// The player went off screen, restart as pressing space does
+	if (m_GameLogic.IsPlayerOffScreen())
+	{
+		++m_Result.m_uGameOvers;
+		m_GameLogic.Restart();
+		m_Store.SetModelMatrix(m_uPlayer, m_GameLogic.GetPlayerMatrix());
+		UpdateLaneMatrices();
+	}
+}
+void Simplex::MyHeadlessSim::ProcessInput(void)
+{
+	// Hold a direction for a while, jump now and then
+	std::uniform_real_distribution<float> chance(0.0f, 1.0f);
+	static const float fDirection[3] = { -1.0f, 0.0f, 1.0f };
+	if (chance(m_Random) < 0.1f)
+		m_GameLogic.MovePlayer(fDirection[m_Random() % 3]);
+	if (chance(m_Random) < 0.02f)
+		m_GameLogic.JumpPlayer();
+}
+bool Simplex::MyHeadlessSim::DetectCollision(void)
+{
+	MY_PROFILE_FUNCTION();
+	// The brute force path of the game tests every pair the sweep finds, the player's or not
+	if (m_Config.m_eBroadphase == Pairs)
+		m_Result.m_uCandidates += m_GameLogic.FindPairs(m_lPairs);
+	else
+		m_Result.m_uCandidates += m_GameLogic.FindPlayerPairs(m_Store, m_uPlayer,
+			static_cast<MyGameLogic::Broadphase>(m_Config.m_eBroadphase), m_lPairs);
+	CheckPairs();
+	return MyGameLogic::IsPlayerHit(m_lPairs, m_lPairColliding, m_Store.GetLayerArray(), m_uPlayer);
+}
+void Simplex::MyHeadlessSim::CheckPairs(void)
+{
+	m_lPairColliding.resize(m_lPairs.size());
+	MyJobSystem::GetInstance()->ParallelFor(m_lPairs.size(), 64, [this](uint a_uBegin, uint a_uEnd)
+	{
+		MY_PROFILE_ZONE("Narrow phase");
+		for (uint p = a_uBegin; p < a_uEnd; ++p)
+			m_lPairColliding[p] = m_Store.AreBoxesOverlapping(m_lPairs[p].first, m_lPairs[p].second) ? 1 : 0;
+	});
+}
+void Simplex::MyHeadlessSim::UpdateLaneMatrices(void)
+{
+	MY_PROFILE_FUNCTION();
+	for (uint l = 0; l < MyGameLogic::LaneCount; ++l)
+	{
+		// every object only touches its own slot in the store, the matrices go to every core
+		MyGameLogic::Lane eLane = static_cast<MyGameLogic::Lane>(l);
+		std::vector<uint> const& lEntity = m_lLaneEntity[l];
+		MyJobSystem::GetInstance()->ParallelFor(lEntity.size(), 128, [this, eLane, &lEntity](uint a_uBegin, uint a_uEnd)
+		{
+			MY_PROFILE_ZONE("Lane matrices");
+			for (uint i = a_uBegin; i < a_uEnd; ++i)
+				m_Store.SetModelMatrix(lEntity[i], m_GameLogic.GetLaneMatrix(eLane, i));
+		});
+	}
+}
+String Simplex::MyHeadlessSim::GetBroadphaseName(Broadphase a_eBroadphase)
+{
+	static const char* szName[] = { "LooseOctree", "SpatialGrid", "SweepAndPrune", "PackedScan", "Pairs" };
+	return a_eBroadphase < BroadphaseCount ? szName[a_eBroadphase] : "";
+}
+String Simplex::MyHeadlessSim::GetPhaseName(Phase a_ePhase)
+{
+	static const char* szName[] = { "broadphase", "collision", "player", "lanes" };
+	return a_ePhase < PhaseCount ? szName[a_ePhase] : "";
+}
+bool Simplex::MyHeadlessSim::ReadOBJBounds(String a_sFileName, vector3& a_v3Min, vector3& a_v3Max)
+{
+	std::ifstream file(a_sFileName.c_str());
+	if (!file.is_open())
+		return false;
+
+	bool bFound = false;
+	String sLine;
+	while (std::getline(file, sLine))
+	{
+		if (sLine.size() < 2 || sLine[0] != 'v' || (sLine[1] != ' ' && sLine[1] != '\t'))
+			continue;
+		char* pNext = nullptr;
+		vector3 v3Vertex;
+		v3Vertex.x = strtof(sLine.c_str() + 2, &pNext);
+		v3Vertex.y = strtof(pNext, &pNext);
+		v3Vertex.z = strtof(pNext, &pNext);
+		a_v3Min = bFound ? (glm::min)(a_v3Min, v3Vertex) : v3Vertex;
+		a_v3Max = bFound ? (glm::max)(a_v3Max, v3Vertex) : v3Vertex;
+		bFound = true;
+	}
+	return bFound;
+}
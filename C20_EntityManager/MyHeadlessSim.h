@@ -0,0 +1,185 @@
+/*----------------------------------------------
+Programmer: Team "No Name"
+Date: 2018/04
+----------------------------------------------*/
+#ifndef __MYHEADLESSSIM_H_
+#define __MYHEADLESSSIM_H_
+
+#include "MyDefinitions.h"
+#include "MyEntityStore.h"
+#include "MyGameLogic.h"
+#include <random>
+
+namespace Simplex
+{
+
+//The game of the Application without a window, OpenGL or the framework: the same MyGameLogic
+//moves the lanes of obstacles and coins, the player and the broadphases, run on the entity store
+//alone. The player is driven by a seeded random input so every run with the same settings does
+//the same thing. The models are only read for their bounds, and the narrow phase is the oriented
+//box test of the store, which is what the game runs on its job system too.
+class MyHeadlessSim
+{
+public:
+	// Broadphase used for the player's collisions, Pairs is the brute force path of the game
+	enum Broadphase
+	{
+		LooseOctree = MyGameLogic::LooseOctree,
+		SpatialGrid = MyGameLogic::SpatialGrid,
+		SweepAndPrune = MyGameLogic::SweepAndPrune,
+		PackedScan = MyGameLogic::PackedScan,
+		Pairs = MyGameLogic::BroadphaseCount,
+		BroadphaseCount
+	};
+
+	// Parts of a frame that are timed
+	enum Phase
+	{
+		PhaseBroadphase, // updating the broadphase with the bounds of this frame
+		PhaseCollision, // querying it for the player and testing what it found
+		PhasePlayer, // moving the player
+		PhaseLanes, // moving the obstacles and coins
+		PhaseCount
+	};
+
+	// What to run
+	struct Config
+	{
+		uint m_uObstacles = 800; // obstacles in the lanes
+		uint m_uCoins = 10; // coins in the lanes
+		uint m_uFrames = 1000; // frames to simulate
+		uint m_uSeed = 1; // seed of the lanes and the input
+		Broadphase m_eBroadphase = PackedScan; // broadphase of the player's collisions
+		float m_fStep = 1.0f / 60.0f; // seconds simulated by each frame
+		String m_sModelFolder = ""; // folder the Minecraft models are read from, ends with a separator
+	};
+
+	// What a run measured, times are in milliseconds
+	struct Result
+	{
+		uint m_uEntities = 0; // entities in the store
+		uint m_uFrames = 0; // frames simulated
+		double m_dTotal = 0.0; // time of every frame together
+		double m_dPhase[PhaseCount] = {}; // time of each phase over every frame
+		double m_dPhaseMax[PhaseCount] = {}; // longest frame of each phase
+		double m_dFrameMax = 0.0; // longest frame
+		uint m_uCandidates = 0; // entities the broadphase found, before the layers leave some out
+		uint m_uCollisionFrames = 0; // frames the player was pushed by an obstacle
+		uint m_uGameOvers = 0; // times the player was pushed off the screen
+		bool m_bModels = false; // the bounds came from the model files
+	};
+
+private:
+	Config m_Config; // settings of the run
+	std::mt19937 m_Random; // input
+
+	MyEntityStore m_Store; // every entity of the game
+	MyGameLogic m_GameLogic; // player, lanes and broadphases, the same as the Application's
+	uint m_uPlayer = 0; // index of the player in the store
+	std::vector<uint> m_lLaneEntity[MyGameLogic::LaneCount]; // index in the store of every object of the lanes
+	std::vector<std::pair<uint, uint>> m_lPairs; // pairs for the narrow phase
+	std::vector<uint> m_lPairColliding; // 1 for the pairs colliding, 0 for the rest
+
+	Result m_Result; // measured so far
+
+public:
+	/*
+	Usage: Constructor, creates the entities and the broadphases
+	Arguments: Config const& a_Config -> settings of the run
+	Output: class object instance
+	*/
+	MyHeadlessSim(Config const& a_Config);
+	/*
+	Usage: Destructor
+	Arguments: ---
+	Output: ---
+	*/
+	~MyHeadlessSim(void);
+	/*
+	USAGE: Simulates the frames of the settings
+	ARGUMENTS: ---
+	OUTPUT: what was measured
+	*/
+	Result const& Run(void);
+	/*
+	USAGE: Simulates a frame
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void Step(void);
+	/*
+	USAGE: Gets the name of a broadphase
+	ARGUMENTS: Broadphase a_eBroadphase -> broadphase
+	OUTPUT: name
+	*/
+	static String GetBroadphaseName(Broadphase a_eBroadphase);
+	/*
+	USAGE: Gets the name of a phase
+	ARGUMENTS: Phase a_ePhase -> phase
+	OUTPUT: name
+	*/
+	static String GetPhaseName(Phase a_ePhase);
+	/*
+	USAGE: Reads the bounding box of the vertices of a Wavefront .obj file
+	ARGUMENTS:
+	-	String a_sFileName -> file to read
+	-	vector3& a_v3Min -> min corner
+	-	vector3& a_v3Max -> max corner
+	OUTPUT: false if the file could not be read or has no vertices
+	*/
+	static bool ReadOBJBounds(String a_sFileName, vector3& a_v3Min, vector3& a_v3Max);
+
+private:
+	/*
+	Usage: Copy Constructor
+	Arguments: class object to copy
+	Output: class object instance
+	*/
+	MyHeadlessSim(MyHeadlessSim const& other);
+	/*
+	Usage: Copy Assignment Operator
+	Arguments: class object to copy
+	Output: ---
+	*/
+	MyHeadlessSim& operator=(MyHeadlessSim const& other);
+	/*
+	USAGE: Adds the entities of a lane, the game logic places them as it does for the Application
+	ARGUMENTS:
+	-	MyGameLogic::Lane a_eLane -> lane
+	-	uint a_uAmount -> entities to add
+	-	EntityLayer a_eLayer -> layer
+	-	vector3 const& a_v3Min -> min corner of the model
+	-	vector3 const& a_v3Max -> max corner of the model
+	OUTPUT: ---
+	*/
+	void GenerateObjects(MyGameLogic::Lane a_eLane, uint a_uAmount, EntityLayer a_eLayer,
+		vector3 const& a_v3Min, vector3 const& a_v3Max);
+	/*
+	USAGE: Presses the keys of the player, as random as the seed
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void ProcessInput(void);
+	/*
+	USAGE: Queries the broadphase for the player and tests it against what it finds
+	ARGUMENTS: ---
+	OUTPUT: is the player colliding with an obstacle?
+	*/
+	bool DetectCollision(void);
+	/*
+	USAGE: Tests the oriented boxes of the pairs, spread over the job system
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void CheckPairs(void);
+	/*
+	USAGE: Writes the model matrices of the obstacles and coins to the store
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void UpdateLaneMatrices(void);
+};
+
+}//namespace Simplex
+
+#endif //__MYHEADLESSSIM_H_
@@ -0,0 +1,337 @@
+#include "MyJobSystem.h"
+#include "MyProfiler.h"
+namespace Simplex
+{
+	//A job runs once it is submitted and the jobs it depends on are done. The ones depending on it
+	//are kept with it and let go when it finishes, the last thing it touches is its counter
+	struct MyJob
+	{
+		std::function<void()> m_fnWork; //work of the job
+		void (*m_pfnRange)(void const*, uint, uint) = nullptr; //work of a ParallelFor chunk, run instead if set
+		void const* m_pRange = nullptr; //work handed to m_pfnRange
+		uint m_uBegin = 0; //first index of the chunk
+		uint m_uEnd = 0; //index after the last one of the chunk
+		std::atomic<int> m_nWaiting; //jobs it waits for, plus one until it is submitted
+		std::atomic<bool> m_bDone; //the work ran
+		std::atomic<int>* m_pCounter = nullptr; //decremented once it is done
+		std::mutex m_Lock; //guards the jobs waiting for it and the done flag against AddDependency
+		std::vector<MyJob*> m_lNext; //jobs waiting for it
+
+		MyJob(void) : m_nWaiting(1), m_bDone(false) {}
+	};
+
+	//Jobs of a thread, the owner works on the back and the others steal from the front
+	struct MyJobQueue
+	{
+		std::mutex m_Lock; //guards the jobs
+		std::deque<MyJob*> m_lJob; //jobs ready to run
+	};
+
+	//queue of the calling thread, valid while the generation matches the workers that were started
+	static thread_local uint t_uJobQueue = 0;
+	static thread_local uint t_uJobGeneration = 0;
+	static std::atomic<uint> s_uJobGeneration(0);
+}
+using namespace Simplex;
+//  MyJobSystem
+MyJobSystem* MyJobSystem::m_pInstance = nullptr;
+MyJobSystem* MyJobSystem::GetInstance()
+{
+	if (m_pInstance == nullptr)
+	{
+		m_pInstance = new MyJobSystem();
+	}
+	return m_pInstance;
+}
+void MyJobSystem::ReleaseInstance()
+{
+	if (m_pInstance != nullptr)
+	{
+		delete m_pInstance;
+		m_pInstance = nullptr;
+	}
+}
+Simplex::MyJobSystem::MyJobSystem(void) : m_nUnfinished(0), m_nBackground(0), m_nQueued(0)
+{
+	//the main thread is the last core
+	uint uCores = std::thread::hardware_concurrency();
+	Init(uCores > 1 ? uCores - 1 : 0);
+}
+Simplex::MyJobSystem::MyJobSystem(MyJobSystem const& other) { }
+MyJobSystem& Simplex::MyJobSystem::operator=(MyJobSystem const& other) { return *this; }
+Simplex::MyJobSystem::~MyJobSystem(void)
+{
+	WaitFrame();
+	WaitBackground();
+	Release();
+}
+void Simplex::MyJobSystem::Init(uint a_uWorkers)
+{
+	m_bQuit = false;
+	m_uGeneration = ++s_uJobGeneration;
+	for (uint i = 0; i <= a_uWorkers; ++i)
+		m_lQueue.push_back(std::unique_ptr<MyJobQueue>(new MyJobQueue()));
+
+	//the workers name themselves in the profiler, it has to be there before they race to make it
+#if MY_PROFILE
+	MyProfiler::GetInstance();
+#endif
+	for (uint i = 1; i <= a_uWorkers; ++i)
+		m_lWorker.push_back(std::thread(&MyJobSystem::WorkerLoop, this, i));
+}
+void Simplex::MyJobSystem::Release(void)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_SleepLock);
+		m_bQuit = true;
+	}
+	m_Wake.notify_all();
+	for (uint i = 0; i < m_lWorker.size(); ++i)
+		m_lWorker[i].join();
+	m_lWorker.clear();
+	m_lQueue.clear();
+	m_nQueued = 0;
+}
+void Simplex::MyJobSystem::SetWorkerCount(uint a_uWorkers)
+{
+	if (a_uWorkers == m_lWorker.size())
+		return;
+	WaitFrame();
+	WaitBackground();
+	Release();
+	Init(a_uWorkers);
+}
+uint Simplex::MyJobSystem::GetWorkerCount(void) { return m_lWorker.size(); }
+void Simplex::MyJobSystem::WorkerLoop(uint a_uQueue)
+{
+	t_uJobQueue = a_uQueue;
+	t_uJobGeneration = m_uGeneration;
+	MY_PROFILE_THREAD("Job " + std::to_string(a_uQueue));
+
+	while (true)
+	{
+		if (RunOne())
+			continue;
+
+		//nothing to run or steal, sleep until something is pushed
+		std::unique_lock<std::mutex> lock(m_SleepLock);
+		m_Wake.wait(lock, [this]() { return m_bQuit || m_nQueued.load() > 0; });
+		if (m_bQuit)
+			return;
+	}
+}
+uint Simplex::MyJobSystem::GetQueue(void)
+{
+	return t_uJobGeneration == m_uGeneration ? t_uJobQueue : 0;
+}
+MyJob* Simplex::MyJobSystem::CreateJob(std::function<void()> a_fnWork)
+{
+	std::lock_guard<std::mutex> lock(m_FrameLock);
+	m_lFrameJob.emplace_back();
+	MyJob* pJob = &m_lFrameJob.back();
+	pJob->m_fnWork = std::move(a_fnWork);
+	pJob->m_pCounter = &m_nUnfinished;
+	++m_nUnfinished;
+	return pJob;
+}
+void Simplex::MyJobSystem::AddDependency(MyJob* a_pBefore, MyJob* a_pAfter)
+{
+	std::lock_guard<std::mutex> lock(a_pBefore->m_Lock);
+	//if it is done already there is nothing to wait for
+	if (a_pBefore->m_bDone)
+		return;
+	++a_pAfter->m_nWaiting;
+	a_pBefore->m_lNext.push_back(a_pAfter);
+}
+void Simplex::MyJobSystem::Submit(MyJob* a_pJob)
+{
+	if (--a_pJob->m_nWaiting == 0)
+		Push(a_pJob);
+}
+MyJob* Simplex::MyJobSystem::Run(std::function<void()> a_fnWork)
+{
+	MyJob* pJob = CreateJob(std::move(a_fnWork));
+	Submit(pJob);
+	return pJob;
+}
+void Simplex::MyJobSystem::Push(MyJob* a_pJob)
+{
+	MyJobQueue& queue = *m_lQueue[GetQueue()];
+	{
+		std::lock_guard<std::mutex> lock(queue.m_Lock);
+		queue.m_lJob.push_back(a_pJob);
+	}
+	++m_nQueued;
+
+	//a worker checks the count holding the lock before it sleeps, so it cannot miss this
+	{
+		std::lock_guard<std::mutex> lock(m_SleepLock);
+	}
+	m_Wake.notify_one();
+}
+MyJob* Simplex::MyJobSystem::Pop(void)
+{
+	uint uQueue = GetQueue();
+	uint uCount = m_lQueue.size();
+	for (uint i = 0; i < uCount; ++i)
+	{
+		//the newest job of its own queue is still warm in the cache, from the others take the oldest
+		MyJobQueue& queue = *m_lQueue[(uQueue + i) % uCount];
+		std::lock_guard<std::mutex> lock(queue.m_Lock);
+		if (queue.m_lJob.empty())
+			continue;
+		MyJob* pJob = nullptr;
+		if (i == 0)
+		{
+			pJob = queue.m_lJob.back();
+			queue.m_lJob.pop_back();
+		}
+		else
+		{
+			pJob = queue.m_lJob.front();
+			queue.m_lJob.pop_front();
+		}
+		--m_nQueued;
+		return pJob;
+	}
+	return nullptr;
+}
+bool Simplex::MyJobSystem::RunOne(void)
+{
+	MyJob* pJob = Pop();
+	if (pJob == nullptr)
+		return false;
+	Execute(pJob);
+	return true;
+}
+void Simplex::MyJobSystem::Execute(MyJob* a_pJob)
+{
+	if (a_pJob->m_pfnRange != nullptr)
+		a_pJob->m_pfnRange(a_pJob->m_pRange, a_pJob->m_uBegin, a_pJob->m_uEnd);
+	else
+		a_pJob->m_fnWork();
+
+	std::vector<MyJob*> lNext;
+	{
+		std::lock_guard<std::mutex> lock(a_pJob->m_Lock);
+		a_pJob->m_bDone = true;
+		lNext.swap(a_pJob->m_lNext);
+	}
+	for (uint i = 0; i < lNext.size(); ++i)
+	{
+		if (--lNext[i]->m_nWaiting == 0)
+			Push(lNext[i]);
+	}
+
+	//whoever waits on the counter may free the job right after this
+	--(*a_pJob->m_pCounter);
+}
+void Simplex::MyJobSystem::Wait(MyJob* a_pJob)
+{
+	while (!a_pJob->m_bDone)
+	{
+		if (!RunOne())
+			std::this_thread::yield();
+	}
+}
+std::shared_future<void> Simplex::MyJobSystem::RunBackground(std::function<void()> a_fnWork)
+{
+	std::shared_ptr<std::promise<void>> pDone = std::make_shared<std::promise<void>>();
+	std::shared_future<void> done = pDone->get_future().share();
+	MyJob* pJob = nullptr;
+	{
+		std::lock_guard<std::mutex> lock(m_FrameLock);
+		m_lBackgroundJob.emplace_back();
+		pJob = &m_lBackgroundJob.back();
+		pJob->m_fnWork = [pDone, a_fnWork]()
+		{
+			a_fnWork();
+			pDone->set_value();
+		};
+		pJob->m_pCounter = &m_nBackground;
+		++m_nBackground;
+	}
+	Submit(pJob);
+	return done;
+}
+void Simplex::MyJobSystem::Wait(std::shared_future<void> const& a_Done)
+{
+	while (a_Done.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+	{
+		if (!RunOne())
+			std::this_thread::yield();
+	}
+}
+void Simplex::MyJobSystem::WaitBackground(void)
+{
+	while (m_nBackground.load() > 0)
+	{
+		if (!RunOne())
+			std::this_thread::yield();
+	}
+}
+void Simplex::MyJobSystem::WaitFrame(void)
+{
+	while (m_nUnfinished.load() > 0)
+	{
+		if (!RunOne())
+			std::this_thread::yield();
+	}
+	std::lock_guard<std::mutex> lock(m_FrameLock);
+	m_lFrameJob.clear();
+	//every ParallelFor returned before its caller could get here, the chunks are free again
+	m_uChunkJobUsed = 0;
+	//the background jobs are only freed together, once none is left
+	if (m_nBackground.load() == 0)
+		m_lBackgroundJob.clear();
+}
+MyJob* Simplex::MyJobSystem::AcquireChunkJob(void)
+{
+	std::lock_guard<std::mutex> lock(m_FrameLock);
+	if (m_uChunkJobUsed == m_lChunkJob.size())
+		m_lChunkJob.emplace_back();
+	MyJob* pJob = &m_lChunkJob[m_uChunkJobUsed++];
+	pJob->m_nWaiting = 0;
+	pJob->m_bDone = false;
+	return pJob;
+}
+void Simplex::MyJobSystem::ParallelRange(uint a_uCount, uint a_uGrain, void (*a_pfnRange)(void const*, uint, uint),
+	void const* a_pRange)
+{
+	if (a_uCount == 0)
+		return;
+	uint uGrain = a_uGrain > 0 ? a_uGrain : 1;
+	if (m_lWorker.empty() || a_uCount <= uGrain)
+	{
+		a_pfnRange(a_pRange, 0, a_uCount);
+		return;
+	}
+
+	//a few chunks a thread so the ones that finish first can steal the rest
+	uint uChunks = (a_uCount + uGrain - 1) / uGrain;
+	uint uMaxChunks = (m_lWorker.size() + 1) * 4;
+	if (uChunks > uMaxChunks)
+		uChunks = uMaxChunks;
+	uint uSize = (a_uCount + uChunks - 1) / uChunks;
+	uChunks = (a_uCount + uSize - 1) / uSize;
+
+	//the calling thread takes the first chunk, the rest go to its queue for the others to steal
+	std::atomic<int> nLeft(uChunks - 1);
+	for (uint c = 1; c < uChunks; ++c)
+	{
+		MyJob* pJob = AcquireChunkJob();
+		pJob->m_pfnRange = a_pfnRange;
+		pJob->m_pRange = a_pRange;
+		pJob->m_uBegin = c * uSize;
+		pJob->m_uEnd = pJob->m_uBegin + uSize < a_uCount ? pJob->m_uBegin + uSize : a_uCount;
+		pJob->m_pCounter = &nLeft;
+		Push(pJob);
+	}
+	a_pfnRange(a_pRange, 0, uSize);
+
+	while (nLeft.load() > 0)
+	{
+		if (!RunOne())
+			std::this_thread::yield();
+	}
+}
\ No newline at end of file
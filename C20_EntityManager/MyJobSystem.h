@@ -0,0 +1,253 @@
+/*----------------------------------------------
+Programmer: Team "No Name"
+Date: 2018/04
+----------------------------------------------*/
+#ifndef __MYJOBSYSTEM_H_
+#define __MYJOBSYSTEM_H_
+
+#include "MyDefinitions.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace Simplex
+{
+
+struct MyJob; //work waiting for its dependencies or a thread, defined with the job system
+struct MyJobQueue; //jobs of a thread, defined with the job system
+
+//Runs the work of a frame on every core. Each thread has its own queue: it takes the jobs it
+//pushed last first, and when it runs out it steals the oldest jobs of the others. The thread
+//calling the system is one more worker, it runs jobs whenever it waits on them. Jobs made with
+//CreateJob live until WaitFrame, which waits for all of them; the chunks of ParallelFor are taken
+//from a pool WaitFrame hands back, so a frame allocates nothing once the pool is big enough. Jobs
+//run with RunBackground can take longer than a frame, WaitFrame does not wait for them.
+class MyJobSystem
+{
+	static MyJobSystem* m_pInstance; //Singleton pointer
+	std::vector<std::thread> m_lWorker; //worker threads, the main thread is not one of them
+	std::vector<std::unique_ptr<MyJobQueue>> m_lQueue; //queues, 0 is the main thread's, then one a worker
+	std::deque<MyJob> m_lFrameJob; //jobs made this frame, a deque so they never move
+	std::deque<MyJob> m_lChunkJob; //chunks of ParallelFor, kept between frames to reuse them
+	uint m_uChunkJobUsed = 0; //chunks handed out this frame
+	std::deque<MyJob> m_lBackgroundJob; //jobs that may outlive the frame, freed once none is left
+	std::mutex m_FrameLock; //guards the jobs of the frame, the chunks and the background jobs
+	std::atomic<int> m_nUnfinished; //jobs of the frame that have not run yet
+	std::atomic<int> m_nBackground; //background jobs that have not run yet
+	std::atomic<int> m_nQueued; //jobs sitting in a queue
+	std::mutex m_SleepLock; //taken by the workers going to sleep
+	std::condition_variable m_Wake; //wakes the workers when there are jobs
+	bool m_bQuit = false; //workers stop when set
+	uint m_uGeneration = 0; //changes every time the workers start, so threads know their queue is stale
+
+public:
+	/*
+	Usage: Gets the singleton pointer, starts a worker for every core but one the first time
+	Arguments: ---
+	Output: singleton pointer
+	*/
+	static MyJobSystem* GetInstance();
+	/*
+	Usage: Releases the content of the singleton, the jobs of the frame are waited for first
+	Arguments: ---
+	Output: ---
+	*/
+	static void ReleaseInstance(void);
+	/*
+	USAGE: Restarts the workers with a new count, call it between frames with no job in flight
+	ARGUMENTS: uint a_uWorkers -> worker threads besides the main one, 0 runs everything on the main thread
+	OUTPUT: ---
+	*/
+	void SetWorkerCount(uint a_uWorkers);
+	/*
+	USAGE: Gets the number of worker threads besides the main one
+	ARGUMENTS: ---
+	OUTPUT: workers
+	*/
+	uint GetWorkerCount(void);
+	/*
+	USAGE: Makes a job for this frame, it does not run until it is submitted
+	ARGUMENTS: std::function<void()> a_fnWork -> work of the job
+	OUTPUT: job, valid until WaitFrame
+	*/
+	MyJob* CreateJob(std::function<void()> a_fnWork);
+	/*
+	USAGE: Makes a job wait for another one, before the waiting one is submitted
+	ARGUMENTS:
+	-	MyJob* a_pBefore -> job that has to finish first, it can be running or done already
+	-	MyJob* a_pAfter -> job that waits, not submitted yet
+	OUTPUT: ---
+	*/
+	void AddDependency(MyJob* a_pBefore, MyJob* a_pAfter);
+	/*
+	USAGE: Lets a job run once the jobs it depends on are done
+	ARGUMENTS: MyJob* a_pJob -> job to run
+	OUTPUT: ---
+	*/
+	void Submit(MyJob* a_pJob);
+	/*
+	USAGE: Makes a job for this frame and submits it
+	ARGUMENTS: std::function<void()> a_fnWork -> work of the job
+	OUTPUT: job, valid until WaitFrame
+	*/
+	MyJob* Run(std::function<void()> a_fnWork);
+	/*
+	USAGE: Runs jobs until the one given is done
+	ARGUMENTS: MyJob* a_pJob -> job to wait for
+	OUTPUT: ---
+	*/
+	void Wait(MyJob* a_pJob);
+	/*
+	USAGE: Runs work on a worker without tying it to the frame, for work that can take several frames
+	like reading files; WaitFrame does not wait for it
+	ARGUMENTS: std::function<void()> a_fnWork -> work of the job
+	OUTPUT: ready once the work ran, wait on it with Wait so it runs even without workers
+	*/
+	std::shared_future<void> RunBackground(std::function<void()> a_fnWork);
+	/*
+	USAGE: Runs jobs until a background job is done
+	ARGUMENTS: std::shared_future<void> const& a_Done -> what RunBackground returned
+	OUTPUT: ---
+	*/
+	void Wait(std::shared_future<void> const& a_Done);
+	/*
+	USAGE: Runs jobs until every job of the frame is done, frees them and hands the chunks of
+	ParallelFor back; from the main thread, once per frame or whenever nothing else may be touching the jobs
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void WaitFrame(void);
+	/*
+	USAGE: Splits a range of indices in chunks run on every thread, returns when all are done; it can
+	be called from inside a job
+	ARGUMENTS:
+	-	uint a_uCount -> indices go from 0 to a_uCount - 1
+	-	uint a_uGrain -> fewest indices a chunk gets, small ranges run on the calling thread alone
+	-	Function const& a_fnRange -> work on the indices from the first to before the second, called
+		as a_fnRange(uint, uint); it is not copied, it only has to live during the call
+	OUTPUT: ---
+	*/
+	template <typename Function>
+	void ParallelFor(uint a_uCount, uint a_uGrain, Function const& a_fnRange)
+	{
+		ParallelRange(a_uCount, a_uGrain, &CallRange<Function>, &a_fnRange);
+	}
+
+private:
+	/*
+	Usage: Constructor
+	Arguments: ---
+	Output: class object instance
+	*/
+	MyJobSystem(void);
+	/*
+	Usage: Copy Constructor
+	Arguments: class object to copy
+	Output: class object instance
+	*/
+	MyJobSystem(MyJobSystem const& other);
+	/*
+	Usage: Copy Assignment Operator
+	Arguments: class object to copy
+	Output: ---
+	*/
+	MyJobSystem& operator=(MyJobSystem const& other);
+	/*
+	Usage: Destructor
+	Arguments: ---
+	Output: ---
+	*/
+	~MyJobSystem(void);
+	/*
+	USAGE: Starts the workers
+	ARGUMENTS: uint a_uWorkers -> worker threads besides the main one
+	OUTPUT: ---
+	*/
+	void Init(uint a_uWorkers);
+	/*
+	USAGE: Stops the workers, no job can be in flight
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void Release(void);
+	/*
+	USAGE: Runs jobs until every background job is done
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void WaitBackground(void);
+	/*
+	USAGE: Body of every worker, runs jobs until the system quits
+	ARGUMENTS: uint a_uQueue -> queue of the worker
+	OUTPUT: ---
+	*/
+	void WorkerLoop(uint a_uQueue);
+	/*
+	USAGE: Gets the queue of the calling thread, the main one for threads that are not workers
+	ARGUMENTS: ---
+	OUTPUT: index of the queue
+	*/
+	uint GetQueue(void);
+	/*
+	USAGE: Puts a job that is ready in the queue of the calling thread and wakes a worker
+	ARGUMENTS: MyJob* a_pJob -> job
+	OUTPUT: ---
+	*/
+	void Push(MyJob* a_pJob);
+	/*
+	USAGE: Takes a job from the queue of the calling thread, or steals one from another
+	ARGUMENTS: ---
+	OUTPUT: job, nullptr if every queue is empty
+	*/
+	MyJob* Pop(void);
+	/*
+	USAGE: Takes a job and runs it
+	ARGUMENTS: ---
+	OUTPUT: was there a job to run?
+	*/
+	bool RunOne(void);
+	/*
+	USAGE: Runs a job and lets the ones waiting for it go
+	ARGUMENTS: MyJob* a_pJob -> job
+	OUTPUT: ---
+	*/
+	void Execute(MyJob* a_pJob);
+	/*
+	USAGE: Body of ParallelFor, the work goes through a plain function so the chunks need no std::function
+	ARGUMENTS:
+	-	uint a_uCount -> indices go from 0 to a_uCount - 1
+	-	uint a_uGrain -> fewest indices a chunk gets
+	-	void (*a_pfnRange)(void const*, uint, uint) -> calls the work on a range
+	-	void const* a_pRange -> work handed to a_pfnRange
+	OUTPUT: ---
+	*/
+	void ParallelRange(uint a_uCount, uint a_uGrain, void (*a_pfnRange)(void const*, uint, uint), void const* a_pRange);
+	/*
+	USAGE: Calls the work of a ParallelFor on a range
+	ARGUMENTS:
+	-	void const* a_pRange -> work, a Function
+	-	uint a_uBegin -> first index
+	-	uint a_uEnd -> index after the last one
+	OUTPUT: ---
+	*/
+	template <typename Function>
+	static void CallRange(void const* a_pRange, uint a_uBegin, uint a_uEnd)
+	{
+		(*static_cast<Function const*>(a_pRange))(a_uBegin, a_uEnd);
+	}
+	/*
+	USAGE: Takes a chunk job from the pool, making one if they are all in use this frame
+	ARGUMENTS: ---
+	OUTPUT: job, ready to be pushed once its range is set
+	*/
+	MyJob* AcquireChunkJob(void);
+};
+
+}//namespace Simplex
+
+#endif //__MYJOBSYSTEM_H_
@@ -0,0 +1,364 @@
+#include "MyLODBuilder.h"
+#include "MyMeshSimplifier.h"
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <sstream>
+#include <cstdio>
+#include <sys/types.h>
+#include <sys/stat.h>
+using namespace Simplex;
+//  MyLODBuilder
+namespace
+{
+	//Turns an index of the file into a 1 based one, negative ones count back from the last read
+	int ResolveIndex(int a_nIndex, uint a_uCount)
+	{
+		if (a_nIndex < 0)
+			return static_cast<int>(a_uCount) + 1 + a_nIndex;
+		return a_nIndex;
+	}
+}
+bool Simplex::MyLODBuilder::Read(String a_sFileName)
+{
+	std::ifstream file(a_sFileName.c_str());
+	if (!file.is_open())
+		return false;
+
+	m_sMaterialLibrary = "";
+	m_lPosition.clear();
+	m_lUV.clear();
+	m_lNormal.clear();
+	m_lSection.clear();
+	m_lLevel.clear();
+	m_lTriangleCount.clear();
+
+	String sGroup = "default";
+	String sMaterial = "";
+	int nSection = -1;
+	std::vector<std::map<int, int>> lLocal; //position of the file to the one of each section
+	String sLine;
+	while (std::getline(file, sLine))
+	{
+		if (!sLine.empty() && sLine.back() == '\r')
+			sLine.pop_back();
+		std::istringstream stream(sLine);
+		String sType;
+		stream >> sType;
+		if (sType == "v")
+		{
+			vector3 v3Position;
+			stream >> v3Position.x >> v3Position.y >> v3Position.z;
+			m_lPosition.push_back(v3Position);
+		}
+		else if (sType == "vt")
+			m_lUV.push_back(sLine);
+		else if (sType == "vn")
+			m_lNormal.push_back(sLine);
+		else if (sType == "g" || sType == "o")
+		{
+			std::getline(stream >> std::ws, sGroup);
+			nSection = -1;
+		}
+		else if (sType == "usemtl")
+		{
+			std::getline(stream >> std::ws, sMaterial);
+			nSection = -1;
+		}
+		else if (sType == "mtllib")
+			std::getline(stream >> std::ws, m_sMaterialLibrary);
+		else if (sType == "f")
+		{
+			if (nSection < 0)
+			{
+				for (uint i = 0; i < m_lSection.size() && nSection < 0; ++i)
+				{
+					if (m_lSection[i].m_sGroup == sGroup && m_lSection[i].m_sMaterial == sMaterial)
+						nSection = static_cast<int>(i);
+				}
+				if (nSection < 0)
+				{
+					Section section;
+					section.m_sGroup = sGroup;
+					section.m_sMaterial = sMaterial;
+					m_lSection.push_back(section);
+					lLocal.push_back(std::map<int, int>());
+					nSection = static_cast<int>(m_lSection.size()) - 1;
+				}
+			}
+			Section& section = m_lSection[nSection];
+			std::map<int, int>& mapLocal = lLocal[nSection];
+
+			std::vector<Corner> lFace;
+			String sCorner;
+			while (stream >> sCorner)
+			{
+				Corner corner;
+				int lValue[3] = { 0, 0, 0 };
+				uint uSlot = 0;
+				String sValue;
+				for (uint i = 0; i <= sCorner.size() && uSlot < 3; ++i)
+				{
+					if (i == sCorner.size() || sCorner[i] == '/')
+					{
+						lValue[uSlot++] = sValue.empty() ? 0 : atoi(sValue.c_str());
+						sValue = "";
+					}
+					else
+						sValue += sCorner[i];
+				}
+				int nPosition = ResolveIndex(lValue[0], static_cast<uint>(m_lPosition.size()));
+				if (nPosition < 1 || nPosition > static_cast<int>(m_lPosition.size()))
+					return false;
+				std::map<int, int>::iterator it = mapLocal.find(nPosition);
+				if (it == mapLocal.end())
+				{
+					it = mapLocal.insert(std::make_pair(nPosition, static_cast<int>(section.m_lPosition.size()))).first;
+					section.m_lPosition.push_back(nPosition);
+				}
+				corner.m_nPosition = it->second;
+				corner.m_nUV = lValue[1] == 0 ? 0 : ResolveIndex(lValue[1], static_cast<uint>(m_lUV.size()));
+				corner.m_nNormal = lValue[2] == 0 ? 0 : ResolveIndex(lValue[2], static_cast<uint>(m_lNormal.size()));
+				lFace.push_back(corner);
+			}
+			//fan from the first corner, the faces of the models are flat
+			for (uint i = 2; i < lFace.size(); ++i)
+			{
+				section.m_lCorner.push_back(lFace[0]);
+				section.m_lCorner.push_back(lFace[i - 1]);
+				section.m_lCorner.push_back(lFace[i]);
+			}
+		}
+	}
+	if (m_lSection.empty())
+		return false;
+
+	vector3 v3Min = m_lPosition[0];
+	vector3 v3Max = m_lPosition[0];
+	uint uTriangles = 0;
+	for (uint i = 1; i < m_lPosition.size(); ++i)
+	{
+		v3Min = glm::min(v3Min, m_lPosition[i]);
+		v3Max = glm::max(v3Max, m_lPosition[i]);
+	}
+	for (uint i = 0; i < m_lSection.size(); ++i)
+		uTriangles += static_cast<uint>(m_lSection[i].m_lCorner.size() / 3);
+	m_fRadius = glm::length(v3Max - v3Min) * 0.5f;
+	m_lTriangleCount.push_back(uTriangles);
+	return true;
+}
+uint Simplex::MyLODBuilder::Build(uint a_uLevels, float a_fRatio, float a_fMaxError)
+{
+	m_lLevel.clear();
+	m_lTriangleCount.resize(m_lTriangleCount.empty() ? 0 : 1);
+	if (m_lTriangleCount.empty())
+		return 0;
+
+	std::vector<MyMeshSimplifier> lSimplifier;
+	for (uint s = 0; s < m_lSection.size(); ++s)
+	{
+		Section const& section = m_lSection[s];
+		std::vector<vector3> lPosition(section.m_lPosition.size());
+		for (uint i = 0; i < section.m_lPosition.size(); ++i)
+			lPosition[i] = m_lPosition[section.m_lPosition[i] - 1];
+		std::vector<uint> lTriangle(section.m_lCorner.size());
+		for (uint i = 0; i < section.m_lCorner.size(); ++i)
+			lTriangle[i] = static_cast<uint>(section.m_lCorner[i].m_nPosition);
+		lSimplifier.push_back(MyMeshSimplifier(lPosition, lTriangle));
+	}
+
+	for (uint l = 1; l <= a_uLevels; ++l)
+	{
+		float fKeep = std::pow(a_fRatio, static_cast<float>(l));
+		float fMaxError = m_fRadius * a_fMaxError * static_cast<float>(1u << (l - 1));
+		std::vector<SectionLevel> lLevel(m_lSection.size());
+		uint uTriangles = 0;
+		for (uint s = 0; s < m_lSection.size(); ++s)
+		{
+			Section const& section = m_lSection[s];
+			MyMeshSimplifier& simplifier = lSimplifier[s];
+			uint uSource = static_cast<uint>(section.m_lCorner.size() / 3);
+			simplifier.Simplify(static_cast<uint>(std::ceil(uSource * fKeep)), fMaxError);
+
+			SectionLevel& level = lLevel[s];
+			level.m_lPosition.resize(section.m_lPosition.size());
+			for (uint i = 0; i < section.m_lPosition.size(); ++i)
+				level.m_lPosition[i] = simplifier.GetPosition(i);
+			for (uint t = 0; t < uSource; ++t)
+			{
+				if (!simplifier.IsTriangleAlive(t))
+					continue;
+				for (uint c = 0; c < 3; ++c)
+				{
+					Corner corner = section.m_lCorner[t * 3 + c];
+					corner.m_nPosition = static_cast<int>(simplifier.GetTriangleVertex(t, c));
+					level.m_lCorner.push_back(corner);
+				}
+			}
+			uTriangles += simplifier.GetTriangleCount();
+		}
+		if (uTriangles >= m_lTriangleCount.back())
+			continue; //nothing can go without changing the shape too much, the next level allows more
+		m_lLevel.push_back(lLevel);
+		m_lTriangleCount.push_back(uTriangles);
+	}
+	return static_cast<uint>(m_lLevel.size());
+}
+uint Simplex::MyLODBuilder::GetLevelCount(void) const { return static_cast<uint>(m_lTriangleCount.size()); }
+uint Simplex::MyLODBuilder::GetTriangleCount(uint a_uLevel) const
+{
+	if (a_uLevel >= m_lTriangleCount.size())
+		return 0;
+	return m_lTriangleCount[a_uLevel];
+}
+void Simplex::MyLODBuilder::GetUsedPositions(std::vector<vector3>& a_lPosition) const
+{
+	a_lPosition.clear();
+	for (uint s = 0; s < m_lSection.size(); ++s)
+	{
+		for (uint i = 0; i < m_lSection[s].m_lPosition.size(); ++i)
+			a_lPosition.push_back(m_lPosition[m_lSection[s].m_lPosition[i] - 1]);
+	}
+}
+bool Simplex::MyLODBuilder::Write(uint a_uLevel, String a_sFileName, String a_sMaterialLibrary) const
+{
+	if (a_uLevel == 0 || a_uLevel > m_lLevel.size())
+		return false;
+	std::ostringstream file;
+
+	std::vector<SectionLevel> const& lLevel = m_lLevel[a_uLevel - 1];
+	file << "# Level of detail " << a_uLevel << ", " << m_lTriangleCount[a_uLevel] << " of "
+		<< m_lTriangleCount[0] << " triangles\n";
+	String sMaterialLibrary = a_sMaterialLibrary == "" ? m_sMaterialLibrary : a_sMaterialLibrary;
+	if (sMaterialLibrary != "")
+		file << "mtllib " << sMaterialLibrary << "\n";
+
+	//every section writes its own positions, they moved apart when simplified
+	std::vector<int> lOffset(lLevel.size());
+	int nOffset = 0;
+	for (uint s = 0; s < lLevel.size(); ++s)
+	{
+		lOffset[s] = nOffset;
+		for (uint i = 0; i < lLevel[s].m_lPosition.size(); ++i)
+		{
+			vector3 const& v3Position = lLevel[s].m_lPosition[i];
+			file << "v " << v3Position.x << " " << v3Position.y << " " << v3Position.z << "\n";
+		}
+		nOffset += static_cast<int>(lLevel[s].m_lPosition.size());
+	}
+	for (uint i = 0; i < m_lUV.size(); ++i)
+		file << m_lUV[i] << "\n";
+	for (uint i = 0; i < m_lNormal.size(); ++i)
+		file << m_lNormal[i] << "\n";
+
+	for (uint s = 0; s < lLevel.size(); ++s)
+	{
+		if (lLevel[s].m_lCorner.empty())
+			continue;
+		file << "g " << m_lSection[s].m_sGroup << "\n";
+		if (m_lSection[s].m_sMaterial != "")
+			file << "usemtl " << m_lSection[s].m_sMaterial << "\n";
+		std::vector<Corner> const& lCorner = lLevel[s].m_lCorner;
+		for (uint i = 0; i < lCorner.size(); i += 3)
+		{
+			file << "f";
+			for (uint c = 0; c < 3; ++c)
+			{
+				Corner const& corner = lCorner[i + c];
+				file << " " << lOffset[s] + corner.m_nPosition + 1;
+				if (corner.m_nUV != 0 || corner.m_nNormal != 0)
+					file << "/";
+				if (corner.m_nUV != 0)
+					file << corner.m_nUV;
+				if (corner.m_nNormal != 0)
+					file << "/" << corner.m_nNormal;
+			}
+			file << "\n";
+		}
+	}
+	return SaveFile(a_sFileName, file.str());
+}
+String Simplex::MyLODBuilder::GetMaterialLibrary(void) const { return m_sMaterialLibrary; }
+String Simplex::MyLODBuilder::GetLevelFileName(String a_sFileName, uint a_uLevel)
+{
+	if (a_uLevel == 0)
+		return a_sFileName;
+	size_t uDot = a_sFileName.find_last_of('.');
+	size_t uSeparator = a_sFileName.find_last_of("/\\");
+	if (uDot == String::npos || (uSeparator != String::npos && uDot < uSeparator))
+		uDot = a_sFileName.size();
+	return a_sFileName.substr(0, uDot) + "_LOD" + std::to_string(a_uLevel) + a_sFileName.substr(uDot);
+}
+bool Simplex::MyLODBuilder::IsFresh(String a_sSource, String a_sFileName)
+{
+	struct stat file;
+	if (stat(a_sFileName.c_str(), &file) != 0)
+		return false;
+
+	struct stat source;
+	if (stat(a_sSource.c_str(), &source) != 0)
+		return true;
+
+	return file.st_mtime >= source.st_mtime;
+}
+bool Simplex::MyLODBuilder::SaveFile(String a_sFileName, String const& a_sContent)
+{
+	String sTemp = a_sFileName + ".tmp";
+	std::ofstream file(sTemp.c_str(), std::ios::binary | std::ios::trunc);
+	if (!file.is_open())
+		return false;
+	file.write(a_sContent.data(), a_sContent.size());
+	file.close();
+	if (file.fail())
+	{
+		std::remove(sTemp.c_str());
+		return false;
+	}
+
+	//rename does not replace a file on every system, the old one goes first
+	std::remove(a_sFileName.c_str());
+	if (std::rename(sTemp.c_str(), a_sFileName.c_str()) != 0)
+	{
+		std::remove(sTemp.c_str());
+		return false;
+	}
+	return true;
+}
+uint Simplex::MyLODBuilder::BuildFiles(String a_sFolder, String a_sFileName)
+{
+	uint uLevels = CountFiles(a_sFolder, a_sFileName);
+	if (uLevels > 0)
+		return uLevels;
+
+	MyLODBuilder builder;
+	if (!builder.Read(a_sFolder + a_sFileName))
+		return 0;
+	uLevels = builder.Build();
+
+	//every level gets its own material library, the loader may look for one named after the file
+	size_t uSeparator = a_sFileName.find_last_of("/\\");
+	String sSubfolder = uSeparator == String::npos ? "" : a_sFileName.substr(0, uSeparator + 1);
+	String sMaterialLibrary = builder.GetMaterialLibrary();
+	std::ifstream material((a_sFolder + sSubfolder + sMaterialLibrary).c_str(), std::ios::binary);
+	String sMaterial((std::istreambuf_iterator<char>(material)), std::istreambuf_iterator<char>());
+	for (uint l = 1; l <= uLevels; ++l)
+	{
+		String sLevelLibrary = sMaterialLibrary == "" ? "" : GetLevelFileName(sMaterialLibrary, l);
+		if (sLevelLibrary != "" && !SaveFile(a_sFolder + sSubfolder + sLevelLibrary, sMaterial))
+			return l - 1;
+		if (!builder.Write(l, a_sFolder + GetLevelFileName(a_sFileName, l), sLevelLibrary))
+			return l - 1;
+	}
+	return uLevels;
+}
+uint Simplex::MyLODBuilder::CountFiles(String a_sFolder, String a_sFileName)
+{
+	String sSource = a_sFolder + a_sFileName;
+	uint uLevels = 0;
+	while (uLevels + 1 < LOD_LEVEL_COUNT &&
+		IsFresh(sSource, a_sFolder + GetLevelFileName(a_sFileName, uLevels + 1)))
+		++uLevels;
+	return uLevels;
+}
@@ -0,0 +1,153 @@
+/*----------------------------------------------
+Programmer: Team "No Name"
+Date: 2018/04
+----------------------------------------------*/
+#ifndef __MYLODBUILDER_H_
+#define __MYLODBUILDER_H_
+
+#include "MyDefinitions.h"
+
+namespace Simplex
+{
+
+//Builds the levels of detail of an OBJ file. Every group and material of the file becomes a mesh of
+//its own once loaded, so each is simplified on its own with MyMeshSimplifier; each level starts from
+//the one before it. The texture coordinates and normals are written back untouched, the corners of
+//the triangles that remain keep theirs, so a level loads like the source with the same materials.
+class MyLODBuilder
+{
+	//A corner of a face as the file has it, 1 based, 0 when it has none
+	struct Corner
+	{
+		int m_nPosition = 0;
+		int m_nUV = 0;
+		int m_nNormal = 0;
+	};
+	//Triangles of a group with one material, the part of the file that becomes a mesh
+	struct Section
+	{
+		String m_sGroup = ""; //name of the group
+		String m_sMaterial = ""; //name of the material
+		std::vector<int> m_lPosition; //positions of the file the section uses, 1 based
+		std::vector<Corner> m_lCorner; //three per triangle, positions index m_lPosition from 0
+	};
+	//A section once simplified
+	struct SectionLevel
+	{
+		std::vector<vector3> m_lPosition; //positions after the collapses, one per position of the section
+		std::vector<Corner> m_lCorner; //three per remaining triangle
+	};
+
+	String m_sMaterialLibrary = ""; //material library the source uses
+	std::vector<vector3> m_lPosition; //positions of the file
+	std::vector<String> m_lUV; //texture coordinate lines as they were read
+	std::vector<String> m_lNormal; //normal lines as they were read
+	std::vector<Section> m_lSection; //groups and materials of the file
+	float m_fRadius = 0.0f; //half of the diagonal of the bounding box of the positions
+	std::vector<std::vector<SectionLevel>> m_lLevel; //simplified levels, level 1 first
+	std::vector<uint> m_lTriangleCount; //triangles of every level, the source included
+
+public:
+	/*
+	USAGE: Reads an OBJ file, faces with more than three corners are split in triangles
+	ARGUMENTS: String a_sFileName -> path to the file
+	OUTPUT: was it read?
+	*/
+	bool Read(String a_sFileName);
+	/*
+	USAGE: Builds the levels, a level that ends up no smaller than the one before is left out
+	ARGUMENTS:
+	-	uint a_uLevels = LOD_LEVEL_COUNT - 1 -> levels to try besides the source
+	-	float a_fRatio = 0.5f -> triangles a level keeps of the source, squared for the second and so on
+	-	float a_fMaxError = 0.1f -> furthest the first level can move the surface as a fraction of the
+		radius of the model, it doubles every level
+	OUTPUT: levels built
+	*/
+	uint Build(uint a_uLevels = LOD_LEVEL_COUNT - 1, float a_fRatio = 0.5f, float a_fMaxError = 0.1f);
+	/*
+	USAGE: Gets the number of levels, the source included
+	ARGUMENTS: ---
+	OUTPUT: levels
+	*/
+	uint GetLevelCount(void) const;
+	/*
+	USAGE: Gets the number of triangles of a level
+	ARGUMENTS: uint a_uLevel -> level, 0 is the source
+	OUTPUT: triangles
+	*/
+	uint GetTriangleCount(uint a_uLevel) const;
+	/*
+	USAGE: Gets the positions the triangles of the source use, the ones a loaded model has
+	ARGUMENTS: std::vector<vector3>& a_lPosition -> positions, cleared first
+	OUTPUT: ---
+	*/
+	void GetUsedPositions(std::vector<vector3>& a_lPosition) const;
+	/*
+	USAGE: Writes a level as an OBJ file, through SaveFile
+	ARGUMENTS:
+	-	uint a_uLevel -> level, from 1
+	-	String a_sFileName -> path to the file
+	-	String a_sMaterialLibrary -> material library the file refers to, the one of the source if empty
+	OUTPUT: was it written?
+	*/
+	bool Write(uint a_uLevel, String a_sFileName, String a_sMaterialLibrary = "") const;
+	/*
+	USAGE: Gets the name of the material library of the source
+	ARGUMENTS: ---
+	OUTPUT: file name as the source has it
+	*/
+	String GetMaterialLibrary(void) const;
+	/*
+	USAGE: Names the file of a level after the one of the source, Cow.obj becomes Cow_LOD1.obj
+	ARGUMENTS:
+	-	String a_sFileName -> name of the source, any extension
+	-	uint a_uLevel -> level
+	OUTPUT: name of the level, the source name for level 0
+	*/
+	static String GetLevelFileName(String a_sFileName, uint a_uLevel);
+	/*
+	USAGE: Tells if a file written from a source is at least as new as the source
+	ARGUMENTS:
+	-	String a_sSource -> path to the source
+	-	String a_sFileName -> path to the file written from it
+	OUTPUT: is the file there and up to date? true if only the source is missing
+	*/
+	static bool IsFresh(String a_sSource, String a_sFileName);
+	/*
+	USAGE: Writes a file to the side and moves it in place, a reader never sees half a file
+	ARGUMENTS:
+	-	String a_sFileName -> path to the file
+	-	String const& a_sContent -> what goes in it
+	OUTPUT: was it written?
+	*/
+	static bool SaveFile(String a_sFileName, String const& a_sContent);
+	/*
+	USAGE: Writes the levels of a model next to its source, Cow.obj gets Cow_LOD1.obj and on with a
+	copy of Cow.mtl each; levels on disk are kept until the source is newer than them. It is a build
+	step, run by C20_Headless --build-lod; the game only loads the levels that are there
+	ARGUMENTS:
+	-	String a_sFolder -> folder the name of the model is relative to
+	-	String a_sFileName -> name of the model, it can start with subfolders
+	OUTPUT: number of levels on disk besides the source
+	*/
+	static uint BuildFiles(String a_sFolder, String a_sFileName);
+	/*
+	USAGE: Counts the levels of a model on disk written since the source last changed, as the binary
+	mesh cache does; a level missing or stale ends the count
+	ARGUMENTS:
+	-	String a_sFolder -> folder the name of the model is relative to
+	-	String a_sFileName -> name of the model, it can start with subfolders
+	OUTPUT: number of levels up to date besides the source
+	*/
+	static uint CountFiles(String a_sFolder, String a_sFileName);
+};//class
+
+} //namespace Simplex
+
+#endif //__MYLODBUILDER_H_
+
+/*
+USAGE:
+ARGUMENTS: ---
+OUTPUT: ---
+*/
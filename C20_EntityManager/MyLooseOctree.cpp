@@ -0,0 +1,331 @@
+#include "MyLooseOctree.h"
+using namespace Simplex;
+//  MyLooseOctree
+Simplex::MyLooseOctree::MyLooseOctree(vector3 a_v3Center, float a_fHalfSize, uint a_uMaxDepth)
+{
+	m_uMaxDepth = a_uMaxDepth;
+
+	Node root;
+	root.m_v3Center = a_v3Center;
+	root.m_fHalfSize = a_fHalfSize;
+	for (uint i = 0; i < 8; ++i)
+		root.m_nChild[i] = -1;
+	m_lNode.push_back(root);
+}
+void Simplex::MyLooseOctree::Insert(uint a_uID, vector3 const& a_v3Min, vector3 const& a_v3Max)
+{
+	//grow the object arrays to hold the id
+	if (a_uID >= m_lObjectNode.size())
+	{
+		m_lObjectNode.resize(a_uID + 1, -1);
+		m_lObjectPrev.resize(a_uID + 1, -1);
+		m_lObjectNext.resize(a_uID + 1, -1);
+		m_v3ObjectMin.resize(a_uID + 1, ZERO_V3);
+		m_v3ObjectMax.resize(a_uID + 1, ZERO_V3);
+	}
+
+	//if it is already in the tree this is a move
+	if (m_lObjectNode[a_uID] >= 0)
+	{
+		Move(a_uID, a_v3Min, a_v3Max);
+		return;
+	}
+
+	m_v3ObjectMin[a_uID] = a_v3Min;
+	m_v3ObjectMax[a_uID] = a_v3Max;
+
+	vector3 v3Center = (a_v3Min + a_v3Max) * 0.5f;
+	vector3 v3Extent = (a_v3Max - a_v3Min) * 0.5f;
+	float fExtent = v3Extent.x > v3Extent.y ? v3Extent.x : v3Extent.y;
+	fExtent = fExtent > v3Extent.z ? fExtent : v3Extent.z;
+
+	Link(a_uID, FindNode(v3Center, fExtent));
+	++m_uObjectCount;
+}
+void Simplex::MyLooseOctree::Remove(uint a_uID)
+{
+	//if it is not in the tree there is nothing to do
+	if (a_uID >= m_lObjectNode.size() || m_lObjectNode[a_uID] < 0)
+		return;
+
+	int nNode = m_lObjectNode[a_uID];
+	Unlink(a_uID);
+	PruneNode(nNode);
+	--m_uObjectCount;
+}
+bool Simplex::MyLooseOctree::Move(uint a_uID, vector3 const& a_v3Min, vector3 const& a_v3Max)
+{
+	//if it is not in the tree insert it
+	if (a_uID >= m_lObjectNode.size() || m_lObjectNode[a_uID] < 0)
+	{
+		Insert(a_uID, a_v3Min, a_v3Max);
+		return true;
+	}
+
+	m_v3ObjectMin[a_uID] = a_v3Min;
+	m_v3ObjectMax[a_uID] = a_v3Max;
+
+	vector3 v3Center = (a_v3Min + a_v3Max) * 0.5f;
+	vector3 v3Extent = (a_v3Max - a_v3Min) * 0.5f;
+	float fExtent = v3Extent.x > v3Extent.y ? v3Extent.x : v3Extent.y;
+	fExtent = fExtent > v3Extent.z ? fExtent : v3Extent.z;
+
+	int nNode = m_lObjectNode[a_uID];
+	if (nNode == 0)
+	{
+		//the root holds whatever does not fit the tree, only go down once it does
+		Node const& root = m_lNode[0];
+		vector3 v3Offset = glm::abs(v3Center - root.m_v3Center);
+		if (m_uMaxDepth == 0 || fExtent > root.m_fHalfSize * 0.5f ||
+			v3Offset.x > root.m_fHalfSize || v3Offset.y > root.m_fHalfSize || v3Offset.z > root.m_fHalfSize)
+			return false;
+	}
+	else if (FitsLoose(nNode, a_v3Min, a_v3Max))
+	{
+		//still inside the loose bounds, nothing changes
+		return false;
+	}
+
+	//it left its node, find the new one and give the old one back if it was emptied
+	Unlink(a_uID);
+	Link(a_uID, FindNode(v3Center, fExtent));
+	PruneNode(nNode);
+	return true;
+}
+uint Simplex::MyLooseOctree::Refit(vector3 const* a_pMin, vector3 const* a_pMax, uint a_uCount)
+{
+	uint uMoved = 0;
+	for (uint i = 0; i < a_uCount; ++i)
+	{
+		if (Move(i, a_pMin[i], a_pMax[i]))
+			++uMoved;
+	}
+	return uMoved;
+}
+void Simplex::MyLooseOctree::Clear(void)
+{
+	m_lNode.resize(1);
+	for (uint i = 0; i < 8; ++i)
+		m_lNode[0].m_nChild[i] = -1;
+	m_lNode[0].m_nFirstObject = -1;
+	m_lNode[0].m_uObjectCount = 0;
+	m_lNode[0].m_uChildCount = 0;
+	m_lFreeNode.clear();
+
+	m_lObjectNode.clear();
+	m_lObjectPrev.clear();
+	m_lObjectNext.clear();
+	m_v3ObjectMin.clear();
+	m_v3ObjectMax.clear();
+	m_uObjectCount = 0;
+}
+uint Simplex::MyLooseOctree::Query(vector3 const& a_v3Min, vector3 const& a_v3Max, std::vector<uint>& a_lResult)
+{
+	a_lResult.clear();
+	m_lStack.clear();
+	m_lStack.push_back(0);
+
+	while (m_lStack.size() > 0)
+	{
+		int nNode = m_lStack.back();
+		m_lStack.pop_back();
+		Node const& node = m_lNode[nNode];
+
+		//the root holds the objects out of the tree so it is always visited
+		if (nNode != 0)
+		{
+			float fLoose = node.m_fHalfSize * 2.0f;
+			if (a_v3Min.x > node.m_v3Center.x + fLoose || a_v3Max.x < node.m_v3Center.x - fLoose ||
+				a_v3Min.y > node.m_v3Center.y + fLoose || a_v3Max.y < node.m_v3Center.y - fLoose ||
+				a_v3Min.z > node.m_v3Center.z + fLoose || a_v3Max.z < node.m_v3Center.z - fLoose)
+				continue;
+		}
+
+		for (int nObject = node.m_nFirstObject; nObject >= 0; nObject = m_lObjectNext[nObject])
+		{
+			vector3 const& v3Min = m_v3ObjectMin[nObject];
+			vector3 const& v3Max = m_v3ObjectMax[nObject];
+			if (v3Min.x <= a_v3Max.x && v3Max.x >= a_v3Min.x &&
+				v3Min.y <= a_v3Max.y && v3Max.y >= a_v3Min.y &&
+				v3Min.z <= a_v3Max.z && v3Max.z >= a_v3Min.z)
+				a_lResult.push_back(static_cast<uint>(nObject));
+		}
+
+		if (node.m_uChildCount == 0)
+			continue;
+		for (uint i = 0; i < 8; ++i)
+		{
+			if (node.m_nChild[i] >= 0)
+				m_lStack.push_back(node.m_nChild[i]);
+		}
+	}
+
+	return a_lResult.size();
+}
+uint Simplex::MyLooseOctree::QueryPairs(std::vector<std::pair<uint, uint>>& a_lPair)
+{
+	a_lPair.clear();
+	//loose bounds of siblings overlap, so each object queries the tree with its own bounds
+	//and keeps the hits with a larger id, every pair is reported once
+	for (uint uA = 0; uA < m_lObjectNode.size(); ++uA)
+	{
+		if (m_lObjectNode[uA] < 0)
+			continue;
+
+		Query(m_v3ObjectMin[uA], m_v3ObjectMax[uA], m_lHit);
+		for (uint i = 0; i < m_lHit.size(); ++i)
+		{
+			if (m_lHit[i] > uA)
+				a_lPair.push_back(std::make_pair(uA, m_lHit[i]));
+		}
+	}
+
+	return a_lPair.size();
+}
+uint Simplex::MyLooseOctree::GetObjectCount(void) const { return m_uObjectCount; }
+uint Simplex::MyLooseOctree::GetNodeCount(void) const { return m_lNode.size() - m_lFreeNode.size(); }
+void Simplex::MyLooseOctree::GetNodeCells(std::vector<vector3>& a_lCenter, std::vector<float>& a_lHalfSize) const
+{
+	a_lCenter.clear();
+	a_lHalfSize.clear();
+	for (uint i = 0; i < m_lNode.size(); ++i)
+	{
+		//nodes back in the pool have no parent, only the root is allowed to
+		if (i != 0 && m_lNode[i].m_nParent < 0)
+			continue;
+		a_lCenter.push_back(m_lNode[i].m_v3Center);
+		a_lHalfSize.push_back(m_lNode[i].m_fHalfSize);
+	}
+}
+// private methods
+int Simplex::MyLooseOctree::AllocateNode(int a_nParent, uint a_uOctant)
+{
+	int nNode = -1;
+	if (m_lFreeNode.size() > 0)
+	{
+		nNode = m_lFreeNode.back();
+		m_lFreeNode.pop_back();
+	}
+	else
+	{
+		nNode = static_cast<int>(m_lNode.size());
+		m_lNode.push_back(Node());
+	}
+
+	//the push back above can move the pool, only take references now
+	Node& parent = m_lNode[a_nParent];
+	Node& node = m_lNode[nNode];
+	float fQuarter = parent.m_fHalfSize * 0.5f;
+	node.m_v3Center = parent.m_v3Center + vector3(
+		(a_uOctant & 1) ? fQuarter : -fQuarter,
+		(a_uOctant & 2) ? fQuarter : -fQuarter,
+		(a_uOctant & 4) ? fQuarter : -fQuarter);
+	node.m_fHalfSize = fQuarter;
+	node.m_uDepth = parent.m_uDepth + 1;
+	node.m_nParent = a_nParent;
+	for (uint i = 0; i < 8; ++i)
+		node.m_nChild[i] = -1;
+	node.m_nFirstObject = -1;
+	node.m_uObjectCount = 0;
+	node.m_uChildCount = 0;
+
+	parent.m_nChild[a_uOctant] = nNode;
+	++parent.m_uChildCount;
+	return nNode;
+}
+void Simplex::MyLooseOctree::PruneNode(int a_nNode)
+{
+	//walk up while the nodes are empty leaves, the root always stays
+	while (a_nNode > 0 && m_lNode[a_nNode].m_uObjectCount == 0 && m_lNode[a_nNode].m_uChildCount == 0)
+	{
+		int nParent = m_lNode[a_nNode].m_nParent;
+		Node& parent = m_lNode[nParent];
+		for (uint i = 0; i < 8; ++i)
+		{
+			if (parent.m_nChild[i] == a_nNode)
+			{
+				parent.m_nChild[i] = -1;
+				--parent.m_uChildCount;
+				break;
+			}
+		}
+		m_lNode[a_nNode].m_nParent = -1;
+		m_lFreeNode.push_back(a_nNode);
+		a_nNode = nParent;
+	}
+}
+int Simplex::MyLooseOctree::FindNode(vector3 const& a_v3Center, float a_fExtent)
+{
+	//if the center is out of the root cell the root keeps it
+	Node const& root = m_lNode[0];
+	vector3 v3Offset = glm::abs(a_v3Center - root.m_v3Center);
+	if (v3Offset.x > root.m_fHalfSize || v3Offset.y > root.m_fHalfSize || v3Offset.z > root.m_fHalfSize)
+		return 0;
+
+	int nNode = 0;
+	while (m_lNode[nNode].m_uDepth < m_uMaxDepth)
+	{
+		Node const& node = m_lNode[nNode];
+		//the children are too small for the object
+		if (a_fExtent > node.m_fHalfSize * 0.5f)
+			break;
+
+		uint uOctant =
+			(a_v3Center.x >= node.m_v3Center.x ? 1 : 0) |
+			(a_v3Center.y >= node.m_v3Center.y ? 2 : 0) |
+			(a_v3Center.z >= node.m_v3Center.z ? 4 : 0);
+
+		int nChild = node.m_nChild[uOctant];
+		if (nChild < 0)
+			nChild = AllocateNode(nNode, uOctant);
+		nNode = nChild;
+	}
+	return nNode;
+}
+void Simplex::MyLooseOctree::Link(uint a_uID, int a_nNode)
+{
+	Node& node = m_lNode[a_nNode];
+	m_lObjectNode[a_uID] = a_nNode;
+	m_lObjectPrev[a_uID] = -1;
+	m_lObjectNext[a_uID] = node.m_nFirstObject;
+	if (node.m_nFirstObject >= 0)
+		m_lObjectPrev[node.m_nFirstObject] = a_uID;
+	node.m_nFirstObject = a_uID;
+	++node.m_uObjectCount;
+}
+void Simplex::MyLooseOctree::Unlink(uint a_uID)
+{
+	Node& node = m_lNode[m_lObjectNode[a_uID]];
+	int nPrev = m_lObjectPrev[a_uID];
+	int nNext = m_lObjectNext[a_uID];
+	if (nPrev >= 0)
+		m_lObjectNext[nPrev] = nNext;
+	else
+		node.m_nFirstObject = nNext;
+	if (nNext >= 0)
+		m_lObjectPrev[nNext] = nPrev;
+	--node.m_uObjectCount;
+
+	m_lObjectNode[a_uID] = -1;
+	m_lObjectPrev[a_uID] = -1;
+	m_lObjectNext[a_uID] = -1;
+}
+bool Simplex::MyLooseOctree::FitsLoose(int a_nNode, vector3 const& a_v3Min, vector3 const& a_v3Max) const
+{
+	Node const& node = m_lNode[a_nNode];
+	float fLoose = node.m_fHalfSize * 2.0f;
+	return	a_v3Min.x >= node.m_v3Center.x - fLoose && a_v3Max.x <= node.m_v3Center.x + fLoose &&
+			a_v3Min.y >= node.m_v3Center.y - fLoose && a_v3Max.y <= node.m_v3Center.y + fLoose &&
+			a_v3Min.z >= node.m_v3Center.z - fLoose && a_v3Max.z <= node.m_v3Center.z + fLoose;
+}
+bool Simplex::MyLooseOctree::Overlap(uint a_uA, uint a_uB) const
+{
+	vector3 const& v3MinA = m_v3ObjectMin[a_uA];
+	vector3 const& v3MaxA = m_v3ObjectMax[a_uA];
+	vector3 const& v3MinB = m_v3ObjectMin[a_uB];
+	vector3 const& v3MaxB = m_v3ObjectMax[a_uB];
+
+	return	v3MinA.x <= v3MaxB.x && v3MaxA.x >= v3MinB.x &&
+			v3MinA.y <= v3MaxB.y && v3MaxA.y >= v3MinB.y &&
+			v3MinA.z <= v3MaxB.z && v3MaxA.z >= v3MinB.z;
+}
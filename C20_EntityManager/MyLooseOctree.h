@@ -0,0 +1,195 @@
+/*----------------------------------------------
+Programmer: Team "No Name"
+Date: 2018/04
+----------------------------------------------*/
+#ifndef __MYLOOSEOCTREE_H_
+#define __MYLOOSEOCTREE_H_
+
+#include "MyDefinitions.h"
+
+namespace Simplex
+{
+
+//Loose octree updated in place. Every node's loose bounds are twice its cell, so an object is
+//stored in the deepest node whose cell holds its center and whose half size is at least the
+//object's largest half extent; it only changes node when it leaves those loose bounds.
+//Nodes come from a pool and objects are linked intrusively, no allocation once warmed up.
+//Objects are identified by a caller chosen id (the index in the entity store).
+class MyLooseOctree
+{
+	struct Node
+	{
+		vector3 m_v3Center = ZERO_V3; //center of the cell
+		float m_fHalfSize = 0.0f; //half size of the cell, the loose bounds are twice as big
+		uint m_uDepth = 0; //depth in the tree, root is 0
+		int m_nParent = -1; //parent node, -1 for the root
+		int m_nChild[8]; //child nodes, -1 if not created
+		int m_nFirstObject = -1; //head of the list of objects in this node
+		uint m_uObjectCount = 0; //number of objects in this node
+		uint m_uChildCount = 0; //number of created children
+	};
+
+	uint m_uMaxDepth = 4; //deepest level a node can be at
+	std::vector<Node> m_lNode; //node pool, node 0 is the root
+	std::vector<int> m_lFreeNode; //nodes in the pool available for reuse
+
+	std::vector<int> m_lObjectNode; //node holding each object, -1 if not in the tree
+	std::vector<int> m_lObjectPrev; //previous object in the same node
+	std::vector<int> m_lObjectNext; //next object in the same node
+	std::vector<vector3> m_v3ObjectMin; //min corner of the bounds of each object
+	std::vector<vector3> m_v3ObjectMax; //max corner of the bounds of each object
+	uint m_uObjectCount = 0; //number of objects in the tree
+
+	std::vector<int> m_lStack; //scratch stack for the traversals
+	std::vector<uint> m_lHit; //scratch list of hits for the pair traversal
+
+public:
+	/*
+	Usage: Constructor
+	Arguments:
+	-	vector3 a_v3Center -> center of the root cell
+	-	float a_fHalfSize -> half size of the root cell
+	-	uint a_uMaxDepth = 4 -> deepest level a node can be at
+	Output: class object instance
+	*/
+	MyLooseOctree(vector3 a_v3Center, float a_fHalfSize, uint a_uMaxDepth = 4);
+	/*
+	USAGE: Inserts an object, if it was already in the tree it gets moved
+	ARGUMENTS:
+	-	uint a_uID -> id of the object
+	-	vector3 const& a_v3Min -> min corner of its bounds
+	-	vector3 const& a_v3Max -> max corner of its bounds
+	OUTPUT: ---
+	*/
+	void Insert(uint a_uID, vector3 const& a_v3Min, vector3 const& a_v3Max);
+	/*
+	USAGE: Removes an object from the tree, empty leaves go back to the pool
+	ARGUMENTS: uint a_uID -> id of the object
+	OUTPUT: ---
+	*/
+	void Remove(uint a_uID);
+	/*
+	USAGE: Updates the bounds of an object, it only changes node when it leaves the loose bounds of its node
+	ARGUMENTS:
+	-	uint a_uID -> id of the object
+	-	vector3 const& a_v3Min -> min corner of its bounds
+	-	vector3 const& a_v3Max -> max corner of its bounds
+	OUTPUT: did it change node?
+	*/
+	bool Move(uint a_uID, vector3 const& a_v3Min, vector3 const& a_v3Max);
+	/*
+	USAGE: Moves every object with the bounds in the arrays, ids are the indices in the arrays
+	ARGUMENTS:
+	-	vector3 const* a_pMin -> min corners
+	-	vector3 const* a_pMax -> max corners
+	-	uint a_uCount -> number of entries
+	OUTPUT: number of objects that changed node
+	*/
+	uint Refit(vector3 const* a_pMin, vector3 const* a_pMax, uint a_uCount);
+	/*
+	USAGE: Removes every object and node but the root
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void Clear(void);
+	/*
+	USAGE: Gets the objects whose bounds overlap the box
+	ARGUMENTS:
+	-	vector3 const& a_v3Min -> min corner of the queried box
+	-	vector3 const& a_v3Max -> max corner of the queried box
+	-	std::vector<uint>& a_lResult -> ids found, cleared first, reuses its capacity
+	OUTPUT: number of ids found
+	*/
+	uint Query(vector3 const& a_v3Min, vector3 const& a_v3Max, std::vector<uint>& a_lResult);
+	/*
+	USAGE: Gets every pair of objects whose bounds overlap
+	ARGUMENTS: std::vector<std::pair<uint, uint>>& a_lPair -> pairs found, cleared first, reuses its capacity
+	OUTPUT: number of pairs found
+	*/
+	uint QueryPairs(std::vector<std::pair<uint, uint>>& a_lPair);
+	/*
+	USAGE: Gets the number of objects in the tree
+	ARGUMENTS: ---
+	OUTPUT: number of objects
+	*/
+	uint GetObjectCount(void) const;
+	/*
+	USAGE: Gets the number of nodes in use, root included
+	ARGUMENTS: ---
+	OUTPUT: number of nodes
+	*/
+	uint GetNodeCount(void) const;
+	/*
+	USAGE: Gets the cells of the nodes in use, for debug drawing
+	ARGUMENTS:
+	-	std::vector<vector3>& a_lCenter -> centers of the cells
+	-	std::vector<float>& a_lHalfSize -> half sizes of the cells
+	OUTPUT: ---
+	*/
+	void GetNodeCells(std::vector<vector3>& a_lCenter, std::vector<float>& a_lHalfSize) const;
+
+private:
+	/*
+	USAGE: Gets a node from the pool
+	ARGUMENTS:
+	-	int a_nParent -> parent of the node
+	-	uint a_uOctant -> octant of the parent the node covers
+	OUTPUT: index of the node
+	*/
+	int AllocateNode(int a_nParent, uint a_uOctant);
+	/*
+	USAGE: Gives empty leaves back to the pool, walking up from the node
+	ARGUMENTS: int a_nNode -> node to start from
+	OUTPUT: ---
+	*/
+	void PruneNode(int a_nNode);
+	/*
+	USAGE: Finds (creating the nodes if needed) the node that should hold the bounds
+	ARGUMENTS:
+	-	vector3 const& a_v3Center -> center of the bounds
+	-	float a_fExtent -> largest half extent of the bounds
+	OUTPUT: index of the node
+	*/
+	int FindNode(vector3 const& a_v3Center, float a_fExtent);
+	/*
+	USAGE: Links the object into the node
+	ARGUMENTS:
+	-	uint a_uID -> id of the object
+	-	int a_nNode -> node to link into
+	OUTPUT: ---
+	*/
+	void Link(uint a_uID, int a_nNode);
+	/*
+	USAGE: Unlinks the object from its node
+	ARGUMENTS: uint a_uID -> id of the object
+	OUTPUT: ---
+	*/
+	void Unlink(uint a_uID);
+	/*
+	USAGE: Tells if the box fits in the loose bounds of the node
+	ARGUMENTS:
+	-	int a_nNode -> node
+	-	vector3 const& a_v3Min -> min corner of the box
+	-	vector3 const& a_v3Max -> max corner of the box
+	OUTPUT: does it fit?
+	*/
+	bool FitsLoose(int a_nNode, vector3 const& a_v3Min, vector3 const& a_v3Max) const;
+	/*
+	USAGE: Tells if both objects' bounds overlap
+	ARGUMENTS:
+	-	uint a_uA -> id of the first object
+	-	uint a_uB -> id of the second object
+	OUTPUT: are they overlapping?
+	*/
+	bool Overlap(uint a_uA, uint a_uB) const;
+};//class
+
+} //namespace Simplex
+
+#endif //__MYLOOSEOCTREE_H_
+
+/*
+USAGE:
+ARGUMENTS: ---
+OUTPUT: ---
+*/
@@ -0,0 +1,284 @@
+#include "MyMeshSimplifier.h"
+#include <algorithm>
+#include <cmath>
+#include <map>
+using namespace Simplex;
+//  MyMeshSimplifier
+Simplex::MyMeshSimplifier::MyMeshSimplifier(std::vector<vector3> const& a_lPosition, std::vector<uint> const& a_lTriangle)
+{
+	uint uVertexCount = static_cast<uint>(a_lPosition.size());
+	m_lPosition = a_lPosition;
+	m_lQuadric.resize(uVertexCount);
+	m_lVersion.resize(uVertexCount, 0);
+	m_lVertexAlive.resize(uVertexCount, false);
+	m_lVertexTriangle.resize(uVertexCount);
+
+	//weld the vertices in the same place to the first one found there
+	std::vector<uint> lWeld(uVertexCount);
+	std::map<std::vector<float>, uint> mapFirst;
+	for (uint i = 0; i < uVertexCount; ++i)
+	{
+		std::vector<float> lKey = { a_lPosition[i].x, a_lPosition[i].y, a_lPosition[i].z };
+		lWeld[i] = mapFirst.insert(std::make_pair(lKey, i)).first->second;
+	}
+
+	uint uTriangleCount = static_cast<uint>(a_lTriangle.size() / 3);
+	m_lTriangle.resize(uTriangleCount * 3);
+	m_lTriangleAlive.resize(uTriangleCount, false);
+	std::map<std::pair<uint, uint>, uint> mapEdgeUse;
+	for (uint t = 0; t < uTriangleCount; ++t)
+	{
+		uint* pCorner = &m_lTriangle[t * 3];
+		for (uint c = 0; c < 3; ++c)
+			pCorner[c] = lWeld[a_lTriangle[t * 3 + c]];
+		if (pCorner[0] == pCorner[1] || pCorner[1] == pCorner[2] || pCorner[2] == pCorner[0])
+			continue; //nothing to draw in the source already
+
+		m_lTriangleAlive[t] = true;
+		++m_uTriangleCount;
+		for (uint c = 0; c < 3; ++c)
+		{
+			m_lVertexAlive[pCorner[c]] = true;
+			m_lVertexTriangle[pCorner[c]].push_back(t);
+			uint uA = pCorner[c];
+			uint uB = pCorner[(c + 1) % 3];
+			++mapEdgeUse[std::make_pair((std::min)(uA, uB), (std::max)(uA, uB))];
+		}
+
+		//every corner has to stay close to the plane of the triangle
+		vector3 v3Cross = glm::cross(m_lPosition[pCorner[1]] - m_lPosition[pCorner[0]], m_lPosition[pCorner[2]] - m_lPosition[pCorner[0]]);
+		float fLength = glm::length(v3Cross);
+		if (fLength <= 0.0f)
+			continue;
+		vector3 v3Normal = v3Cross / fLength;
+		for (uint c = 0; c < 3; ++c)
+			AddPlane(pCorner[c], v3Normal, m_lPosition[pCorner[0]], 1.0);
+	}
+
+	//open edges get a plane across them so the outline of the mesh does not shrink
+	for (uint t = 0; t < uTriangleCount; ++t)
+	{
+		if (!m_lTriangleAlive[t])
+			continue;
+		uint* pCorner = &m_lTriangle[t * 3];
+		vector3 v3Normal = glm::cross(m_lPosition[pCorner[1]] - m_lPosition[pCorner[0]], m_lPosition[pCorner[2]] - m_lPosition[pCorner[0]]);
+		for (uint c = 0; c < 3; ++c)
+		{
+			uint uA = pCorner[c];
+			uint uB = pCorner[(c + 1) % 3];
+			if (mapEdgeUse[std::make_pair((std::min)(uA, uB), (std::max)(uA, uB))] != 1)
+				continue;
+			vector3 v3Across = glm::cross(m_lPosition[uB] - m_lPosition[uA], v3Normal);
+			float fLength = glm::length(v3Across);
+			if (fLength <= 0.0f)
+				continue;
+			AddPlane(uA, v3Across / fLength, m_lPosition[uA], 10.0);
+			AddPlane(uB, v3Across / fLength, m_lPosition[uA], 10.0);
+		}
+	}
+
+	for (uint v = 0; v < uVertexCount; ++v)
+	{
+		std::vector<uint>& lTriangle = m_lVertexTriangle[v];
+		for (uint i = 0; i < lTriangle.size(); ++i)
+		{
+			uint* pCorner = &m_lTriangle[lTriangle[i] * 3];
+			for (uint c = 0; c < 3; ++c)
+			{
+				if (pCorner[c] > v) //each edge once, from its lower vertex
+					PushCollapse(v, pCorner[c]);
+			}
+		}
+	}
+}
+uint Simplex::MyMeshSimplifier::Simplify(uint a_uTargetTriangles, float a_fMaxError)
+{
+	double dMaxCost = static_cast<double>(a_fMaxError) * a_fMaxError;
+	while (m_uTriangleCount > a_uTargetTriangles && !m_lQueue.empty())
+	{
+		Collapse collapse = m_lQueue.front();
+		if (collapse.m_dCost > dMaxCost)
+			break; //everything left moves the surface too much
+		std::pop_heap(m_lQueue.begin(), m_lQueue.end());
+		m_lQueue.pop_back();
+
+		if (!m_lVertexAlive[collapse.m_uKeep] || !m_lVertexAlive[collapse.m_uRemove] ||
+			m_lVersion[collapse.m_uKeep] != collapse.m_uKeepVersion ||
+			m_lVersion[collapse.m_uRemove] != collapse.m_uRemoveVersion)
+			continue; //one of the ends changed since, it was pushed again then
+		if (!IsValid(collapse))
+			continue;
+		Apply(collapse);
+	}
+	return m_uTriangleCount;
+}
+uint Simplex::MyMeshSimplifier::GetTriangleCount(void) const { return m_uTriangleCount; }
+bool Simplex::MyMeshSimplifier::IsTriangleAlive(uint a_uTriangle) const { return m_lTriangleAlive[a_uTriangle]; }
+uint Simplex::MyMeshSimplifier::GetTriangleVertex(uint a_uTriangle, uint a_uCorner) const { return m_lTriangle[a_uTriangle * 3 + a_uCorner]; }
+vector3 const& Simplex::MyMeshSimplifier::GetPosition(uint a_uVertex) const { return m_lPosition[a_uVertex]; }
+void Simplex::MyMeshSimplifier::AddPlane(uint a_uVertex, vector3 const& a_v3Normal, vector3 const& a_v3Point, double a_dWeight)
+{
+	double a = a_v3Normal.x, b = a_v3Normal.y, c = a_v3Normal.z;
+	double d = -(a * a_v3Point.x + b * a_v3Point.y + c * a_v3Point.z);
+	double* pValue = m_lQuadric[a_uVertex].m_dValue;
+	pValue[0] += a_dWeight * a * a; pValue[1] += a_dWeight * a * b; pValue[2] += a_dWeight * a * c; pValue[3] += a_dWeight * a * d;
+	pValue[4] += a_dWeight * b * b; pValue[5] += a_dWeight * b * c; pValue[6] += a_dWeight * b * d;
+	pValue[7] += a_dWeight * c * c; pValue[8] += a_dWeight * c * d;
+	pValue[9] += a_dWeight * d * d;
+}
+double Simplex::MyMeshSimplifier::Evaluate(Quadric const& a_Quadric, vector3 const& a_v3Position)
+{
+	double const* q = a_Quadric.m_dValue;
+	double x = a_v3Position.x, y = a_v3Position.y, z = a_v3Position.z;
+	double dCost = q[0] * x * x + 2.0 * q[1] * x * y + 2.0 * q[2] * x * z + 2.0 * q[3] * x +
+		q[4] * y * y + 2.0 * q[5] * y * z + 2.0 * q[6] * y +
+		q[7] * z * z + 2.0 * q[8] * z +
+		q[9];
+	return (std::max)(dCost, 0.0); //rounding can take it under
+}
+void Simplex::MyMeshSimplifier::PushCollapse(uint a_uKeep, uint a_uRemove)
+{
+	Quadric quadric;
+	for (uint i = 0; i < 10; ++i)
+		quadric.m_dValue[i] = m_lQuadric[a_uKeep].m_dValue[i] + m_lQuadric[a_uRemove].m_dValue[i];
+	double const* q = quadric.m_dValue;
+
+	vector3 const& v3Keep = m_lPosition[a_uKeep];
+	vector3 const& v3Remove = m_lPosition[a_uRemove];
+	vector3 lCandidate[4] = { v3Keep, v3Remove, (v3Keep + v3Remove) * 0.5f, v3Keep };
+	uint uCandidates = 3;
+
+	//the point closest to all the planes solves the 3x3 part of the quadric, when there is one
+	double dDeterminant =
+		q[0] * (q[4] * q[7] - q[5] * q[5]) -
+		q[1] * (q[1] * q[7] - q[5] * q[2]) +
+		q[2] * (q[1] * q[5] - q[4] * q[2]);
+	if (std::abs(dDeterminant) > 1e-10)
+	{
+		double dX = -(q[3] * (q[4] * q[7] - q[5] * q[5]) - q[1] * (q[6] * q[7] - q[5] * q[8]) + q[2] * (q[6] * q[5] - q[4] * q[8])) / dDeterminant;
+		double dY = -(q[0] * (q[6] * q[7] - q[8] * q[5]) - q[3] * (q[1] * q[7] - q[5] * q[2]) + q[2] * (q[1] * q[8] - q[6] * q[2])) / dDeterminant;
+		double dZ = -(q[0] * (q[4] * q[8] - q[5] * q[6]) - q[1] * (q[1] * q[8] - q[6] * q[2]) + q[3] * (q[1] * q[5] - q[4] * q[2])) / dDeterminant;
+		vector3 v3Optimal(static_cast<float>(dX), static_cast<float>(dY), static_cast<float>(dZ));
+		//nearly flat neighborhoods can put it far away, those keep to the edge
+		float fEdge = glm::length(v3Remove - v3Keep);
+		if (glm::length(v3Optimal - lCandidate[2]) <= fEdge * 2.0f)
+			lCandidate[uCandidates++] = v3Optimal;
+	}
+
+	Collapse collapse;
+	collapse.m_uKeep = a_uKeep;
+	collapse.m_uRemove = a_uRemove;
+	collapse.m_uKeepVersion = m_lVersion[a_uKeep];
+	collapse.m_uRemoveVersion = m_lVersion[a_uRemove];
+	collapse.m_dCost = -1.0;
+	for (uint i = 0; i < uCandidates; ++i)
+	{
+		double dCost = Evaluate(quadric, lCandidate[i]);
+		if (collapse.m_dCost < 0.0 || dCost < collapse.m_dCost)
+		{
+			collapse.m_dCost = dCost;
+			collapse.m_v3Position = lCandidate[i];
+		}
+	}
+	m_lQueue.push_back(collapse);
+	std::push_heap(m_lQueue.begin(), m_lQueue.end());
+}
+bool Simplex::MyMeshSimplifier::IsValid(Collapse const& a_Collapse) const
+{
+	uint uKeep = a_Collapse.m_uKeep;
+	uint uRemove = a_Collapse.m_uRemove;
+
+	//the triangles that stay can not turn over or lose their area
+	uint lEnd[2] = { uKeep, uRemove };
+	for (uint e = 0; e < 2; ++e)
+	{
+		std::vector<uint> const& lTriangle = m_lVertexTriangle[lEnd[e]];
+		for (uint i = 0; i < lTriangle.size(); ++i)
+		{
+			uint const* pCorner = &m_lTriangle[lTriangle[i] * 3];
+			bool bKeep = pCorner[0] == uKeep || pCorner[1] == uKeep || pCorner[2] == uKeep;
+			bool bRemove = pCorner[0] == uRemove || pCorner[1] == uRemove || pCorner[2] == uRemove;
+			if (bKeep && bRemove)
+				continue; //goes away with the edge
+
+			vector3 v3Before[3];
+			vector3 v3After[3];
+			for (uint c = 0; c < 3; ++c)
+			{
+				v3Before[c] = m_lPosition[pCorner[c]];
+				v3After[c] = pCorner[c] == lEnd[e] ? a_Collapse.m_v3Position : v3Before[c];
+			}
+			vector3 v3NormalBefore = glm::cross(v3Before[1] - v3Before[0], v3Before[2] - v3Before[0]);
+			vector3 v3NormalAfter = glm::cross(v3After[1] - v3After[0], v3After[2] - v3After[0]);
+			float fLengthBefore = glm::length(v3NormalBefore);
+			float fLengthAfter = glm::length(v3NormalAfter);
+			if (fLengthAfter <= fLengthBefore * 1e-4f)
+				return false;
+			if (fLengthBefore > 0.0f && glm::dot(v3NormalBefore, v3NormalAfter) < 0.2f * fLengthBefore * fLengthAfter)
+				return false;
+		}
+	}
+	return true;
+}
+void Simplex::MyMeshSimplifier::Apply(Collapse const& a_Collapse)
+{
+	uint uKeep = a_Collapse.m_uKeep;
+	uint uRemove = a_Collapse.m_uRemove;
+
+	m_lPosition[uKeep] = a_Collapse.m_v3Position;
+	for (uint i = 0; i < 10; ++i)
+		m_lQuadric[uKeep].m_dValue[i] += m_lQuadric[uRemove].m_dValue[i];
+
+	//triangles on the edge lose their area, the others move over to the vertex that stays
+	std::vector<uint>& lKeepTriangle = m_lVertexTriangle[uKeep];
+	std::vector<uint>& lRemoveTriangle = m_lVertexTriangle[uRemove];
+	for (uint i = 0; i < lRemoveTriangle.size(); ++i)
+	{
+		uint uTriangle = lRemoveTriangle[i];
+		uint* pCorner = &m_lTriangle[uTriangle * 3];
+		if (pCorner[0] == uKeep || pCorner[1] == uKeep || pCorner[2] == uKeep)
+		{
+			m_lTriangleAlive[uTriangle] = false;
+			--m_uTriangleCount;
+			for (uint c = 0; c < 3; ++c)
+			{
+				if (pCorner[c] == uRemove)
+					continue;
+				std::vector<uint>& lTriangle = m_lVertexTriangle[pCorner[c]];
+				lTriangle.erase(std::remove(lTriangle.begin(), lTriangle.end(), uTriangle), lTriangle.end());
+			}
+			continue;
+		}
+		for (uint c = 0; c < 3; ++c)
+		{
+			if (pCorner[c] == uRemove)
+				pCorner[c] = uKeep;
+		}
+		lKeepTriangle.push_back(uTriangle);
+	}
+	lRemoveTriangle.clear();
+	m_lVertexAlive[uRemove] = false;
+	++m_lVersion[uRemove];
+	++m_lVersion[uKeep];
+	if (lKeepTriangle.empty())
+	{
+		m_lVertexAlive[uKeep] = false;
+		return;
+	}
+
+	//the edges around the vertex that stays cost something else now
+	std::vector<uint> lNeighbor;
+	for (uint i = 0; i < lKeepTriangle.size(); ++i)
+	{
+		uint const* pCorner = &m_lTriangle[lKeepTriangle[i] * 3];
+		for (uint c = 0; c < 3; ++c)
+		{
+			if (pCorner[c] != uKeep)
+				lNeighbor.push_back(pCorner[c]);
+		}
+	}
+	std::sort(lNeighbor.begin(), lNeighbor.end());
+	lNeighbor.erase(std::unique(lNeighbor.begin(), lNeighbor.end()), lNeighbor.end());
+	for (uint i = 0; i < lNeighbor.size(); ++i)
+		PushCollapse(uKeep, lNeighbor[i]);
+}
@@ -0,0 +1,141 @@
+/*----------------------------------------------
+Programmer: Team "No Name"
+Date: 2018/04
+----------------------------------------------*/
+#ifndef __MYMESHSIMPLIFIER_H_
+#define __MYMESHSIMPLIFIER_H_
+
+#include "MyDefinitions.h"
+
+namespace Simplex
+{
+
+//Reduces a triangle mesh by collapsing edges, cheapest first. Every vertex carries the planes of the
+//triangles around it as a quadric, the cost of a collapse is the squared distance from the new
+//position to the planes of both ends. Collapses that fold a triangle over are skipped; pieces are
+//allowed to shrink to nothing, which is how the small boxes of the Minecraft models go away. It can
+//be called again with a lower target to get the next level from the last one.
+class MyMeshSimplifier
+{
+	//Sum of squared distances to a set of planes, the upper half of a symmetric 4x4 matrix
+	struct Quadric
+	{
+		double m_dValue[10] = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+	};
+	//A collapse waiting in the queue, stale once either vertex changed after it was pushed
+	struct Collapse
+	{
+		double m_dCost = 0.0; //squared distance it adds
+		uint m_uKeep = 0; //vertex that stays
+		uint m_uRemove = 0; //vertex that goes
+		uint m_uKeepVersion = 0; //versions of both when it was pushed
+		uint m_uRemoveVersion = 0;
+		vector3 m_v3Position; //where the vertex that stays goes
+
+		bool operator<(Collapse const& other) const { return m_dCost > other.m_dCost; }
+	};
+
+	std::vector<vector3> m_lPosition; //position of every vertex, moved by the collapses
+	std::vector<Quadric> m_lQuadric; //planes every vertex has to stay close to
+	std::vector<uint> m_lVersion; //bumped every time a vertex changes
+	std::vector<bool> m_lVertexAlive; //the vertex was not collapsed into another
+	std::vector<std::vector<uint>> m_lVertexTriangle; //living triangles around every vertex
+	std::vector<uint> m_lTriangle; //three vertices per triangle
+	std::vector<bool> m_lTriangleAlive; //the triangle still has an area
+	uint m_uTriangleCount = 0; //living triangles
+	std::vector<Collapse> m_lQueue; //heap of collapses, cheapest on top
+
+public:
+	/*
+	Usage: Constructor, vertices in the same place are welded so the pieces of the mesh are connected
+	Arguments:
+	-	std::vector<vector3> const& a_lPosition -> positions of the vertices
+	-	std::vector<uint> const& a_lTriangle -> three indices in the positions per triangle
+	Output: class object instance
+	*/
+	MyMeshSimplifier(std::vector<vector3> const& a_lPosition, std::vector<uint> const& a_lTriangle);
+	/*
+	USAGE: Collapses edges until the mesh is down to the target or the next collapse costs too much
+	ARGUMENTS:
+	-	uint a_uTargetTriangles -> triangles to get down to
+	-	float a_fMaxError -> furthest the surface can move away from the planes of the source
+	OUTPUT: living triangles
+	*/
+	uint Simplify(uint a_uTargetTriangles, float a_fMaxError);
+	/*
+	USAGE: Gets the number of living triangles
+	ARGUMENTS: ---
+	OUTPUT: triangles
+	*/
+	uint GetTriangleCount(void) const;
+	/*
+	USAGE: Tells if a triangle of the source is still there, triangles keep their index
+	ARGUMENTS: uint a_uTriangle -> index of the triangle in the source
+	OUTPUT: is it alive?
+	*/
+	bool IsTriangleAlive(uint a_uTriangle) const;
+	/*
+	USAGE: Gets a corner of a triangle, corners keep their order so what was attached to them still applies
+	ARGUMENTS:
+	-	uint a_uTriangle -> index of the triangle in the source
+	-	uint a_uCorner -> 0, 1 or 2
+	OUTPUT: vertex of the corner, an index in the source positions
+	*/
+	uint GetTriangleVertex(uint a_uTriangle, uint a_uCorner) const;
+	/*
+	USAGE: Gets the position of a vertex after the collapses
+	ARGUMENTS: uint a_uVertex -> index in the source positions
+	OUTPUT: position
+	*/
+	vector3 const& GetPosition(uint a_uVertex) const;
+
+private:
+	/*
+	USAGE: Adds a plane to the quadric of a vertex
+	ARGUMENTS:
+	-	uint a_uVertex -> vertex
+	-	vector3 const& a_v3Normal -> unit normal of the plane
+	-	vector3 const& a_v3Point -> point on the plane
+	-	double a_dWeight -> how much the plane counts
+	OUTPUT: ---
+	*/
+	void AddPlane(uint a_uVertex, vector3 const& a_v3Normal, vector3 const& a_v3Point, double a_dWeight);
+	/*
+	USAGE: Finds where an edge is best collapsed to and pushes it to the queue
+	ARGUMENTS:
+	-	uint a_uKeep -> vertex that stays
+	-	uint a_uRemove -> vertex that goes
+	OUTPUT: ---
+	*/
+	void PushCollapse(uint a_uKeep, uint a_uRemove);
+	/*
+	USAGE: Evaluates the sum of the quadrics of two vertices at a position
+	ARGUMENTS:
+	-	Quadric const& a_Quadric -> quadric
+	-	vector3 const& a_v3Position -> position
+	OUTPUT: squared distance to the planes
+	*/
+	static double Evaluate(Quadric const& a_Quadric, vector3 const& a_v3Position);
+	/*
+	USAGE: Tells if a collapse leaves every remaining triangle facing the way it did, with an area
+	ARGUMENTS: Collapse const& a_Collapse -> collapse
+	OUTPUT: can it be done?
+	*/
+	bool IsValid(Collapse const& a_Collapse) const;
+	/*
+	USAGE: Moves the vertex that stays, removes the other one and the triangles that lose their area
+	ARGUMENTS: Collapse const& a_Collapse -> collapse
+	OUTPUT: ---
+	*/
+	void Apply(Collapse const& a_Collapse);
+};//class
+
+} //namespace Simplex
+
+#endif //__MYMESHSIMPLIFIER_H_
+
+/*
+USAGE:
+ARGUMENTS: ---
+OUTPUT: ---
+*/
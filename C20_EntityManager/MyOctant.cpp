@@ -1,4 +1,5 @@
 #include "MyOctant.h"
+#include "MyProfiler.h"
 
 // Define the static variables. If this isnt done then we get resolve errors
 typename Simplex::uint Simplex::MyOctant::m_uOctantCount = 0;
@@ -71,6 +72,8 @@ Simplex::MyOctant::~MyOctant()
 /// build tree method on them as well
 void Simplex::MyOctant::BuildTree()
 {
+	MY_PROFILE_FUNCTION();
+
 	// If we have no objects in the entity manager, then return
 	if (m_pEntityManager->GetEntityCount() == 0)
 	{
@@ -0,0 +1,345 @@
+#include "MyPackedBounds.h"
+#ifdef MY_PACKED_AVX
+#include <immintrin.h>
+#elif defined(MY_PACKED_SSE)
+#include <emmintrin.h>
+#endif
+using namespace Simplex;
+//  MyPackedBounds
+Simplex::MyPackedBounds::MyPackedBounds(void) { m_uCount = 0; }
+void Simplex::MyPackedBounds::Reserve(uint a_uCapacity)
+{
+	m_fMinX.reserve(a_uCapacity);
+	m_fMinY.reserve(a_uCapacity);
+	m_fMinZ.reserve(a_uCapacity);
+	m_fMaxX.reserve(a_uCapacity);
+	m_fMaxY.reserve(a_uCapacity);
+	m_fMaxZ.reserve(a_uCapacity);
+	m_fCenterX.reserve(a_uCapacity);
+	m_fCenterY.reserve(a_uCapacity);
+	m_fCenterZ.reserve(a_uCapacity);
+	m_fRadius.reserve(a_uCapacity);
+}
+uint Simplex::MyPackedBounds::Add(vector3 const& a_v3Min, vector3 const& a_v3Max)
+{
+	m_fMinX.push_back(0.0f);
+	m_fMinY.push_back(0.0f);
+	m_fMinZ.push_back(0.0f);
+	m_fMaxX.push_back(0.0f);
+	m_fMaxY.push_back(0.0f);
+	m_fMaxZ.push_back(0.0f);
+	m_fCenterX.push_back(0.0f);
+	m_fCenterY.push_back(0.0f);
+	m_fCenterZ.push_back(0.0f);
+	m_fRadius.push_back(0.0f);
+	Set(m_uCount, a_v3Min, a_v3Max);
+	return m_uCount++;
+}
+void Simplex::MyPackedBounds::Set(uint a_uIndex, vector3 const& a_v3Min, vector3 const& a_v3Max)
+{
+	if (a_uIndex >= m_fMinX.size())
+		return;
+
+	m_fMinX[a_uIndex] = a_v3Min.x;
+	m_fMinY[a_uIndex] = a_v3Min.y;
+	m_fMinZ[a_uIndex] = a_v3Min.z;
+	m_fMaxX[a_uIndex] = a_v3Max.x;
+	m_fMaxY[a_uIndex] = a_v3Max.y;
+	m_fMaxZ[a_uIndex] = a_v3Max.z;
+
+	vector3 v3Center = (a_v3Min + a_v3Max) * 0.5f;
+	m_fCenterX[a_uIndex] = v3Center.x;
+	m_fCenterY[a_uIndex] = v3Center.y;
+	m_fCenterZ[a_uIndex] = v3Center.z;
+	m_fRadius[a_uIndex] = glm::length(a_v3Max - v3Center);
+}
+void Simplex::MyPackedBounds::Remove(uint a_uIndex)
+{
+	if (a_uIndex >= m_uCount)
+		return;
+
+	uint uLast = m_uCount - 1;
+	// if the entry is not the very last we move the last one into its slot
+	if (a_uIndex != uLast)
+	{
+		m_fMinX[a_uIndex] = m_fMinX[uLast];
+		m_fMinY[a_uIndex] = m_fMinY[uLast];
+		m_fMinZ[a_uIndex] = m_fMinZ[uLast];
+		m_fMaxX[a_uIndex] = m_fMaxX[uLast];
+		m_fMaxY[a_uIndex] = m_fMaxY[uLast];
+		m_fMaxZ[a_uIndex] = m_fMaxZ[uLast];
+		m_fCenterX[a_uIndex] = m_fCenterX[uLast];
+		m_fCenterY[a_uIndex] = m_fCenterY[uLast];
+		m_fCenterZ[a_uIndex] = m_fCenterZ[uLast];
+		m_fRadius[a_uIndex] = m_fRadius[uLast];
+	}
+
+	m_fMinX.pop_back();
+	m_fMinY.pop_back();
+	m_fMinZ.pop_back();
+	m_fMaxX.pop_back();
+	m_fMaxY.pop_back();
+	m_fMaxZ.pop_back();
+	m_fCenterX.pop_back();
+	m_fCenterY.pop_back();
+	m_fCenterZ.pop_back();
+	m_fRadius.pop_back();
+	--m_uCount;
+}
+void Simplex::MyPackedBounds::Clear(void)
+{
+	m_fMinX.clear();
+	m_fMinY.clear();
+	m_fMinZ.clear();
+	m_fMaxX.clear();
+	m_fMaxY.clear();
+	m_fMaxZ.clear();
+	m_fCenterX.clear();
+	m_fCenterY.clear();
+	m_fCenterZ.clear();
+	m_fRadius.clear();
+	m_uCount = 0;
+}
+uint Simplex::MyPackedBounds::GetCount(void) const { return m_uCount; }
+uint Simplex::MyPackedBounds::QueryBox(vector3 const& a_v3Min, vector3 const& a_v3Max, std::vector<uint>& a_lResult) const
+{
+	a_lResult.clear();
+
+	//test 32 entries at a time and only walk the bits of the blocks that hit something
+	for (uint uStart = 0; uStart < m_uCount; uStart += 32)
+	{
+		uint uEnd = m_uCount - uStart > 32 ? uStart + 32 : m_uCount;
+		uint uMask = TestBox(a_v3Min, a_v3Max, uStart, uEnd);
+		for (uint uIndex = uStart; uMask != 0; ++uIndex, uMask >>= 1)
+		{
+			if (uMask & 1u)
+				a_lResult.push_back(uIndex);
+		}
+	}
+
+	return a_lResult.size();
+}
+uint Simplex::MyPackedBounds::QueryBoxMask(vector3 const& a_v3Min, vector3 const& a_v3Max, std::vector<uint>& a_lMask) const
+{
+	a_lMask.resize((m_uCount + 31) / 32);
+
+	uint uHits = 0;
+	for (uint uStart = 0; uStart < m_uCount; uStart += 32)
+	{
+		uint uEnd = m_uCount - uStart > 32 ? uStart + 32 : m_uCount;
+		uint uMask = TestBox(a_v3Min, a_v3Max, uStart, uEnd);
+		a_lMask[uStart / 32] = uMask;
+		for (; uMask != 0; uMask &= uMask - 1)
+			++uHits;
+	}
+
+	return uHits;
+}
+uint Simplex::MyPackedBounds::QuerySphere(vector3 const& a_v3Center, float a_fRadius, std::vector<uint>& a_lResult) const
+{
+	a_lResult.clear();
+
+	for (uint uStart = 0; uStart < m_uCount; uStart += 32)
+	{
+		uint uEnd = m_uCount - uStart > 32 ? uStart + 32 : m_uCount;
+		uint uMask = TestSphere(a_v3Center, a_fRadius, uStart, uEnd);
+		for (uint uIndex = uStart; uMask != 0; ++uIndex, uMask >>= 1)
+		{
+			if (uMask & 1u)
+				a_lResult.push_back(uIndex);
+		}
+	}
+
+	return a_lResult.size();
+}
+uint Simplex::MyPackedBounds::QueryFrustumMask(MyFrustum const& a_Frustum, std::vector<uint>& a_lMask) const
+{
+	a_lMask.resize((m_uCount + 31) / 32);
+
+	uint uHits = 0;
+	for (uint uStart = 0; uStart < m_uCount; uStart += 32)
+	{
+		uint uEnd = m_uCount - uStart > 32 ? uStart + 32 : m_uCount;
+		uint uMask = TestFrustum(a_Frustum, uStart, uEnd);
+		a_lMask[uStart / 32] = uMask;
+		for (; uMask != 0; uMask &= uMask - 1)
+			++uHits;
+	}
+
+	return uHits;
+}
+// private methods
+uint Simplex::MyPackedBounds::TestBox(vector3 const& a_v3Min, vector3 const& a_v3Max, uint a_uStart, uint a_uEnd) const
+{
+	uint uMask = 0;
+	uint i = a_uStart;
+
+#ifdef MY_PACKED_AVX
+	__m256 qMinX = _mm256_set1_ps(a_v3Min.x);
+	__m256 qMinY = _mm256_set1_ps(a_v3Min.y);
+	__m256 qMinZ = _mm256_set1_ps(a_v3Min.z);
+	__m256 qMaxX = _mm256_set1_ps(a_v3Max.x);
+	__m256 qMaxY = _mm256_set1_ps(a_v3Max.y);
+	__m256 qMaxZ = _mm256_set1_ps(a_v3Max.z);
+	for (; i + 8 <= a_uEnd; i += 8)
+	{
+		__m256 hit = _mm256_and_ps(
+			_mm256_cmp_ps(_mm256_loadu_ps(&m_fMinX[i]), qMaxX, _CMP_LE_OQ),
+			_mm256_cmp_ps(_mm256_loadu_ps(&m_fMaxX[i]), qMinX, _CMP_GE_OQ));
+		hit = _mm256_and_ps(hit, _mm256_cmp_ps(_mm256_loadu_ps(&m_fMinY[i]), qMaxY, _CMP_LE_OQ));
+		hit = _mm256_and_ps(hit, _mm256_cmp_ps(_mm256_loadu_ps(&m_fMaxY[i]), qMinY, _CMP_GE_OQ));
+		hit = _mm256_and_ps(hit, _mm256_cmp_ps(_mm256_loadu_ps(&m_fMinZ[i]), qMaxZ, _CMP_LE_OQ));
+		hit = _mm256_and_ps(hit, _mm256_cmp_ps(_mm256_loadu_ps(&m_fMaxZ[i]), qMinZ, _CMP_GE_OQ));
+		uMask |= static_cast<uint>(_mm256_movemask_ps(hit)) << (i - a_uStart);
+	}
+#endif
+#ifdef MY_PACKED_SSE
+	__m128 vMinX = _mm_set1_ps(a_v3Min.x);
+	__m128 vMinY = _mm_set1_ps(a_v3Min.y);
+	__m128 vMinZ = _mm_set1_ps(a_v3Min.z);
+	__m128 vMaxX = _mm_set1_ps(a_v3Max.x);
+	__m128 vMaxY = _mm_set1_ps(a_v3Max.y);
+	__m128 vMaxZ = _mm_set1_ps(a_v3Max.z);
+	for (; i + 4 <= a_uEnd; i += 4)
+	{
+		__m128 hit = _mm_and_ps(
+			_mm_cmple_ps(_mm_loadu_ps(&m_fMinX[i]), vMaxX),
+			_mm_cmpge_ps(_mm_loadu_ps(&m_fMaxX[i]), vMinX));
+		hit = _mm_and_ps(hit, _mm_cmple_ps(_mm_loadu_ps(&m_fMinY[i]), vMaxY));
+		hit = _mm_and_ps(hit, _mm_cmpge_ps(_mm_loadu_ps(&m_fMaxY[i]), vMinY));
+		hit = _mm_and_ps(hit, _mm_cmple_ps(_mm_loadu_ps(&m_fMinZ[i]), vMaxZ));
+		hit = _mm_and_ps(hit, _mm_cmpge_ps(_mm_loadu_ps(&m_fMaxZ[i]), vMinZ));
+		uMask |= static_cast<uint>(_mm_movemask_ps(hit)) << (i - a_uStart);
+	}
+#endif
+	//whatever does not fill a register
+	for (; i < a_uEnd; ++i)
+	{
+		if (m_fMinX[i] <= a_v3Max.x && m_fMaxX[i] >= a_v3Min.x &&
+			m_fMinY[i] <= a_v3Max.y && m_fMaxY[i] >= a_v3Min.y &&
+			m_fMinZ[i] <= a_v3Max.z && m_fMaxZ[i] >= a_v3Min.z)
+			uMask |= 1u << (i - a_uStart);
+	}
+
+	return uMask;
+}
+uint Simplex::MyPackedBounds::TestSphere(vector3 const& a_v3Center, float a_fRadius, uint a_uStart, uint a_uEnd) const
+{
+	uint uMask = 0;
+	uint i = a_uStart;
+
+#ifdef MY_PACKED_AVX
+	__m256 qX = _mm256_set1_ps(a_v3Center.x);
+	__m256 qY = _mm256_set1_ps(a_v3Center.y);
+	__m256 qZ = _mm256_set1_ps(a_v3Center.z);
+	__m256 qRadius = _mm256_set1_ps(a_fRadius);
+	for (; i + 8 <= a_uEnd; i += 8)
+	{
+		__m256 dX = _mm256_sub_ps(_mm256_loadu_ps(&m_fCenterX[i]), qX);
+		__m256 dY = _mm256_sub_ps(_mm256_loadu_ps(&m_fCenterY[i]), qY);
+		__m256 dZ = _mm256_sub_ps(_mm256_loadu_ps(&m_fCenterZ[i]), qZ);
+		__m256 distance = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dX, dX), _mm256_mul_ps(dY, dY)), _mm256_mul_ps(dZ, dZ));
+		__m256 reach = _mm256_add_ps(_mm256_loadu_ps(&m_fRadius[i]), qRadius);
+		__m256 hit = _mm256_cmp_ps(distance, _mm256_mul_ps(reach, reach), _CMP_LE_OQ);
+		uMask |= static_cast<uint>(_mm256_movemask_ps(hit)) << (i - a_uStart);
+	}
+#endif
+#ifdef MY_PACKED_SSE
+	__m128 vX = _mm_set1_ps(a_v3Center.x);
+	__m128 vY = _mm_set1_ps(a_v3Center.y);
+	__m128 vZ = _mm_set1_ps(a_v3Center.z);
+	__m128 vRadius = _mm_set1_ps(a_fRadius);
+	for (; i + 4 <= a_uEnd; i += 4)
+	{
+		__m128 dX = _mm_sub_ps(_mm_loadu_ps(&m_fCenterX[i]), vX);
+		__m128 dY = _mm_sub_ps(_mm_loadu_ps(&m_fCenterY[i]), vY);
+		__m128 dZ = _mm_sub_ps(_mm_loadu_ps(&m_fCenterZ[i]), vZ);
+		__m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dX, dX), _mm_mul_ps(dY, dY)), _mm_mul_ps(dZ, dZ));
+		__m128 reach = _mm_add_ps(_mm_loadu_ps(&m_fRadius[i]), vRadius);
+		__m128 hit = _mm_cmple_ps(distance, _mm_mul_ps(reach, reach));
+		uMask |= static_cast<uint>(_mm_movemask_ps(hit)) << (i - a_uStart);
+	}
+#endif
+	//whatever does not fill a register
+	for (; i < a_uEnd; ++i)
+	{
+		float fX = m_fCenterX[i] - a_v3Center.x;
+		float fY = m_fCenterY[i] - a_v3Center.y;
+		float fZ = m_fCenterZ[i] - a_v3Center.z;
+		float fReach = m_fRadius[i] + a_fRadius;
+		if (fX * fX + fY * fY + fZ * fZ <= fReach * fReach)
+			uMask |= 1u << (i - a_uStart);
+	}
+
+	return uMask;
+}
+uint Simplex::MyPackedBounds::TestFrustum(MyFrustum const& a_Frustum, uint a_uStart, uint a_uEnd) const
+{
+	//every plane tests the corner of the boxes furthest along its normal, which array holds that
+	//corner only depends on the signs of the normal so it is picked once for the whole run
+	float const* pCorner[MyFrustum::PlaneCount][3];
+	for (uint p = 0; p < MyFrustum::PlaneCount; ++p)
+	{
+		vector4 const& v4Plane = a_Frustum.GetPlane(static_cast<MyFrustum::Plane>(p));
+		pCorner[p][0] = v4Plane.x > 0.0f ? m_fMaxX.data() : m_fMinX.data();
+		pCorner[p][1] = v4Plane.y > 0.0f ? m_fMaxY.data() : m_fMinY.data();
+		pCorner[p][2] = v4Plane.z > 0.0f ? m_fMaxZ.data() : m_fMinZ.data();
+	}
+
+	uint uMask = 0;
+	uint i = a_uStart;
+
+#ifdef MY_PACKED_AVX
+	for (; i + 8 <= a_uEnd; i += 8)
+	{
+		__m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+		for (uint p = 0; p < MyFrustum::PlaneCount; ++p)
+		{
+			vector4 const& v4Plane = a_Frustum.GetPlane(static_cast<MyFrustum::Plane>(p));
+			__m256 distance = _mm256_add_ps(
+				_mm256_add_ps(
+					_mm256_mul_ps(_mm256_loadu_ps(pCorner[p][0] + i), _mm256_set1_ps(v4Plane.x)),
+					_mm256_mul_ps(_mm256_loadu_ps(pCorner[p][1] + i), _mm256_set1_ps(v4Plane.y))),
+				_mm256_add_ps(
+					_mm256_mul_ps(_mm256_loadu_ps(pCorner[p][2] + i), _mm256_set1_ps(v4Plane.z)),
+					_mm256_set1_ps(v4Plane.w)));
+			inside = _mm256_and_ps(inside, _mm256_cmp_ps(distance, _mm256_setzero_ps(), _CMP_GE_OQ));
+		}
+		uMask |= static_cast<uint>(_mm256_movemask_ps(inside)) << (i - a_uStart);
+	}
+#endif
+#ifdef MY_PACKED_SSE
+	for (; i + 4 <= a_uEnd; i += 4)
+	{
+		__m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+		for (uint p = 0; p < MyFrustum::PlaneCount; ++p)
+		{
+			vector4 const& v4Plane = a_Frustum.GetPlane(static_cast<MyFrustum::Plane>(p));
+			__m128 distance = _mm_add_ps(
+				_mm_add_ps(
+					_mm_mul_ps(_mm_loadu_ps(pCorner[p][0] + i), _mm_set1_ps(v4Plane.x)),
+					_mm_mul_ps(_mm_loadu_ps(pCorner[p][1] + i), _mm_set1_ps(v4Plane.y))),
+				_mm_add_ps(
+					_mm_mul_ps(_mm_loadu_ps(pCorner[p][2] + i), _mm_set1_ps(v4Plane.z)),
+					_mm_set1_ps(v4Plane.w)));
+			inside = _mm_and_ps(inside, _mm_cmpge_ps(distance, _mm_setzero_ps()));
+		}
+		uMask |= static_cast<uint>(_mm_movemask_ps(inside)) << (i - a_uStart);
+	}
+#endif
+	//whatever does not fill a register
+	for (; i < a_uEnd; ++i)
+	{
+		bool bInside = true;
+		for (uint p = 0; p < MyFrustum::PlaneCount && bInside; ++p)
+		{
+			vector4 const& v4Plane = a_Frustum.GetPlane(static_cast<MyFrustum::Plane>(p));
+			bInside = (pCorner[p][0][i] * v4Plane.x + pCorner[p][1][i] * v4Plane.y) +
+				(pCorner[p][2][i] * v4Plane.z + v4Plane.w) >= 0.0f;
+		}
+		if (bInside)
+			uMask |= 1u << (i - a_uStart);
+	}
+
+	return uMask;
+}
@@ -0,0 +1,165 @@
+/*----------------------------------------------
+Programmer: Team "No Name"
+Date: 2018/04
+----------------------------------------------*/
+#ifndef __MYPACKEDBOUNDS_H_
+#define __MYPACKEDBOUNDS_H_
+
+#include "MyDefinitions.h"
+#include "MyFrustum.h"
+
+//SSE2 is always there on x64 and on x86 builds with /arch:SSE2, AVX only when the compiler targets it
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MY_PACKED_SSE
+#endif
+#if defined(MY_PACKED_SSE) && defined(__AVX__)
+#define MY_PACKED_AVX
+#endif
+
+namespace Simplex
+{
+
+//World bounds of every entity split in one float array per component, so a single query box or
+//sphere can be tested against 4 (SSE) or 8 (AVX) entries per instruction. Indexed like the
+//entity store, which keeps it in sync, removal swaps the last element into the hole.
+class MyPackedBounds
+{
+	uint m_uCount = 0; //number of entries in every array
+
+	std::vector<float> m_fMinX; //min corner of the box, per component
+	std::vector<float> m_fMinY;
+	std::vector<float> m_fMinZ;
+	std::vector<float> m_fMaxX; //max corner of the box, per component
+	std::vector<float> m_fMaxY;
+	std::vector<float> m_fMaxZ;
+	std::vector<float> m_fCenterX; //center of the bounding sphere, per component
+	std::vector<float> m_fCenterY;
+	std::vector<float> m_fCenterZ;
+	std::vector<float> m_fRadius; //radius of the bounding sphere
+
+public:
+	/*
+	Usage: Constructor
+	Arguments: ---
+	Output: class object instance
+	*/
+	MyPackedBounds(void);
+	/*
+	USAGE: Reserves space in every array to avoid reallocations while adding
+	ARGUMENTS: uint a_uCapacity -> number of entries expected
+	OUTPUT: ---
+	*/
+	void Reserve(uint a_uCapacity);
+	/*
+	USAGE: Adds an entry at the end of the arrays
+	ARGUMENTS:
+	-	vector3 const& a_v3Min -> min corner of the box
+	-	vector3 const& a_v3Max -> max corner of the box
+	OUTPUT: index of the new entry
+	*/
+	uint Add(vector3 const& a_v3Min, vector3 const& a_v3Max);
+	/*
+	USAGE: Sets the box of the entry, the sphere is the one around the box
+	ARGUMENTS:
+	-	uint a_uIndex -> index of the entry
+	-	vector3 const& a_v3Min -> min corner of the box
+	-	vector3 const& a_v3Max -> max corner of the box
+	OUTPUT: ---
+	*/
+	void Set(uint a_uIndex, vector3 const& a_v3Min, vector3 const& a_v3Max);
+	/*
+	USAGE: Removes the entry by moving the last one into its slot
+	ARGUMENTS: uint a_uIndex -> index of the entry to remove
+	OUTPUT: ---
+	*/
+	void Remove(uint a_uIndex);
+	/*
+	USAGE: Removes every entry
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void Clear(void);
+	/*
+	USAGE: Gets the number of entries
+	ARGUMENTS: ---
+	OUTPUT: number of entries
+	*/
+	uint GetCount(void) const;
+	/*
+	USAGE: Gets the entries whose box overlaps the queried box
+	ARGUMENTS:
+	-	vector3 const& a_v3Min -> min corner of the queried box
+	-	vector3 const& a_v3Max -> max corner of the queried box
+	-	std::vector<uint>& a_lResult -> indices found in increasing order, cleared first, reuses its capacity
+	OUTPUT: number of indices found
+	*/
+	uint QueryBox(vector3 const& a_v3Min, vector3 const& a_v3Max, std::vector<uint>& a_lResult) const;
+	/*
+	USAGE: Gets a bit per entry telling if its box overlaps the queried box
+	ARGUMENTS:
+	-	vector3 const& a_v3Min -> min corner of the queried box
+	-	vector3 const& a_v3Max -> max corner of the queried box
+	-	std::vector<uint>& a_lMask -> bit i % 32 of word i / 32 is set for entry i, resized to fit
+	OUTPUT: number of bits set
+	*/
+	uint QueryBoxMask(vector3 const& a_v3Min, vector3 const& a_v3Max, std::vector<uint>& a_lMask) const;
+	/*
+	USAGE: Gets the entries whose bounding sphere overlaps the queried sphere
+	ARGUMENTS:
+	-	vector3 const& a_v3Center -> center of the queried sphere
+	-	float a_fRadius -> radius of the queried sphere
+	-	std::vector<uint>& a_lResult -> indices found in increasing order, cleared first, reuses its capacity
+	OUTPUT: number of indices found
+	*/
+	uint QuerySphere(vector3 const& a_v3Center, float a_fRadius, std::vector<uint>& a_lResult) const;
+	/*
+	USAGE: Gets a bit per entry telling if its box is at least partly inside the frustum
+	ARGUMENTS:
+	-	MyFrustum const& a_Frustum -> planes of the camera
+	-	std::vector<uint>& a_lMask -> bit i % 32 of word i / 32 is set for entry i, resized to fit
+	OUTPUT: number of bits set
+	*/
+	uint QueryFrustumMask(MyFrustum const& a_Frustum, std::vector<uint>& a_lMask) const;
+
+private:
+	/*
+	USAGE: Tests a run of entries against the box and writes a bit per entry, the entries
+	before the start are assumed to be done already
+	ARGUMENTS:
+	-	vector3 const& a_v3Min -> min corner of the queried box
+	-	vector3 const& a_v3Max -> max corner of the queried box
+	-	uint a_uStart -> first entry to test
+	-	uint a_uEnd -> one past the last entry to test, at most 32 after the start
+	OUTPUT: bit i is set if entry a_uStart + i overlaps
+	*/
+	uint TestBox(vector3 const& a_v3Min, vector3 const& a_v3Max, uint a_uStart, uint a_uEnd) const;
+	/*
+	USAGE: Tests a run of entries against the sphere and writes a bit per entry
+	ARGUMENTS:
+	-	vector3 const& a_v3Center -> center of the queried sphere
+	-	float a_fRadius -> radius of the queried sphere
+	-	uint a_uStart -> first entry to test
+	-	uint a_uEnd -> one past the last entry to test, at most 32 after the start
+	OUTPUT: bit i is set if entry a_uStart + i overlaps
+	*/
+	uint TestSphere(vector3 const& a_v3Center, float a_fRadius, uint a_uStart, uint a_uEnd) const;
+	/*
+	USAGE: Tests a run of entries against the planes of a frustum and writes a bit per entry
+	ARGUMENTS:
+	-	MyFrustum const& a_Frustum -> planes of the camera
+	-	uint a_uStart -> first entry to test
+	-	uint a_uEnd -> one past the last entry to test, at most 32 after the start
+	OUTPUT: bit i is set if entry a_uStart + i is at least partly inside
+	*/
+	uint TestFrustum(MyFrustum const& a_Frustum, uint a_uStart, uint a_uEnd) const;
+};//class
+
+} //namespace Simplex
+
+#endif //__MYPACKEDBOUNDS_H_
+
+/*
+USAGE:
+ARGUMENTS: ---
+OUTPUT: ---
+*/
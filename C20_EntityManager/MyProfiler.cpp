@@ -0,0 +1,220 @@
+#include "MyProfiler.h"
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+namespace Simplex
+{
+	//Events a thread ended and the profiler has not collected yet. Only the owning thread writes,
+	//only the main thread reads at the frame marker, so the two indices are all the sync needed
+	struct MyProfileThread
+	{
+		static const uint RING_SIZE = 1 << 14; //zones a thread can end between two markers
+		MyProfileEvent m_lRing[RING_SIZE]; //events, by index modulo the size
+		std::atomic<uint> m_uWrite; //events written, owning thread
+		std::atomic<uint> m_uRead; //events collected, main thread
+		std::atomic<uint> m_uDropped; //events dropped because the ring was full
+		uint m_uDepth = 0; //zones the thread is in
+		uint m_uIndex = 0; //index in the profiler
+		String m_sName = ""; //name shown for the thread
+
+		MyProfileThread(void) : m_uWrite(0), m_uRead(0), m_uDropped(0) {}
+	};
+
+	//ring of the calling thread, valid while the generation matches the profiler that made it
+	static thread_local MyProfileThread* t_pProfileThread = nullptr;
+	static thread_local uint t_uProfileGeneration = 0;
+	static std::atomic<uint> s_uProfileGeneration(1);
+
+	//Escapes a name for a json string
+	static String EscapeJSON(String a_sInput)
+	{
+		String sOutput;
+		for (uint i = 0; i < a_sInput.size(); ++i)
+		{
+			char c = a_sInput[i];
+			if (c == '"' || c == '\\')
+				sOutput += '\\';
+			if (static_cast<unsigned char>(c) >= 0x20)
+				sOutput += c;
+		}
+		return sOutput;
+	}
+}
+using namespace Simplex;
+//  MyProfiler
+MyProfiler* MyProfiler::m_pInstance = nullptr;
+MyProfiler* MyProfiler::GetInstance()
+{
+	if (m_pInstance == nullptr)
+	{
+		m_pInstance = new MyProfiler();
+	}
+	return m_pInstance;
+}
+void MyProfiler::ReleaseInstance()
+{
+	if (m_pInstance != nullptr)
+	{
+		delete m_pInstance;
+		m_pInstance = nullptr;
+	}
+}
+Simplex::MyProfiler::MyProfiler(void)
+{
+	m_lFrame.resize(300);
+	m_nFrameStart = GetTimeNanoseconds();
+}
+Simplex::MyProfiler::MyProfiler(MyProfiler const& other) { }
+MyProfiler& Simplex::MyProfiler::operator=(MyProfiler const& other) { return *this; }
+Simplex::MyProfiler::~MyProfiler(void)
+{
+	//the threads that still point to their rings make new ones next time
+	++s_uProfileGeneration;
+	for (uint i = 0; i < m_lThread.size(); ++i)
+		delete m_lThread[i];
+	m_lThread.clear();
+}
+long long Simplex::MyProfiler::GetTimeNanoseconds(void)
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+MyProfileThread* Simplex::MyProfiler::GetThread(void)
+{
+	uint uGeneration = s_uProfileGeneration.load(std::memory_order_relaxed);
+	if (t_pProfileThread != nullptr && t_uProfileGeneration == uGeneration)
+		return t_pProfileThread;
+
+	//first zone of this thread, the profiler has to exist already (the main thread makes it)
+	MyProfiler* pProfiler = GetInstance();
+	std::lock_guard<std::mutex> lock(pProfiler->m_ThreadLock);
+	MyProfileThread* pThread = new MyProfileThread();
+	pThread->m_uIndex = pProfiler->m_lThread.size();
+	pThread->m_sName = "Thread " + std::to_string(pThread->m_uIndex);
+	pProfiler->m_lThread.push_back(pThread);
+
+	t_pProfileThread = pThread;
+	t_uProfileGeneration = uGeneration;
+	return pThread;
+}
+long long Simplex::MyProfiler::BeginZone(void)
+{
+	++GetThread()->m_uDepth;
+	return GetTimeNanoseconds();
+}
+void Simplex::MyProfiler::EndZone(const char* a_sName, long long a_nStart)
+{
+	long long nEnd = GetTimeNanoseconds();
+	MyProfileThread* pThread = GetThread();
+	--pThread->m_uDepth;
+
+	uint uWrite = pThread->m_uWrite.load(std::memory_order_relaxed);
+	if (uWrite - pThread->m_uRead.load(std::memory_order_acquire) >= MyProfileThread::RING_SIZE)
+	{
+		pThread->m_uDropped.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+	MyProfileEvent& event = pThread->m_lRing[uWrite % MyProfileThread::RING_SIZE];
+	event.m_sName = a_sName;
+	event.m_nStart = a_nStart;
+	event.m_nEnd = nEnd;
+	event.m_uDepth = pThread->m_uDepth;
+	event.m_uThread = pThread->m_uIndex;
+	pThread->m_uWrite.store(uWrite + 1, std::memory_order_release);
+}
+void Simplex::MyProfiler::SetThreadName(String a_sName)
+{
+	MyProfileThread* pThread = GetThread();
+	std::lock_guard<std::mutex> lock(m_ThreadLock);
+	pThread->m_sName = a_sName;
+}
+void Simplex::MyProfiler::EndFrame(void)
+{
+	long long nNow = GetTimeNanoseconds();
+	MyProfileFrame& frame = m_lFrame[m_uFrameCount % m_lFrame.size()];
+	frame.m_nStart = m_nFrameStart;
+	frame.m_nEnd = nNow;
+	frame.m_lEvent.clear();
+
+	//the lock only keeps the list from growing meanwhile, the threads never take it to write
+	std::lock_guard<std::mutex> lock(m_ThreadLock);
+	for (uint t = 0; t < m_lThread.size(); ++t)
+	{
+		MyProfileThread* pThread = m_lThread[t];
+		uint uRead = pThread->m_uRead.load(std::memory_order_relaxed);
+		uint uWrite = pThread->m_uWrite.load(std::memory_order_acquire);
+		for (; uRead != uWrite; ++uRead)
+			frame.m_lEvent.push_back(pThread->m_lRing[uRead % MyProfileThread::RING_SIZE]);
+		pThread->m_uRead.store(uRead, std::memory_order_release);
+	}
+
+	m_nFrameStart = nNow;
+	++m_uFrameCount;
+}
+MyProfileFrame const* Simplex::MyProfiler::GetFrame(uint a_uAgo) const
+{
+	if (a_uAgo >= m_uFrameCount || a_uAgo >= m_lFrame.size())
+		return nullptr;
+	return &m_lFrame[(m_uFrameCount - 1 - a_uAgo) % m_lFrame.size()];
+}
+uint Simplex::MyProfiler::GetFrameHistory(void) const { return m_lFrame.size(); }
+uint Simplex::MyProfiler::GetFrameCount(void) const { return m_uFrameCount; }
+uint Simplex::MyProfiler::GetThreadCount(void)
+{
+	std::lock_guard<std::mutex> lock(m_ThreadLock);
+	return m_lThread.size();
+}
+String Simplex::MyProfiler::GetThreadName(uint a_uThread)
+{
+	std::lock_guard<std::mutex> lock(m_ThreadLock);
+	if (a_uThread >= m_lThread.size())
+		return "";
+	return m_lThread[a_uThread]->m_sName;
+}
+uint Simplex::MyProfiler::GetDroppedCount(void)
+{
+	std::lock_guard<std::mutex> lock(m_ThreadLock);
+	uint uDropped = 0;
+	for (uint t = 0; t < m_lThread.size(); ++t)
+		uDropped += m_lThread[t]->m_uDropped.load(std::memory_order_relaxed);
+	return uDropped;
+}
+bool Simplex::MyProfiler::SaveChromeTrace(String a_sFileName)
+{
+	std::ofstream file(a_sFileName.c_str());
+	if (!file.is_open())
+		return false;
+
+	//times go in microseconds from the start of the oldest frame kept
+	uint uFrames = m_uFrameCount < m_lFrame.size() ? m_uFrameCount : m_lFrame.size();
+	long long nOrigin = uFrames > 0 ? GetFrame(uFrames - 1)->m_nStart : 0;
+	file << std::fixed << std::setprecision(3);
+	file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+	bool bFirst = true;
+	{
+		std::lock_guard<std::mutex> lock(m_ThreadLock);
+		for (uint t = 0; t < m_lThread.size(); ++t)
+		{
+			file << (bFirst ? "" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << t
+				<< ",\"args\":{\"name\":\"" << EscapeJSON(m_lThread[t]->m_sName) << "\"}}";
+			bFirst = false;
+		}
+	}
+	for (uint f = uFrames; f > 0; --f)
+	{
+		MyProfileFrame const* pFrame = GetFrame(f - 1);
+		file << (bFirst ? "" : ",\n") << "{\"name\":\"Frame\",\"ph\":\"i\",\"s\":\"g\",\"pid\":0,\"tid\":0,\"ts\":"
+			<< (pFrame->m_nEnd - nOrigin) / 1000.0 << "}";
+		bFirst = false;
+		for (uint i = 0; i < pFrame->m_lEvent.size(); ++i)
+		{
+			MyProfileEvent const& event = pFrame->m_lEvent[i];
+			file << ",\n{\"name\":\"" << EscapeJSON(event.m_sName) << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << event.m_uThread
+				<< ",\"ts\":" << (event.m_nStart - nOrigin) / 1000.0 << ",\"dur\":" << (event.m_nEnd - event.m_nStart) / 1000.0 << "}";
+		}
+	}
+	file << "\n]}\n";
+	return file.good();
+}
@@ -0,0 +1,208 @@
+/*----------------------------------------------
+Programmer: Team "No Name"
+Date: 2018/04
+----------------------------------------------*/
+#ifndef __MYPROFILER_H_
+#define __MYPROFILER_H_
+
+#include "MyDefinitions.h"
+#include <mutex>
+
+//Set MY_PROFILE to 0 in the preprocessor definitions of the project to compile the zones out, the
+//macros below then expand to nothing and the instrumented code pays nothing for them
+#ifndef MY_PROFILE
+#define MY_PROFILE 1
+#endif
+
+#if MY_PROFILE
+#define MY_PROFILE_CONCAT_(a, b) a##b
+#define MY_PROFILE_CONCAT(a, b) MY_PROFILE_CONCAT_(a, b)
+//Times the rest of the enclosing scope, the name has to be a string literal
+#define MY_PROFILE_ZONE(name) Simplex::MyProfileZone MY_PROFILE_CONCAT(profileZone, __LINE__)(name)
+#define MY_PROFILE_FUNCTION() MY_PROFILE_ZONE(__FUNCTION__)
+//Closes the frame, call once a frame from the main thread
+#define MY_PROFILE_FRAME() Simplex::MyProfiler::GetInstance()->EndFrame()
+//Names the calling thread in the overlay and the traces
+#define MY_PROFILE_THREAD(name) Simplex::MyProfiler::GetInstance()->SetThreadName(name)
+#else
+#define MY_PROFILE_ZONE(name) ((void)0)
+#define MY_PROFILE_FUNCTION() ((void)0)
+#define MY_PROFILE_FRAME() ((void)0)
+#define MY_PROFILE_THREAD(name) ((void)0)
+#endif
+
+namespace Simplex
+{
+
+struct MyProfileThread; //ring of events of a thread, defined with the profiler
+
+//Zone that ended, times are in nanoseconds of the steady clock
+struct MyProfileEvent
+{
+	const char* m_sName = nullptr; //name of the zone, a string literal
+	long long m_nStart = 0; //time the zone was entered
+	long long m_nEnd = 0; //time the zone was left
+	uint m_uDepth = 0; //zones it is nested in on its thread
+	uint m_uThread = 0; //index of the thread in the profiler
+};
+
+//Zones that ended between two frame markers
+struct MyProfileFrame
+{
+	long long m_nStart = 0; //time of the marker that opened the frame
+	long long m_nEnd = 0; //time of the marker that closed the frame
+	std::vector<MyProfileEvent> m_lEvent; //zones collected when the frame closed
+};
+
+//Collects the zones of every thread. Each thread writes to its own ring without locks, the main
+//thread drains them all at the frame marker and keeps the last frames for the overlay and the
+//traces. A ring that fills up between two markers drops the zones past its size.
+class MyProfiler
+{
+	static MyProfiler* m_pInstance; //Singleton pointer
+	std::mutex m_ThreadLock; //guards the list of threads, only taken when a thread starts profiling
+	std::vector<MyProfileThread*> m_lThread; //rings of the threads that have profiled something
+	std::vector<MyProfileFrame> m_lFrame; //last frames, used as a ring
+	uint m_uFrameCount = 0; //frames closed so far
+	long long m_nFrameStart = 0; //time of the last frame marker
+
+public:
+	/*
+	Usage: Gets the singleton pointer
+	Arguments: ---
+	Output: singleton pointer
+	*/
+	static MyProfiler* GetInstance();
+	/*
+	Usage: Releases the content of the singleton, no thread can be in a zone
+	Arguments: ---
+	Output: ---
+	*/
+	static void ReleaseInstance(void);
+	/*
+	USAGE: Reads the steady clock
+	ARGUMENTS: ---
+	OUTPUT: nanoseconds since an arbitrary point
+	*/
+	static long long GetTimeNanoseconds(void);
+	/*
+	USAGE: Enters a zone on the calling thread, use MY_PROFILE_ZONE instead
+	ARGUMENTS: ---
+	OUTPUT: time the zone was entered
+	*/
+	static long long BeginZone(void);
+	/*
+	USAGE: Leaves the zone the calling thread is in, use MY_PROFILE_ZONE instead
+	ARGUMENTS:
+	-	const char* a_sName -> name of the zone, a string literal
+	-	long long a_nStart -> time returned by BeginZone
+	OUTPUT: ---
+	*/
+	static void EndZone(const char* a_sName, long long a_nStart);
+	/*
+	USAGE: Names the calling thread
+	ARGUMENTS: String a_sName -> name
+	OUTPUT: ---
+	*/
+	void SetThreadName(String a_sName);
+	/*
+	USAGE: Closes the frame, collecting the zones every thread ended since the last marker; main thread
+	only, use MY_PROFILE_FRAME
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void EndFrame(void);
+	/*
+	USAGE: Gets one of the last frames closed
+	ARGUMENTS: uint a_uAgo -> 0 for the last frame, 1 for the one before...
+	OUTPUT: frame, nullptr if it is not kept
+	*/
+	MyProfileFrame const* GetFrame(uint a_uAgo) const;
+	/*
+	USAGE: Gets how many of the last frames are kept
+	ARGUMENTS: ---
+	OUTPUT: frames kept
+	*/
+	uint GetFrameHistory(void) const;
+	/*
+	USAGE: Gets the number of frames closed so far
+	ARGUMENTS: ---
+	OUTPUT: frames
+	*/
+	uint GetFrameCount(void) const;
+	/*
+	USAGE: Gets the number of threads that have profiled something
+	ARGUMENTS: ---
+	OUTPUT: threads
+	*/
+	uint GetThreadCount(void);
+	/*
+	USAGE: Gets the name of a thread
+	ARGUMENTS: uint a_uThread -> index of the thread
+	OUTPUT: name
+	*/
+	String GetThreadName(uint a_uThread);
+	/*
+	USAGE: Gets the zones dropped because a ring was full
+	ARGUMENTS: ---
+	OUTPUT: zones dropped
+	*/
+	uint GetDroppedCount(void);
+	/*
+	USAGE: Writes the frames kept as a Chrome trace, to open in chrome://tracing or Perfetto
+	ARGUMENTS: String a_sFileName -> file to write
+	OUTPUT: false if the file could not be written
+	*/
+	bool SaveChromeTrace(String a_sFileName);
+
+private:
+	/*
+	Usage: Constructor
+	Arguments: ---
+	Output: class object instance
+	*/
+	MyProfiler(void);
+	/*
+	Usage: Copy Constructor
+	Arguments: class object to copy
+	Output: class object instance
+	*/
+	MyProfiler(MyProfiler const& other);
+	/*
+	Usage: Copy Assignment Operator
+	Arguments: class object to copy
+	Output: ---
+	*/
+	MyProfiler& operator=(MyProfiler const& other);
+	/*
+	Usage: Destructor
+	Arguments: ---
+	Output: ---
+	*/
+	~MyProfiler(void);
+	/*
+	USAGE: Gets the ring of the calling thread, making it the first time
+	ARGUMENTS: ---
+	OUTPUT: ring
+	*/
+	static MyProfileThread* GetThread(void);
+};
+
+//Times its scope, made by MY_PROFILE_ZONE
+class MyProfileZone
+{
+	const char* m_sName; //name of the zone
+	long long m_nStart; //time the zone was entered
+
+public:
+	explicit MyProfileZone(const char* a_sName) : m_sName(a_sName), m_nStart(MyProfiler::BeginZone()) {}
+	~MyProfileZone(void) { MyProfiler::EndZone(m_sName, m_nStart); }
+
+private:
+	MyProfileZone(MyProfileZone const& other);
+	MyProfileZone& operator=(MyProfileZone const& other);
+};
+
+}//namespace Simplex
+
+#endif //__MYPROFILER_H_
@@ -0,0 +1,87 @@
+#include "MyRenderSnapshot.h"
+using namespace Simplex;
+//  MyRenderSnapshot
+void Simplex::MyRenderSnapshot::Clear(uint a_uFrame)
+{
+	m_lInstance.clear();
+	m_lDebugDraw.clear();
+	m_uVisibleCount = 0;
+	m_uCulledCount = 0;
+	for (uint i = 0; i < LOD_LEVEL_COUNT; ++i)
+		m_uLevelCount[i] = 0;
+	m_uTriangleCount = 0;
+	m_uFrame = a_uFrame;
+}
+void Simplex::MyRenderSnapshot::AddInstance(Model* a_pModel, matrix4 const& a_m4ToWorld, uint a_uLevel, uint a_uTriangles)
+{
+	Instance instance;
+	instance.m_pModel = a_pModel;
+	instance.m_m4ToWorld = a_m4ToWorld;
+	instance.m_uLevel = a_uLevel;
+	m_lInstance.push_back(instance);
+	if (a_uLevel < LOD_LEVEL_COUNT)
+		++m_uLevelCount[a_uLevel];
+	m_uTriangleCount += a_uTriangles;
+}
+void Simplex::MyRenderSnapshot::AddDebugDraw(DebugShape a_eShape, matrix4 const& a_m4ToWorld, vector3 a_v3Color)
+{
+	DebugDraw draw;
+	draw.m_eShape = a_eShape;
+	draw.m_m4ToWorld = a_m4ToWorld;
+	draw.m_v3Color = a_v3Color;
+	m_lDebugDraw.push_back(draw);
+}
+void Simplex::MyRenderSnapshot::CaptureView(void)
+{
+	Camera* pCamera = CameraManager::GetInstance()->GetCamera();
+	m_Camera = *pCamera;
+	matrix4 m4Projection = pCamera->GetProjectionMatrix();
+	m_m4View = pCamera->GetViewMatrix();
+	m_m4ViewProjection = m4Projection * m_m4View;
+	//a perspective projection puts -z in w, an orthographic one keeps w at 1
+	m_fProjectionScale = m4Projection[1][1];
+	m_bPerspective = m4Projection[3][3] == 0.0f;
+
+	LightManager* pLightMngr = LightManager::GetInstance();
+	for (uint i = 0; i < SNAPSHOT_LIGHT_COUNT; ++i)
+	{
+		m_Light[i].m_v3Position = pLightMngr->GetPosition(i);
+		m_Light[i].m_v3Color = pLightMngr->GetColor(i);
+		m_Light[i].m_fIntensity = pLightMngr->GetIntensity(i);
+	}
+}
+void Simplex::MyRenderSnapshot::ApplyLights(void) const
+{
+	LightManager* pLightMngr = LightManager::GetInstance();
+	for (uint i = 0; i < SNAPSHOT_LIGHT_COUNT; ++i)
+	{
+		pLightMngr->SetPosition(m_Light[i].m_v3Position, i);
+		pLightMngr->SetColor(m_Light[i].m_v3Color, i);
+		pLightMngr->SetIntensity(m_Light[i].m_fIntensity, i);
+	}
+}
+std::vector<MyRenderSnapshot::Instance> const& Simplex::MyRenderSnapshot::GetInstanceList(void) const { return m_lInstance; }
+std::vector<MyRenderSnapshot::DebugDraw> const& Simplex::MyRenderSnapshot::GetDebugDrawList(void) const { return m_lDebugDraw; }
+Camera const& Simplex::MyRenderSnapshot::GetCamera(void) const { return m_Camera; }
+matrix4 const& Simplex::MyRenderSnapshot::GetViewProjection(void) const { return m_m4ViewProjection; }
+float Simplex::MyRenderSnapshot::GetScreenSize(vector3 const& a_v3Center, float a_fRadius) const
+{
+	float fDepth = 1.0f;
+	if (m_bPerspective)
+	{
+		fDepth = -(m_m4View * vector4(a_v3Center, 1.0f)).z;
+		if (fDepth <= a_fRadius)
+			return 1.0f;
+	}
+	return (glm::min)(a_fRadius * m_fProjectionScale / fDepth, 1.0f);
+}
+void Simplex::MyRenderSnapshot::SetCullCount(uint a_uVisible, uint a_uCulled)
+{
+	m_uVisibleCount = a_uVisible;
+	m_uCulledCount = a_uCulled;
+}
+uint Simplex::MyRenderSnapshot::GetVisibleCount(void) const { return m_uVisibleCount; }
+uint Simplex::MyRenderSnapshot::GetCulledCount(void) const { return m_uCulledCount; }
+uint Simplex::MyRenderSnapshot::GetLevelCount(uint a_uLevel) const { return a_uLevel < LOD_LEVEL_COUNT ? m_uLevelCount[a_uLevel] : 0; }
+uint Simplex::MyRenderSnapshot::GetTriangleCount(void) const { return m_uTriangleCount; }
+uint Simplex::MyRenderSnapshot::GetFrame(void) const { return m_uFrame; }
@@ -0,0 +1,182 @@
+/*----------------------------------------------
+Programmer: Team "No Name"
+Date: 2018/04
+----------------------------------------------*/
+#ifndef __MYRENDERSNAPSHOT_H_
+#define __MYRENDERSNAPSHOT_H_
+
+#include "Simplex\Simplex.h"
+#include "MyDefinitions.h"
+
+//Lights a snapshot keeps, the ambient one and the first light are the only ones the game sets
+#define SNAPSHOT_LIGHT_COUNT 2
+
+namespace Simplex
+{
+
+//Everything a frame draws, recorded once the simulation is done with it: the models of the entities
+//with their matrices, the debug shapes of the rigid bodies and axes, the camera and the lights. The
+//simulation fills one while the main thread renders the other, a snapshot is never changed after it
+//is handed over so the render does not need to look at the entities at all.
+class MyRenderSnapshot
+{
+public:
+	//A model drawn with a matrix
+	struct Instance
+	{
+		Model* m_pModel = nullptr; //model of the level of detail of the entity, shared with the mesh manager
+		matrix4 m_m4ToWorld = IDENTITY_M4; //where it is drawn
+		uint m_uLevel = 0; //level of detail the model is, 0 for the source
+	};
+	//Shapes the mesh manager draws for debugging
+	enum DebugShape
+	{
+		WireCube,
+		WireSphere,
+		Axis
+	};
+	//A debug shape drawn with a matrix and color
+	struct DebugDraw
+	{
+		DebugShape m_eShape = DebugShape::WireCube; //shape to draw
+		matrix4 m_m4ToWorld = IDENTITY_M4; //where it is drawn, scaled to its size
+		vector3 m_v3Color = C_WHITE; //color of the wire, axes have their own
+	};
+	//A light as the light manager has it
+	struct LightState
+	{
+		vector3 m_v3Position = vector3(0.0f); //position of the light
+		vector3 m_v3Color = vector3(1.0f); //color of the light
+		float m_fIntensity = 1.0f; //intensity of the light
+	};
+
+private:
+	std::vector<Instance> m_lInstance; //models to draw
+	std::vector<DebugDraw> m_lDebugDraw; //debug shapes to draw
+	Camera m_Camera; //copy of the active camera
+	matrix4 m_m4View = IDENTITY_M4; //view of the camera, gives the depth of the entities
+	matrix4 m_m4ViewProjection = IDENTITY_M4; //projection times view of the camera, what the entities are culled with
+	float m_fProjectionScale = 1.0f; //one over half the height the camera sees at a depth of 1
+	bool m_bPerspective = true; //the size on screen shrinks with the depth
+	uint m_uVisibleCount = 0; //entities that made it into the snapshot
+	uint m_uCulledCount = 0; //entities left out for being outside of the camera
+	uint m_uLevelCount[LOD_LEVEL_COUNT] = {}; //models drawn with each level of detail
+	uint m_uTriangleCount = 0; //triangles of all the models drawn
+	LightState m_Light[SNAPSHOT_LIGHT_COUNT]; //ambient light and the first light
+	uint m_uFrame = 0; //frame the simulation recorded it on
+
+public:
+	/*
+	USAGE: Forgets the models, debug shapes and counts, keeps their memory
+	ARGUMENTS: uint a_uFrame -> frame the snapshot is recorded on
+	OUTPUT: ---
+	*/
+	void Clear(uint a_uFrame);
+	/*
+	USAGE: Adds a model to draw
+	ARGUMENTS:
+	-	Model* a_pModel -> model
+	-	matrix4 const& a_m4ToWorld -> where it is drawn
+	-	uint a_uLevel = 0 -> level of detail the model is
+	-	uint a_uTriangles = 0 -> triangles of the model
+	OUTPUT: ---
+	*/
+	void AddInstance(Model* a_pModel, matrix4 const& a_m4ToWorld, uint a_uLevel = 0, uint a_uTriangles = 0);
+	/*
+	USAGE: Adds a debug shape to draw
+	ARGUMENTS:
+	-	DebugShape a_eShape -> shape
+	-	matrix4 const& a_m4ToWorld -> where it is drawn, scaled to its size
+	-	vector3 a_v3Color = C_WHITE -> color of the wire, ignored by the axes
+	OUTPUT: ---
+	*/
+	void AddDebugDraw(DebugShape a_eShape, matrix4 const& a_m4ToWorld, vector3 a_v3Color = C_WHITE);
+	/*
+	USAGE: Copies the active camera, its view projection and the lights, from the main thread while
+	nothing moves them
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void CaptureView(void);
+	/*
+	USAGE: Sets the lights of the snapshot in the light manager
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void ApplyLights(void) const;
+	/*
+	USAGE: Gets the models to draw
+	ARGUMENTS: ---
+	OUTPUT: list of models and their matrices
+	*/
+	std::vector<Instance> const& GetInstanceList(void) const;
+	/*
+	USAGE: Gets the debug shapes to draw
+	ARGUMENTS: ---
+	OUTPUT: list of debug shapes
+	*/
+	std::vector<DebugDraw> const& GetDebugDrawList(void) const;
+	/*
+	USAGE: Gets the camera the frame is seen from
+	ARGUMENTS: ---
+	OUTPUT: copy of the camera taken by CaptureView
+	*/
+	Camera const& GetCamera(void) const;
+	/*
+	USAGE: Gets the projection times the view of the camera
+	ARGUMENTS: ---
+	OUTPUT: view projection matrix taken by CaptureView
+	*/
+	matrix4 const& GetViewProjection(void) const;
+	/*
+	USAGE: Gets how much of the height of the screen a sphere covers, seen from the camera of the
+	snapshot; spheres around the camera cover all of it
+	ARGUMENTS:
+	-	vector3 const& a_v3Center -> center of the sphere in global space
+	-	float a_fRadius -> radius of the sphere
+	OUTPUT: diameter on screen over the height of the screen
+	*/
+	float GetScreenSize(vector3 const& a_v3Center, float a_fRadius) const;
+	/*
+	USAGE: Sets how many entities were kept and left out by the frustum culling
+	ARGUMENTS:
+	-	uint a_uVisible -> entities in the snapshot
+	-	uint a_uCulled -> entities outside of the camera
+	OUTPUT: ---
+	*/
+	void SetCullCount(uint a_uVisible, uint a_uCulled);
+	/*
+	USAGE: Gets how many entities made it into the snapshot
+	ARGUMENTS: ---
+	OUTPUT: visible entities
+	*/
+	uint GetVisibleCount(void) const;
+	/*
+	USAGE: Gets how many entities were left out for being outside of the camera
+	ARGUMENTS: ---
+	OUTPUT: culled entities
+	*/
+	uint GetCulledCount(void) const;
+	/*
+	USAGE: Gets how many models were drawn with a level of detail
+	ARGUMENTS: uint a_uLevel -> level, 0 for the source
+	OUTPUT: models
+	*/
+	uint GetLevelCount(uint a_uLevel) const;
+	/*
+	USAGE: Gets the triangles of all the models in the snapshot
+	ARGUMENTS: ---
+	OUTPUT: triangles
+	*/
+	uint GetTriangleCount(void) const;
+	/*
+	USAGE: Gets the frame the simulation recorded the snapshot on
+	ARGUMENTS: ---
+	OUTPUT: frame
+	*/
+	uint GetFrame(void) const;
+};
+
+}//namespace Simplex
+
+#endif //__MYRENDERSNAPSHOT_H_
@@ -0,0 +1,199 @@
+#include "MySpatialGrid.h"
+#include <cmath>
+using namespace Simplex;
+//  MySpatialGrid
+Simplex::MySpatialGrid::MySpatialGrid(float a_fCellSize, uint a_uBucketCount)
+{
+	m_fCellSize = a_fCellSize > 0.0f ? a_fCellSize : 1.0f;
+
+	//round up to a power of two so the hash can be masked
+	uint uBuckets = 1;
+	while (uBuckets < a_uBucketCount)
+		uBuckets <<= 1;
+	m_uBucketMask = uBuckets - 1;
+	m_lBucketHead.assign(uBuckets, -1);
+}
+void Simplex::MySpatialGrid::Insert(uint a_uID, vector3 const& a_v3Min, vector3 const& a_v3Max)
+{
+	//grow the object arrays to hold the id
+	if (a_uID >= m_lObjectIn.size())
+	{
+		m_lObjectCellX.resize(a_uID + 1, 0);
+		m_lObjectCellZ.resize(a_uID + 1, 0);
+		m_lObjectPrev.resize(a_uID + 1, -1);
+		m_lObjectNext.resize(a_uID + 1, -1);
+		m_lObjectIn.resize(a_uID + 1, false);
+		m_v3ObjectMin.resize(a_uID + 1, ZERO_V3);
+		m_v3ObjectMax.resize(a_uID + 1, ZERO_V3);
+	}
+
+	//if it is already in the grid this is a move
+	if (m_lObjectIn[a_uID])
+	{
+		Move(a_uID, a_v3Min, a_v3Max);
+		return;
+	}
+
+	m_v3ObjectMin[a_uID] = a_v3Min;
+	m_v3ObjectMax[a_uID] = a_v3Max;
+	m_lObjectCellX[a_uID] = GetCell((a_v3Min.x + a_v3Max.x) * 0.5f);
+	m_lObjectCellZ[a_uID] = GetCell((a_v3Min.z + a_v3Max.z) * 0.5f);
+
+	float fHalfX = (a_v3Max.x - a_v3Min.x) * 0.5f;
+	float fHalfZ = (a_v3Max.z - a_v3Min.z) * 0.5f;
+	if (fHalfX > m_fMaxHalfExtent) m_fMaxHalfExtent = fHalfX;
+	if (fHalfZ > m_fMaxHalfExtent) m_fMaxHalfExtent = fHalfZ;
+
+	Link(a_uID);
+	m_lObjectIn[a_uID] = true;
+	++m_uObjectCount;
+}
+void Simplex::MySpatialGrid::Remove(uint a_uID)
+{
+	//if it is not in the grid there is nothing to do
+	if (a_uID >= m_lObjectIn.size() || !m_lObjectIn[a_uID])
+		return;
+
+	Unlink(a_uID);
+	m_lObjectIn[a_uID] = false;
+	--m_uObjectCount;
+}
+bool Simplex::MySpatialGrid::Move(uint a_uID, vector3 const& a_v3Min, vector3 const& a_v3Max)
+{
+	//if it is not in the grid insert it
+	if (a_uID >= m_lObjectIn.size() || !m_lObjectIn[a_uID])
+	{
+		Insert(a_uID, a_v3Min, a_v3Max);
+		return true;
+	}
+
+	m_v3ObjectMin[a_uID] = a_v3Min;
+	m_v3ObjectMax[a_uID] = a_v3Max;
+
+	float fHalfX = (a_v3Max.x - a_v3Min.x) * 0.5f;
+	float fHalfZ = (a_v3Max.z - a_v3Min.z) * 0.5f;
+	if (fHalfX > m_fMaxHalfExtent) m_fMaxHalfExtent = fHalfX;
+	if (fHalfZ > m_fMaxHalfExtent) m_fMaxHalfExtent = fHalfZ;
+
+	int nX = GetCell((a_v3Min.x + a_v3Max.x) * 0.5f);
+	int nZ = GetCell((a_v3Min.z + a_v3Max.z) * 0.5f);
+	//same cell, nothing to relink
+	if (nX == m_lObjectCellX[a_uID] && nZ == m_lObjectCellZ[a_uID])
+		return false;
+
+	Unlink(a_uID);
+	m_lObjectCellX[a_uID] = nX;
+	m_lObjectCellZ[a_uID] = nZ;
+	Link(a_uID);
+	return true;
+}
+uint Simplex::MySpatialGrid::Update(vector3 const* a_pMin, vector3 const* a_pMax, uint a_uCount)
+{
+	//the ids past the count are gone
+	for (uint uID = a_uCount; uID < m_lObjectIn.size(); ++uID)
+		Remove(uID);
+
+	uint uMoved = 0;
+	for (uint uID = 0; uID < a_uCount; ++uID)
+	{
+		if (Move(uID, a_pMin[uID], a_pMax[uID]))
+			++uMoved;
+	}
+	return uMoved;
+}
+uint Simplex::MySpatialGrid::Query(vector3 const& a_v3Min, vector3 const& a_v3Max, std::vector<uint>& a_lResult)
+{
+	a_lResult.clear();
+
+	//objects are linked by their center, grow the box by the largest half extent
+	int nMinX = GetCell(a_v3Min.x - m_fMaxHalfExtent);
+	int nMaxX = GetCell(a_v3Max.x + m_fMaxHalfExtent);
+	int nMinZ = GetCell(a_v3Min.z - m_fMaxHalfExtent);
+	int nMaxZ = GetCell(a_v3Max.z + m_fMaxHalfExtent);
+
+	for (int nZ = nMinZ; nZ <= nMaxZ; ++nZ)
+	{
+		for (int nX = nMinX; nX <= nMaxX; ++nX)
+		{
+			for (int nObject = m_lBucketHead[GetBucket(nX, nZ)]; nObject >= 0; nObject = m_lObjectNext[nObject])
+			{
+				//other cells share the bucket, only take the ones of this cell so nothing is reported twice
+				if (m_lObjectCellX[nObject] != nX || m_lObjectCellZ[nObject] != nZ)
+					continue;
+
+				vector3 const& v3Min = m_v3ObjectMin[nObject];
+				vector3 const& v3Max = m_v3ObjectMax[nObject];
+				if (v3Min.x <= a_v3Max.x && v3Max.x >= a_v3Min.x &&
+					v3Min.y <= a_v3Max.y && v3Max.y >= a_v3Min.y &&
+					v3Min.z <= a_v3Max.z && v3Max.z >= a_v3Min.z)
+					a_lResult.push_back(static_cast<uint>(nObject));
+			}
+		}
+	}
+
+	return a_lResult.size();
+}
+void Simplex::MySpatialGrid::Clear(void)
+{
+	m_lBucketHead.assign(m_lBucketHead.size(), -1);
+	m_lObjectCellX.clear();
+	m_lObjectCellZ.clear();
+	m_lObjectPrev.clear();
+	m_lObjectNext.clear();
+	m_lObjectIn.clear();
+	m_v3ObjectMin.clear();
+	m_v3ObjectMax.clear();
+	m_fMaxHalfExtent = 0.0f;
+	m_uObjectCount = 0;
+}
+void Simplex::MySpatialGrid::SetCellSize(float a_fCellSize)
+{
+	if (a_fCellSize <= 0.0f || a_fCellSize == m_fCellSize)
+		return;
+
+	m_fCellSize = a_fCellSize;
+	//the cells changed, link everything again
+	m_lBucketHead.assign(m_lBucketHead.size(), -1);
+	for (uint uID = 0; uID < m_lObjectIn.size(); ++uID)
+	{
+		if (!m_lObjectIn[uID])
+			continue;
+		m_lObjectCellX[uID] = GetCell((m_v3ObjectMin[uID].x + m_v3ObjectMax[uID].x) * 0.5f);
+		m_lObjectCellZ[uID] = GetCell((m_v3ObjectMin[uID].z + m_v3ObjectMax[uID].z) * 0.5f);
+		Link(uID);
+	}
+}
+float Simplex::MySpatialGrid::GetCellSize(void) const { return m_fCellSize; }
+uint Simplex::MySpatialGrid::GetObjectCount(void) const { return m_uObjectCount; }
+// private methods
+int Simplex::MySpatialGrid::GetCell(float a_fValue) const
+{
+	return static_cast<int>(std::floor(a_fValue / m_fCellSize));
+}
+uint Simplex::MySpatialGrid::GetBucket(int a_nX, int a_nZ) const
+{
+	return (static_cast<uint>(a_nX) * 73856093u ^ static_cast<uint>(a_nZ) * 19349663u) & m_uBucketMask;
+}
+void Simplex::MySpatialGrid::Link(uint a_uID)
+{
+	uint uBucket = GetBucket(m_lObjectCellX[a_uID], m_lObjectCellZ[a_uID]);
+	m_lObjectPrev[a_uID] = -1;
+	m_lObjectNext[a_uID] = m_lBucketHead[uBucket];
+	if (m_lBucketHead[uBucket] >= 0)
+		m_lObjectPrev[m_lBucketHead[uBucket]] = a_uID;
+	m_lBucketHead[uBucket] = a_uID;
+}
+void Simplex::MySpatialGrid::Unlink(uint a_uID)
+{
+	int nPrev = m_lObjectPrev[a_uID];
+	int nNext = m_lObjectNext[a_uID];
+	if (nPrev >= 0)
+		m_lObjectNext[nPrev] = nNext;
+	else
+		m_lBucketHead[GetBucket(m_lObjectCellX[a_uID], m_lObjectCellZ[a_uID])] = nNext;
+	if (nNext >= 0)
+		m_lObjectPrev[nNext] = nPrev;
+
+	m_lObjectPrev[a_uID] = -1;
+	m_lObjectNext[a_uID] = -1;
+}
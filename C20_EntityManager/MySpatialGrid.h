@@ -0,0 +1,147 @@
+/*----------------------------------------------
+Programmer: Team "No Name"
+Date: 2018/04
+----------------------------------------------*/
+#ifndef __MYSPATIALGRID_H_
+#define __MYSPATIALGRID_H_
+
+#include "MyDefinitions.h"
+
+namespace Simplex
+{
+
+//Uniform grid over the (x, z) plane stored in a hash table of buckets, fits the long narrow
+//lanes better than a cube. Each object is linked in the cell holding the center of its box,
+//queries grow by the largest half extent seen so nothing is missed. Insert, remove and move are
+//O(1) and queries do not allocate. Ids are the indices in the entity store.
+class MySpatialGrid
+{
+	float m_fCellSize = 2.0f; //size of the side of a cell
+	uint m_uBucketMask = 0; //bucket count - 1, the count is a power of two
+	std::vector<int> m_lBucketHead; //first object of each bucket, -1 if empty
+
+	std::vector<int> m_lObjectCellX; //cell column of each object
+	std::vector<int> m_lObjectCellZ; //cell row of each object
+	std::vector<int> m_lObjectPrev; //previous object in the same bucket
+	std::vector<int> m_lObjectNext; //next object in the same bucket
+	std::vector<bool> m_lObjectIn; //is the object in the grid?
+	std::vector<vector3> m_v3ObjectMin; //min corner of the bounds of each object
+	std::vector<vector3> m_v3ObjectMax; //max corner of the bounds of each object
+	float m_fMaxHalfExtent = 0.0f; //largest half extent on x or z of the objects
+	uint m_uObjectCount = 0; //number of objects in the grid
+
+public:
+	/*
+	Usage: Constructor
+	Arguments:
+	-	float a_fCellSize = 2.0f -> size of the side of a cell
+	-	uint a_uBucketCount = 1024 -> number of buckets of the hash table, rounded up to a power of two
+	Output: class object instance
+	*/
+	MySpatialGrid(float a_fCellSize = 2.0f, uint a_uBucketCount = 1024);
+	/*
+	USAGE: Inserts an object, if it was already in the grid it gets moved
+	ARGUMENTS:
+	-	uint a_uID -> id of the object
+	-	vector3 const& a_v3Min -> min corner of its bounds
+	-	vector3 const& a_v3Max -> max corner of its bounds
+	OUTPUT: ---
+	*/
+	void Insert(uint a_uID, vector3 const& a_v3Min, vector3 const& a_v3Max);
+	/*
+	USAGE: Removes an object from the grid
+	ARGUMENTS: uint a_uID -> id of the object
+	OUTPUT: ---
+	*/
+	void Remove(uint a_uID);
+	/*
+	USAGE: Updates the bounds of an object, it only changes bucket when its center changes cell
+	ARGUMENTS:
+	-	uint a_uID -> id of the object
+	-	vector3 const& a_v3Min -> min corner of its bounds
+	-	vector3 const& a_v3Max -> max corner of its bounds
+	OUTPUT: did it change cell?
+	*/
+	bool Move(uint a_uID, vector3 const& a_v3Min, vector3 const& a_v3Max);
+	/*
+	USAGE: Moves every object with the bounds in the arrays, ids are the indices in the arrays,
+	ids past the count are removed
+	ARGUMENTS:
+	-	vector3 const* a_pMin -> min corners
+	-	vector3 const* a_pMax -> max corners
+	-	uint a_uCount -> number of entries
+	OUTPUT: number of objects that changed cell
+	*/
+	uint Update(vector3 const* a_pMin, vector3 const* a_pMax, uint a_uCount);
+	/*
+	USAGE: Gets the objects whose bounds overlap the box
+	ARGUMENTS:
+	-	vector3 const& a_v3Min -> min corner of the queried box
+	-	vector3 const& a_v3Max -> max corner of the queried box
+	-	std::vector<uint>& a_lResult -> ids found, cleared first, reuses its capacity
+	OUTPUT: number of ids found
+	*/
+	uint Query(vector3 const& a_v3Min, vector3 const& a_v3Max, std::vector<uint>& a_lResult);
+	/*
+	USAGE: Removes every object
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void Clear(void);
+	/*
+	USAGE: Sets the size of the cells, every object is linked again
+	ARGUMENTS: float a_fCellSize -> size of the side of a cell
+	OUTPUT: ---
+	*/
+	void SetCellSize(float a_fCellSize);
+	/*
+	USAGE: Gets the size of the cells
+	ARGUMENTS: ---
+	OUTPUT: size of the side of a cell
+	*/
+	float GetCellSize(void) const;
+	/*
+	USAGE: Gets the number of objects in the grid
+	ARGUMENTS: ---
+	OUTPUT: number of objects
+	*/
+	uint GetObjectCount(void) const;
+
+private:
+	/*
+	USAGE: Gets the cell of a coordinate
+	ARGUMENTS: float a_fValue -> coordinate
+	OUTPUT: cell index along that axis
+	*/
+	int GetCell(float a_fValue) const;
+	/*
+	USAGE: Gets the bucket of a cell
+	ARGUMENTS:
+	-	int a_nX -> cell column
+	-	int a_nZ -> cell row
+	OUTPUT: bucket index
+	*/
+	uint GetBucket(int a_nX, int a_nZ) const;
+	/*
+	USAGE: Links the object at the head of the bucket of its cell
+	ARGUMENTS: uint a_uID -> id of the object
+	OUTPUT: ---
+	*/
+	void Link(uint a_uID);
+	/*
+	USAGE: Unlinks the object from its bucket
+	ARGUMENTS: uint a_uID -> id of the object
+	OUTPUT: ---
+	*/
+	void Unlink(uint a_uID);
+};//class
+
+} //namespace Simplex
+
+#endif //__MYSPATIALGRID_H_
+
+/*
+USAGE:
+ARGUMENTS: ---
+OUTPUT: ---
+*/
@@ -0,0 +1,133 @@
+#include "MySweepAndPrune.h"
+#include <algorithm>
+using namespace Simplex;
+//  MySweepAndPrune
+Simplex::MySweepAndPrune::MySweepAndPrune(void) { m_uCount = 0; }
+void Simplex::MySweepAndPrune::Update(vector3 const* a_pMin, vector3 const* a_pMax, EntityLayer const* a_pLayer, uint a_uCount)
+{
+	//copy the boxes so the sweep reads them by id without going back to the store
+	m_v3Min.assign(a_pMin, a_pMin + a_uCount);
+	m_v3Max.assign(a_pMax, a_pMax + a_uCount);
+	m_eLayer.assign(a_pLayer, a_pLayer + a_uCount);
+
+	//drop the ids that are gone and add the new ones at the end, the sort puts them in place
+	if (a_uCount < m_uCount)
+	{
+		uint uKept = 0;
+		for (uint i = 0; i < m_lOrder.size(); ++i)
+		{
+			if (m_lOrder[i] < a_uCount)
+				m_lOrder[uKept++] = m_lOrder[i];
+		}
+		m_lOrder.resize(uKept);
+	}
+	bool bAdded = a_uCount > m_uCount;
+	for (uint uID = m_uCount; uID < a_uCount; ++uID)
+	{
+		m_lOrder.push_back(uID);
+	}
+	m_uCount = a_uCount;
+
+	m_fMaxDepth = 0.0f;
+	for (uint i = 0; i < m_uCount; ++i)
+	{
+		float fDepth = m_v3Max[i].z - m_v3Min[i].z;
+		if (fDepth > m_fMaxDepth)
+			m_fMaxDepth = fDepth;
+	}
+
+	//new ids come in any order, with thousands of them the insertion sort below would be quadratic
+	m_uSwapCount = 0;
+	if (bAdded)
+	{
+		std::vector<vector3> const& v3Min = m_v3Min;
+		std::sort(m_lOrder.begin(), m_lOrder.end(), [&v3Min](uint a, uint b)
+		{
+			return v3Min[a].z < v3Min[b].z || (v3Min[a].z == v3Min[b].z && a < b);
+		});
+	}
+
+	//insertion sort on the min Z, the order from last frame is almost sorted already
+	for (uint i = 1; i < m_uCount; ++i)
+	{
+		uint uID = m_lOrder[i];
+		float fKey = m_v3Min[uID].z;
+		uint j = i;
+		while (j > 0 && m_v3Min[m_lOrder[j - 1]].z > fKey)
+		{
+			m_lOrder[j] = m_lOrder[j - 1];
+			--j;
+			++m_uSwapCount;
+		}
+		m_lOrder[j] = uID;
+	}
+}
+uint Simplex::MySweepAndPrune::FindPairs(std::vector<std::pair<uint, uint>>& a_lPair, EntityLayerFilter const& a_Filter)
+{
+	a_lPair.clear();
+
+	for (uint i = 0; i < m_uCount; ++i)
+	{
+		uint uA = m_lOrder[i];
+		vector3 const& v3MinA = m_v3Min[uA];
+		vector3 const& v3MaxA = m_v3Max[uA];
+
+		//every box after this one starts further in Z, stop once they start past its end
+		for (uint j = i + 1; j < m_uCount; ++j)
+		{
+			uint uB = m_lOrder[j];
+			vector3 const& v3MinB = m_v3Min[uB];
+			if (v3MinB.z > v3MaxA.z)
+				break;
+
+			if (!a_Filter.Test(m_eLayer[uA], m_eLayer[uB]))
+				continue;
+
+			vector3 const& v3MaxB = m_v3Max[uB];
+			if (v3MinA.x <= v3MaxB.x && v3MaxA.x >= v3MinB.x &&
+				v3MinA.y <= v3MaxB.y && v3MaxA.y >= v3MinB.y)
+				a_lPair.push_back(uA < uB ? std::make_pair(uA, uB) : std::make_pair(uB, uA));
+		}
+	}
+
+	return a_lPair.size();
+}
+uint Simplex::MySweepAndPrune::Query(vector3 const& a_v3Min, vector3 const& a_v3Max, EntityLayer a_eLayer, std::vector<uint>& a_lResult,
+	EntityLayerFilter const& a_Filter)
+{
+	a_lResult.clear();
+
+	//no box deeper than the deepest one can start before this and still reach the query
+	float fStart = a_v3Min.z - m_fMaxDepth;
+	uint uLow = 0;
+	uint uHigh = m_uCount;
+	while (uLow < uHigh)
+	{
+		uint uMid = (uLow + uHigh) / 2;
+		if (m_v3Min[m_lOrder[uMid]].z < fStart)
+			uLow = uMid + 1;
+		else
+			uHigh = uMid;
+	}
+
+	for (uint i = uLow; i < m_uCount; ++i)
+	{
+		uint uID = m_lOrder[i];
+		vector3 const& v3Min = m_v3Min[uID];
+		if (v3Min.z > a_v3Max.z)
+			break;
+
+		if (!a_Filter.Test(a_eLayer, m_eLayer[uID]))
+			continue;
+
+		vector3 const& v3Max = m_v3Max[uID];
+		if (v3Max.z >= a_v3Min.z &&
+			v3Min.x <= a_v3Max.x && v3Max.x >= a_v3Min.x &&
+			v3Min.y <= a_v3Max.y && v3Max.y >= a_v3Min.y)
+			a_lResult.push_back(uID);
+	}
+
+	return a_lResult.size();
+}
+uint Simplex::MySweepAndPrune::GetSwapCount(void) const { return m_uSwapCount; }
+uint Simplex::MySweepAndPrune::GetCount(void) const { return m_uCount; }
@@ -0,0 +1,85 @@
+/*----------------------------------------------
+Programmer: Team "No Name"
+Date: 2018/04
+----------------------------------------------*/
+#ifndef __MYSWEEPANDPRUNE_H_
+#define __MYSWEEPANDPRUNE_H_
+
+#include "MyDefinitions.h"
+
+namespace Simplex
+{
+
+//Sort and sweep broadphase along Z, the axis everything scrolls on. The boxes are kept sorted
+//by their min Z with an insertion sort, which is close to linear as the order barely changes
+//between frames (only the recycled objects jump). Ids are the indices in the entity store.
+class MySweepAndPrune
+{
+	uint m_uCount = 0; //number of boxes
+	std::vector<uint> m_lOrder; //ids sorted by the min Z of their box
+	std::vector<vector3> m_v3Min; //min corner of each box, by id
+	std::vector<vector3> m_v3Max; //max corner of each box, by id
+	std::vector<EntityLayer> m_eLayer; //layer of each box, by id
+	float m_fMaxDepth = 0.0f; //largest Z size of the boxes, bounds how far back a query has to look
+	uint m_uSwapCount = 0; //swaps done by the last sort
+
+public:
+	/*
+	Usage: Constructor
+	Arguments: ---
+	Output: class object instance
+	*/
+	MySweepAndPrune(void);
+	/*
+	USAGE: Copies the boxes and layers and sorts them again, ids are the indices in the arrays
+	ARGUMENTS:
+	-	vector3 const* a_pMin -> min corners
+	-	vector3 const* a_pMax -> max corners
+	-	EntityLayer const* a_pLayer -> layers
+	-	uint a_uCount -> number of entries
+	OUTPUT: ---
+	*/
+	void Update(vector3 const* a_pMin, vector3 const* a_pMax, EntityLayer const* a_pLayer, uint a_uCount);
+	/*
+	USAGE: Gets every pair of overlapping boxes whose layers pass the filter
+	ARGUMENTS:
+	-	std::vector<std::pair<uint, uint>>& a_lPair -> pairs found (lower id first), cleared first, reuses its capacity
+	-	EntityLayerFilter const& a_Filter = EntityLayerFilter() -> layers tested against each other
+	OUTPUT: number of pairs found
+	*/
+	uint FindPairs(std::vector<std::pair<uint, uint>>& a_lPair, EntityLayerFilter const& a_Filter = EntityLayerFilter());
+	/*
+	USAGE: Gets the boxes overlapping the queried one whose layers pass the filter against the queried layer
+	ARGUMENTS:
+	-	vector3 const& a_v3Min -> min corner of the queried box
+	-	vector3 const& a_v3Max -> max corner of the queried box
+	-	EntityLayer a_eLayer -> layer of the queried box
+	-	std::vector<uint>& a_lResult -> ids found, cleared first, reuses its capacity
+	-	EntityLayerFilter const& a_Filter = EntityLayerFilter() -> layers tested against each other
+	OUTPUT: number of ids found
+	*/
+	uint Query(vector3 const& a_v3Min, vector3 const& a_v3Max, EntityLayer a_eLayer, std::vector<uint>& a_lResult,
+		EntityLayerFilter const& a_Filter = EntityLayerFilter());
+	/*
+	USAGE: Gets the number of swaps the last update needed to sort the boxes, tells how coherent the frame was
+	ARGUMENTS: ---
+	OUTPUT: number of swaps
+	*/
+	uint GetSwapCount(void) const;
+	/*
+	USAGE: Gets the number of boxes
+	ARGUMENTS: ---
+	OUTPUT: number of boxes
+	*/
+	uint GetCount(void) const;
+};//class
+
+} //namespace Simplex
+
+#endif //__MYSWEEPANDPRUNE_H_
+
+/*
+USAGE:
+ARGUMENTS: ---
+OUTPUT: ---
+*/
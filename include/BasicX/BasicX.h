@@ -26,6 +26,7 @@ Date: 2017/04
 #include "BasicX\Mesh\Text.h" //Singleton for drawing Text on the screen
 #include "BasicX\Mesh\Mesh.h"//Mesh class
 #include "BasicX\Mesh\MeshManager.h"//Mesh Singleton
+#include "BasicX\Mesh\AssetLoader.h"//Loads meshes and textures in the background
 
 #include "BasicX\Camera\CameraManager.h" //Creates and manages the camera object for the world
 
@@ -39,6 +40,7 @@ namespace BasicX
 {
 	static void ReleaseAllSingletons(void)
 	{
+		AssetLoader::ReleaseInstance(); //stop the workers before what they load into goes away
 		LightManager::ReleaseInstance();
 		MaterialManager::ReleaseInstance();
 		TextureManager::ReleaseInstance();
@@ -24,6 +24,7 @@ namespace BasicX
 		bool m_bArcBall = false;// Arcball flag
 
 		float m_dMinDelta = 0.0166f;//Minimum reason of change
+		float m_fUploadBudget = 4.0f;//Milliseconds of every frame given to the assets loading in the background
 
 		GLuint m_nFrameBuffer = 0;
 		GLuint m_nDepthBuffer = 0;
@@ -85,8 +86,8 @@ namespace BasicX
 
 			//Run the main loop until the exit message is sent
 			MSG msg = { 0 };
-			DWORD dCumulative = 0;
-			DWORD dLastTime = GetTickCount();
+			long long nCumulative = 0;
+			long long nLastTime = SystemSingleton::GetTimeNanoseconds();
 			while (WM_QUIT != msg.message)
 			{
 				//Peek the message send by windows and do something dispatch it
@@ -97,12 +98,12 @@ namespace BasicX
 				}
 				else //If no message was sent continue the regular fields
 				{
-					DWORD dCurrentTime = GetTickCount();//Current time in the clock
-					DWORD dDeltaTime = dCurrentTime - dLastTime; //Calculate the dif between calls
-					dLastTime = dCurrentTime; //Set the last time the method was call
+					long long nCurrentTime = SystemSingleton::GetTimeNanoseconds();//Current time in the clock
+					long long nDeltaTime = nCurrentTime - nLastTime; //Calculate the dif between calls
+					nLastTime = nCurrentTime; //Set the last time the method was call
 
-					dCumulative += dDeltaTime;//Calculate the cumulative time
-					if (static_cast<float>(dCumulative / 1000.0f) >= m_dMinDelta) //if more than the minimum delta time has passed
+					nCumulative += nDeltaTime;//Calculate the cumulative time
+					if (nCumulative / 1e9 >= m_dMinDelta) //if more than the minimum delta time has passed
 					{
 						if (GetFocus() != NULL) //If the window is focused...
 						{
@@ -110,10 +111,11 @@ namespace BasicX
 							ProcessMouse(); //Check for mouse input
 							ProcessJoystick(); //Check for Joystick input
 						}
+						AssetLoader::GetInstance()->Update(m_fUploadBudget); //Upload what finished loading
 						Update(); //Update the scene
 						Display(); //Display the changes on the scene
 
-						dCumulative = dDeltaTime; //reset cumulative time
+						nCumulative = nDeltaTime; //reset cumulative time
 					}
 
 
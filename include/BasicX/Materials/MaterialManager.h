@@ -193,6 +193,33 @@ public:
 	*/
 	int DuplicateMaterial(String a_sMaterialToDuplicate, String a_sDesiredName);
 
+	/*
+	USAGE: Reads every material of a .mtl library, the materials already in the pile are kept
+	as they are
+	ARGUMENTS:
+		String a_sFileName -> library to read
+	OUTPUT: number of materials added, -1 if the file could not be read
+	*/
+	int LoadMaterialLibrary(String a_sFileName);
+
+	/*
+	USAGE: Adds the materials of the list that are not in the pile already and loads their maps
+	ARGUMENTS:
+		std::vector<Material> const& a_lMaterial -> materials to add
+	OUTPUT: number of materials added
+	*/
+	int AddMaterialList(std::vector<Material> const& a_lMaterial);
+
+	/*
+	USAGE: Reads the materials of a .mtl library without adding them or loading their maps,
+	safe to call from any thread
+	ARGUMENTS:
+		String a_sFileName -> library to read
+		std::vector<Material>& a_lMaterial -> materials read are added at the end
+	OUTPUT: false if the file could not be read
+	*/
+	static bool ReadMaterialLibrary(String a_sFileName, std::vector<Material>& a_lMaterial);
+
 private:
 	
 	/*
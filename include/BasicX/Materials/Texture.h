@@ -19,6 +19,11 @@ class BasicXDLL Texture
 	String m_sName = "NULL";
 	String m_sFileName = "NULL";
 	String m_sAbsoluteRoute = "";
+	FIBITMAP* m_pBitmap = nullptr; //Decoded 32 bit image waiting to be uploaded
+	int m_nWidth = 0; //Width of the decoded image
+	int m_nHeight = 0; //Height of the decoded image
+	GLuint m_uUploadBuffer = 0; //Pixel buffer the image is streamed through
+	GLubyte* m_pUploadMemory = nullptr; //Pixel buffer mapped for writing
 
 public:
 	/*
@@ -60,6 +65,47 @@ public:
 	OUTPUT: success
 	*/
 	bool LoadTexture(String a_sFileName);
+	/*
+	USAGE: Reads and decodes the file into memory without touching OpenGL, safe to call from any
+	thread; UploadTexture has to follow on the thread owning the context
+	ARGUMENTS:
+		String a_sFileName -> name of the file, if path not define will look
+		under the textures folder
+	OUTPUT: success
+	*/
+	bool DecodeTexture(String a_sFileName);
+	/*
+	USAGE: Creates the OpenGL texture and its mip chain from the decoded image and frees it
+	ARGUMENTS: ---
+	OUTPUT: success
+	*/
+	bool UploadTexture(void);
+	/*
+	USAGE: Gets the bytes of the decoded image
+	ARGUMENTS: ---
+	OUTPUT: size, 0 if nothing is decoded
+	*/
+	uint GetDecodedSize(void);
+	/*
+	USAGE: Maps a pixel buffer the size of the decoded image, on the thread owning the context;
+	the image is then copied into it from any thread with WriteUploadBuffer
+	ARGUMENTS: ---
+	OUTPUT: mapped memory, nullptr if nothing is decoded or the buffer could not be mapped
+	*/
+	GLubyte* MapUploadBuffer(void);
+	/*
+	USAGE: Copies the decoded image into the mapped pixel buffer, safe to call from any thread
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void WriteUploadBuffer(void);
+	/*
+	USAGE: Unmaps the pixel buffer and creates the texture from it, the driver copies it without
+	holding up this thread; without a mapped buffer it does the same as UploadTexture
+	ARGUMENTS: ---
+	OUTPUT: success
+	*/
+	bool UploadFromBuffer(void);
 //Accessors
 	/*
 	USAGE: Returns the OpenGL Identifier
@@ -97,6 +143,13 @@ private:
 	OUTPUT: ---
 	*/
 	void Init(void); //Initializes the variables
+	/*
+	USAGE: Creates the OpenGL texture and its mip chain and frees the decoded image
+	ARGUMENTS:
+		GLvoid const* a_pPixels -> pixels of the image, offset in the pixel buffer if one is bound
+	OUTPUT: success
+	*/
+	bool CreateTexture(GLvoid const* a_pPixels);
 };
 
 EXPIMP_TEMPLATE template class BasicXDLL std::vector<Texture>;
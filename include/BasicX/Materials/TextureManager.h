@@ -44,6 +44,14 @@ public:
 	OUTPUT:
 	*/
 	int LoadTexture(String sName);	//Loads a texture and returns the ID of where its stored in the vector
+	/*
+	USAGE: Takes ownership of a texture already uploaded, if one with the same file is in the vector
+	already the new one is deleted
+	ARGUMENTS:
+		Texture* a_pTexture -> uploaded texture
+	OUTPUT: ID of the texture in the vector
+	*/
+	int AddTexture(Texture* a_pTexture);
 
 	/*
 	USAGE:
@@ -0,0 +1,173 @@
+/*----------------------------------------------
+Programmer: Alberto Bobadilla (labigm@gmail.com)
+Date: 2017/06
+----------------------------------------------*/
+#ifndef __ASSETLOADERBASICX_H_
+#define __ASSETLOADERBASICX_H_
+
+#include "BasicX\Mesh\MeshManager.h"
+#include "BasicX\Materials\TextureManager.h"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <memory>
+
+namespace BasicX
+{
+	struct AssetMeshJob; //Mesh being loaded, defined with the loader
+	struct AssetTextureJob; //Texture being loaded, defined with the loader
+
+	/*
+	Loads meshes and textures in the background. Reading, parsing and decoding run on a pool of
+	worker threads; what needs OpenGL is queued for the main thread, which does as much of it as
+	fits in the time it is given every frame. Each load hands back a future that is set when the
+	asset is resident, with its index in the manager or -1 if it could not be loaded
+	*/
+	class BasicXDLL AssetLoader
+	{
+		static AssetLoader* m_pInstance; //Singleton pointer
+		std::vector<std::thread> m_lWorker; //Worker threads
+		std::deque<std::function<void()>> m_lJob; //Work waiting for a worker
+		std::deque<std::function<void()>> m_lUpload; //Work waiting for the main thread
+		std::mutex m_JobLock; //Guards the job queue and the quit flag
+		std::mutex m_UploadLock; //Guards the upload queue
+		std::condition_variable m_JobSignal; //Wakes the workers up
+		bool m_bQuit = false; //Workers stop when set
+		uint m_uPending = 0; //Loads asked for that are not resident yet
+		uint m_uStreamSize = 1 << 20; //Decoded textures this big are streamed through a pixel buffer
+
+	public:
+		/*
+		USAGE: Gets/Constructs the singleton pointer
+		ARGUMENTS: ---
+		OUTPUT: singleton
+		*/
+		static AssetLoader* GetInstance(void);
+		/*
+		USAGE: Destroys the singleton, the loads still in flight are dropped
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		static void ReleaseInstance(void);
+		/*
+		USAGE: Starts loading a Wavefront .obj file, through its cache if there is a fresh one; the
+		materials and maps of the file are loaded with it
+		ARGUMENTS: String a_sFileName -> .obj file
+		OUTPUT: set to the index of the mesh in the MeshManager, -1 if it could not be loaded
+		*/
+		std::shared_future<int> LoadMesh(String a_sFileName);
+		/*
+		USAGE: Starts loading a texture
+		ARGUMENTS: String a_sFileName -> name of the file, if path not define will look
+			under the textures folder
+		OUTPUT: set to the index of the texture in the TextureManager, -1 if it could not be loaded
+		*/
+		std::shared_future<int> LoadTexture(String a_sFileName);
+		/*
+		USAGE: Does the OpenGL part of the loads that are ready, call it once a frame from the
+		thread owning the context; at least one upload is done every call so loads always advance
+		ARGUMENTS: float a_fBudget -> milliseconds it can take
+		OUTPUT: number of uploads done
+		*/
+		uint Update(float a_fBudget);
+		/*
+		USAGE: Blocks until the load is done, doing the uploads meanwhile; only from the thread
+		owning the context
+		ARGUMENTS: std::shared_future<int> a_Load -> load to wait for
+		OUTPUT: value of the load
+		*/
+		int Wait(std::shared_future<int> a_Load);
+		/*
+		USAGE: Gets the number of loads asked for that are not resident yet
+		ARGUMENTS: ---
+		OUTPUT: pending loads
+		*/
+		uint GetPendingCount(void);
+		/*
+		USAGE: Gets the number of worker threads
+		ARGUMENTS: ---
+		OUTPUT: workers
+		*/
+		uint GetWorkerCount(void);
+
+	private:
+		/*
+		USAGE: Constructor
+		ARGUMENTS: ---
+		OUTPUT: class object
+		*/
+		AssetLoader(void);
+		/*
+		USAGE: Copy Constructor
+		ARGUMENTS:
+		OUTPUT:
+		*/
+		AssetLoader(AssetLoader const& other);
+		/*
+		USAGE: Copy Assignment Operator
+		ARGUMENTS:
+		OUTPUT:
+		*/
+		AssetLoader& operator=(AssetLoader const& other);
+		/*
+		USAGE: Destructor
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		~AssetLoader(void);
+		/*
+		USAGE: Starts the workers
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		void Init(void);
+		/*
+		USAGE: Stops the workers and drops the work left
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		void Release(void);
+		/*
+		USAGE: Body of every worker, runs jobs until the loader quits
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		void WorkerLoop(void);
+		/*
+		USAGE: Queues work for the workers
+		ARGUMENTS: std::function<void()> a_fnJob -> work
+		OUTPUT: ---
+		*/
+		void EnqueueJob(std::function<void()> a_fnJob);
+		/*
+		USAGE: Queues work for the main thread, safe from any thread
+		ARGUMENTS: std::function<void()> a_fnUpload -> work
+		OUTPUT: ---
+		*/
+		void EnqueueUpload(std::function<void()> a_fnUpload);
+		/*
+		USAGE: Uploads a parsed mesh and adds it to the MeshManager, main thread only
+		ARGUMENTS: std::shared_ptr<AssetMeshJob> a_pJob -> load
+		OUTPUT: ---
+		*/
+		void FinishMesh(std::shared_ptr<AssetMeshJob> a_pJob);
+		/*
+		USAGE: Queues the upload of a decoded texture, big ones are written to a pixel buffer by a
+		worker between the main thread mapping it and uploading from it; safe from any thread
+		ARGUMENTS: std::shared_ptr<AssetTextureJob> a_pJob -> load
+		OUTPUT: ---
+		*/
+		void UploadTexture(std::shared_ptr<AssetTextureJob> a_pJob);
+		/*
+		USAGE: Uploads a decoded texture and adds it to the TextureManager, the mesh it belongs to is
+		finished with its last map; main thread only
+		ARGUMENTS: std::shared_ptr<AssetTextureJob> a_pJob -> load
+		OUTPUT: ---
+		*/
+		void FinishTexture(std::shared_ptr<AssetTextureJob> a_pJob);
+	};
+}
+
+#endif //__ASSETLOADERBASICX_H_
@@ -9,9 +9,18 @@ Date: 2017/05
 #include "BasicX\System\ShaderManager.h"
 #include "BasicX\Materials\MaterialManager.h"
 #include "BasicX\Light\LightManager.h"
+#include "BasicX\Mesh\VertexLayout.h"
+#include "BasicX\Mesh\MeshCache.h"
+#include <functional>
 
 namespace BasicX
 {
+	class Mesh;
+	/*
+	Rebuilds the vertex lists of the mesh it gets, used to bring back the CPU data a mesh let go
+	*/
+	typedef std::function<void(Mesh*)> MeshSource;
+
 	/*
 	A Mesh is the most basic container of a model or mesh.
 	It contains the information about the material and the vertex cloud that forms it
@@ -31,6 +40,21 @@ protected:
 	
 	GLuint m_VAO = 0;			//OpenGL Vertex Array Object
 	GLuint m_VBO = 0;			//OpenGL Vertex Array Object
+	GLuint m_InstanceVBO = 0;	//OpenGL buffer of per instance model matrices, streamed every render
+	uint m_uInstanceCapacity = 0; //Number of matrices the instance buffer was last sized for
+	GLuint m_EBO = 0;			//OpenGL Element Buffer Object, 0 if the mesh is drawn as a triangle soup
+	uint m_uIndexCount = 0;		//Number of indices in the element buffer
+	GLenum m_eIndexType = GL_UNSIGNED_INT; //Type of the indices, 16 bits if the welded vertices fit
+	bool m_bIndexed = true;		//Weld the vertices and draw them with indices when compiling
+	BTO_VERTEX m_eVertexFormat = VERTEX_PACKED; //Layout of the vertices in the VBO
+	uint m_uGPUMemory = 0;		//Bytes of the vertex and index buffers
+	vector3 m_v3Min = ZERO_V3;	//Min corner of the bounding box in local space
+	vector3 m_v3Max = ZERO_V3;	//Max corner of the bounding box in local space
+
+	//Not reset by Init, the generators call it and these have to survive
+	BTO_RESIDENCY m_eResidency = RESIDENT_POSITIONS; //What stays in memory after the upload
+	MeshSource m_fnSource = nullptr; //Builds the mesh again, nullptr if it cannot be rebuilt
+	bool m_bCPUOnly = false; //Built only to get the CPU data back, compiling skips the upload and loaders skip the materials
 
 	GLuint m_nShader = 0;	//Index of the shader
 		
@@ -77,6 +101,52 @@ protected:
 	OUTPUT: ---
 	*/
 	void DisconnectOpenGL3X(void);
+	/*
+	USAGE: Merges the corners of the composed vertex array that are identical in every attribute,
+	the array keeps only one copy of each and the indices tell which one every corner uses
+	ARGUMENTS:
+	- std::vector<uint>& a_lIndex -> index of the welded vertex for every corner, cleared first
+	OUTPUT: number of welded vertices
+	*/
+	uint WeldVertices(std::vector<uint>& a_lIndex);
+	/*
+	USAGE: Reorders the triangles so the ones sharing vertices are drawn close to each other and
+	the vertex shader results get reused from the post transform cache (Forsyth's method)
+	ARGUMENTS:
+	- std::vector<uint>& a_lIndex -> triangle list to reorder
+	- uint a_uVertexCount -> number of vertices the indices point to
+	OUTPUT: ---
+	*/
+	static void OptimizeVertexCache(std::vector<uint>& a_lIndex, uint a_uVertexCount);
+	/*
+	USAGE: Reorders the composed vertex array in the order the indices first use it, so the
+	vertices are fetched mostly sequentially
+	ARGUMENTS:
+	- std::vector<uint>& a_lIndex -> triangle list, remapped to the new order
+	OUTPUT: ---
+	*/
+	void OptimizeVertexFetch(std::vector<uint>& a_lIndex);
+	/*
+	USAGE: Gives every group of vertices at the same position the normalized sum of their normals,
+	the positions are sorted along x so each one is only compared to its close neighbors
+	ARGUMENTS:
+	- float a_fEpsilon -> distance in every axis under which two positions are the same point
+	OUTPUT: ---
+	*/
+	void AverageNormals(float a_fEpsilon);
+	/*
+	USAGE: Rebuilds the vertex lists from the source if they were let go
+	ARGUMENTS:
+	- std::vector<vector3> const& a_lList -> list about to be used
+	OUTPUT: ---
+	*/
+	void RequireCPUData(std::vector<vector3> const& a_lList);
+	/*
+	USAGE: Creates the per instance buffer of model matrices in the VAO bound, locations 6 to 9
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void CreateInstanceBuffer(void);
 #pragma endregion
 #pragma region Mesh Initialization
 	/*
@@ -107,12 +177,21 @@ protected:
 	*/
 	void AddTri(vector3 a_vBottomLeft, vector3 a_vBottomRight, vector3 a_vTopLeft);
 	/*
+	USAGE: Streams the model matrices into the instance buffer, the old storage is orphaned so the
+	driver does not wait for the draws still reading it
+	ARGUMENTS:
+	float* a_fMatrixArray -> Array of matrices that represent positions
+	int a_nInstances -> Number of instances
+	OUTPUT: ---
+	*/
+	void UploadInstances(float* a_fMatrixArray, int a_nInstances);
+	/*
 	USAGE: Renders the mesh a_nInstances number of times on the specified positions by the a_fMatrixArray and by the
 	provided camera view and projection
 	ARGUMENTS:
 	matrix4 a_mProjection -> Projection matrix
 	matrix4 a_mView -> View matrix
-	float* a_fMatrixArray -> Array of matrices that represent positions
+	float* a_fMatrixArray -> Array of matrices that represent positions, nullptr to draw the ones already uploaded
 	int a_nInstances -> Number of instances to display
 	OUTPUT: ---
 	*/
@@ -123,7 +202,7 @@ protected:
 	ARGUMENTS:
 	matrix4 a_mProjection -> Projection matrix
 	matrix4 a_mView -> View matrix
-	float* a_fMatrixArray -> Array of matrices that represent positions
+	float* a_fMatrixArray -> Array of matrices that represent positions, nullptr to draw the ones already uploaded
 	int a_nInstances -> Number of instances to display
 	vector3 a_v3CameraPosition -> Position of the camera in world space
 	OUTPUT: ---
@@ -181,9 +260,20 @@ public:
 	USAGE: Completes the triangle information
 	ARGUMENTS:
 	- bool a_bAverageNormals = false -> soften the edges of the model
+	- float a_fEpsilon = 0.0001f -> distance under which two positions are the same point when averaging
+	OUTPUT: ---
+	*/
+	void CompleteTriangleInfo(bool a_bAverageNormals = false, float a_fEpsilon = 0.0001f);
+	/*
+	USAGE: Completes the triangle information of every mesh in the list, spread over the
+	hardware threads; each mesh only touches its own lists so they do not need to lock
+	ARGUMENTS:
+	- std::vector<Mesh*> a_lMesh -> meshes to complete, nullptr entries are skipped
+	- bool a_bAverageNormals = false -> soften the edges of the models
+	- float a_fEpsilon = 0.0001f -> distance under which two positions are the same point when averaging
 	OUTPUT: ---
 	*/
-	void CompleteTriangleInfo(bool a_bAverageNormals = false);
+	static void CompleteTriangleInfoList(std::vector<Mesh*> a_lMesh, bool a_bAverageNormals = false, float a_fEpsilon = 0.0001f);
 	/*
 	USAGE: Calculates the missing tangents
 	ARGUMENTS: ---
@@ -349,6 +439,138 @@ public:
 	*/
 	int GetVertexCount(void);
 	/*
+	USAGE: Sets whether the mesh welds its vertices and draws with an index buffer, only
+	takes effect if the mesh is not compiled yet
+	ARGUMENTS:
+		bool a_bIndexed -> true to use indices
+	OUTPUT: ---
+	*/
+	void SetIndexed(bool a_bIndexed);
+	/*
+	USAGE: Asks the mesh if it welds its vertices and draws with an index buffer
+	ARGUMENTS: ---
+	OUTPUT: Whether it uses indices or not
+	*/
+	bool GetIndexed(void);
+	/*
+	USAGE: Sets the layout of the vertices in the VBO, only takes effect if the mesh is not compiled yet
+	ARGUMENTS:
+		BTO_VERTEX a_eFormat -> VERTEX_FLOAT, VERTEX_PACKED or VERTEX_PACKED_HALF
+	OUTPUT: ---
+	*/
+	void SetVertexFormat(BTO_VERTEX a_eFormat);
+	/*
+	USAGE: Asks the mesh for the layout of the vertices in the VBO
+	ARGUMENTS: ---
+	OUTPUT: format of the vertices
+	*/
+	BTO_VERTEX GetVertexFormat(void);
+	/*
+	USAGE: Sets what the mesh keeps in memory once it is uploaded, if it is already uploaded
+	the lists it does not need anymore are released right away
+	ARGUMENTS:
+		BTO_RESIDENCY a_eResidency -> RESIDENT_FULL, RESIDENT_POSITIONS or RESIDENT_NONE
+	OUTPUT: ---
+	*/
+	void SetResidency(BTO_RESIDENCY a_eResidency);
+	/*
+	USAGE: Asks the mesh what it keeps in memory once it is uploaded
+	ARGUMENTS: ---
+	OUTPUT: residency of the mesh
+	*/
+	BTO_RESIDENCY GetResidency(void);
+	/*
+	USAGE: Sets how to build the mesh again when the CPU data it let go is needed
+	ARGUMENTS:
+		MeshSource a_fnSource -> fills the vertex lists of the mesh it gets, nullptr for none
+	OUTPUT: ---
+	*/
+	void SetSource(MeshSource a_fnSource);
+	/*
+	USAGE: Builds the vertex lists again from the source, they stay until ReleaseCPUData
+	ARGUMENTS: ---
+	OUTPUT: false if the mesh has no source or the source no longer matches the mesh
+	*/
+	bool ReloadCPUData(void);
+	/*
+	USAGE: Releases the vertex lists the residency does not keep, only once the mesh is uploaded
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void ReleaseCPUData(void);
+	/*
+	USAGE: Returns the bytes the vertex lists of the mesh take in memory
+	ARGUMENTS: ---
+	OUTPUT: resident bytes
+	*/
+	size_t GetResidentMemory(void);
+	/*
+	USAGE: Returns the bytes the vertex and index buffers of the mesh take in the GPU
+	ARGUMENTS: ---
+	OUTPUT: GPU bytes
+	*/
+	uint GetGPUMemory(void);
+	/*
+	USAGE: Writes the uploaded buffers, bounds and material of the mesh to a cache file
+	ARGUMENTS:
+		String a_sFileName -> cache file
+	OUTPUT: false if the mesh is not uploaded, is a copy or the file could not be written
+	*/
+	bool SaveCache(String a_sFileName);
+	/*
+	USAGE: Replaces the mesh with the one in a cache file, the file is mapped in memory and its
+	buffers go straight to OpenGL; only the positions are read back, if the residency keeps them
+	ARGUMENTS:
+		String a_sFileName -> cache file
+	OUTPUT: false if the file is missing or not a cache of this version
+	*/
+	bool LoadCache(String a_sFileName);
+	/*
+	USAGE: Loads the mesh from the cache next to the source, if the cache is missing or older than
+	the source the mesh is built from it and the cache is written again
+	ARGUMENTS:
+		String a_sSource -> source asset, its cache is the same name with .bxc added
+		MeshSource a_fnBuild -> builds the mesh from the source, also used to reload its CPU data
+	OUTPUT: false if the mesh could not be loaded or built
+	*/
+	bool LoadCached(String a_sSource, MeshSource a_fnBuild);
+	/*
+	USAGE: Adds the triangles of a Wavefront .obj file to the mesh, polygons are split in fans and
+	the first material used is read from the libraries of the file
+	ARGUMENTS:
+		String a_sFileName -> .obj file
+	OUTPUT: false if the file could not be read or has no faces
+	*/
+	bool LoadOBJ(String a_sFileName);
+	/*
+	USAGE: Adds the triangles of a Wavefront .obj file to the mesh without touching OpenGL or the
+	managers, safe to call from any thread on a mesh nobody else is using
+	ARGUMENTS:
+		String a_sFileName -> .obj file
+		std::vector<String>& a_lLibrary -> material libraries of the file are added at the end
+		String& a_sMaterial -> first material used by the file, left as it is if it uses none
+	OUTPUT: false if the file could not be read or has no faces
+	*/
+	bool ParseOBJ(String a_sFileName, std::vector<String>& a_lLibrary, String& a_sMaterial);
+	/*
+	USAGE: Returns the min corner of the bounding box of the mesh in local space
+	ARGUMENTS: ---
+	OUTPUT: min corner
+	*/
+	vector3 GetMin(void);
+	/*
+	USAGE: Returns the max corner of the bounding box of the mesh in local space
+	ARGUMENTS: ---
+	OUTPUT: max corner
+	*/
+	vector3 GetMax(void);
+	/*
+	USAGE: Returns the number of indices drawn, 0 if the mesh is drawn as a triangle soup
+	ARGUMENTS: ---
+	OUTPUT: Number of indices
+	*/
+	uint GetIndexCount(void);
+	/*
 	USAGE: Gets the material used in the mesh by index of the material manager
 	ARGUMENTS: ---
 	OUTPUT: index of the material used
@@ -0,0 +1,145 @@
+/*----------------------------------------------
+Programmer: Alberto Bobadilla (labigm@gmail.com)
+Date: 2017/06
+----------------------------------------------*/
+#ifndef __MESHCACHEBASICX_H_
+#define __MESHCACHEBASICX_H_
+
+#include "BasicX\System\ShaderCompiler.h"
+
+namespace BasicX
+{
+	/*
+	Start of a mesh cache file, the vertex and index buffers follow at the offsets it gives,
+	already in the layout they are uploaded in
+	*/
+	struct BasicXDLL MeshCacheHeader
+	{
+		char m_sMagic[4]; //Always BXMC
+		uint m_uVersion; //Version of the format, files of any other version are rebuilt
+		uint m_uVertexFormat; //BTO_VERTEX of the vertex buffer
+		uint m_uVertexCount; //Vertices in the vertex buffer
+		uint m_uStride; //Bytes per vertex
+		uint m_uIndexCount; //Indices in the index buffer, 0 for a triangle soup
+		uint m_uIndexType; //GL_UNSIGNED_SHORT or GL_UNSIGNED_INT
+		uint m_uCornerCount; //Triangle corners of the mesh
+		float m_fMin[3]; //Min corner of the bounding box
+		float m_fMax[3]; //Max corner of the bounding box
+		uint m_uVertexOffset; //Bytes from the start of the file to the vertex buffer
+		uint m_uVertexBytes; //Size of the vertex buffer
+		uint m_uIndexOffset; //Bytes from the start of the file to the index buffer
+		uint m_uIndexBytes; //Size of the index buffer
+		char m_sName[256]; //Name of the mesh
+		char m_sMaterial[256]; //Name of the material
+		char m_sDiffuse[256]; //Diffuse map of the material
+		char m_sNormal[256]; //Normal map of the material
+		char m_sSpecular[256]; //Specular map of the material
+	};
+
+	/*
+	Binary cache of a compiled Mesh stored next to its source asset. Reading maps the file in
+	memory and hands out pointers into it, the buffers go to OpenGL without any parsing
+	*/
+	class BasicXDLL MeshCache
+	{
+		HANDLE m_hFile = INVALID_HANDLE_VALUE; //File opened
+		HANDLE m_hMapping = nullptr; //Mapping of the file
+		unsigned char const* m_pData = nullptr; //View of the whole file
+		size_t m_uSize = 0; //Bytes of the file
+
+	public:
+		static const uint m_uVersion = 1; //Version written, bump when the layout of anything changes
+
+		/*
+		USAGE: Constructor
+		ARGUMENTS: ---
+		OUTPUT: class object
+		*/
+		MeshCache(void);
+		/*
+		USAGE: Destructor, unmaps the file
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		~MeshCache(void);
+		/*
+		USAGE: Maps the file in memory and checks its header and sizes
+		ARGUMENTS: String a_sFileName -> cache file
+		OUTPUT: false if it cannot be read or is not a cache of this version
+		*/
+		bool Open(String a_sFileName);
+		/*
+		USAGE: Unmaps the file, the pointers handed out are no longer valid
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		void Close(void);
+		/*
+		USAGE: Gets the header of the mapped file
+		ARGUMENTS: ---
+		OUTPUT: header, nullptr if nothing is mapped
+		*/
+		MeshCacheHeader const* GetHeader(void) const;
+		/*
+		USAGE: Gets the vertex buffer inside the mapped file
+		ARGUMENTS: ---
+		OUTPUT: start of the buffer
+		*/
+		void const* GetVertexData(void) const;
+		/*
+		USAGE: Gets the index buffer inside the mapped file
+		ARGUMENTS: ---
+		OUTPUT: start of the buffer, nullptr for a triangle soup
+		*/
+		void const* GetIndexData(void) const;
+		/*
+		USAGE: Writes a cache file, the offsets and sizes of the header are filled in
+		ARGUMENTS:
+		- String a_sFileName -> cache file
+		- MeshCacheHeader a_Header -> header with the description of the buffers
+		- void const* a_pVertex -> vertex buffer, a_Header.m_uVertexBytes long
+		- void const* a_pIndex -> index buffer, a_Header.m_uIndexBytes long
+		OUTPUT: false if the file could not be written
+		*/
+		static bool Write(String a_sFileName, MeshCacheHeader a_Header, void const* a_pVertex, void const* a_pIndex);
+		/*
+		USAGE: Gets the name of the cache file of a source asset
+		ARGUMENTS: String a_sSource -> source asset
+		OUTPUT: cache file name
+		*/
+		static String GetCachePath(String a_sSource);
+		/*
+		USAGE: Tells if the cache is there and is not older than its source, a cache without
+		its source is still good
+		ARGUMENTS:
+		- String a_sSource -> source asset
+		- String a_sCache -> cache file
+		OUTPUT: true if the cache can be used
+		*/
+		static bool IsFresh(String a_sSource, String a_sCache);
+		/*
+		USAGE: Copies a string into a fixed size field of the header
+		ARGUMENTS:
+		- char* a_sField -> field of 256 characters
+		- String a_sValue -> value to copy
+		OUTPUT: false if the value does not fit
+		*/
+		static bool SetField(char* a_sField, String a_sValue);
+
+	private:
+		/*
+		USAGE: Copy Constructor, the mapping cannot be shared
+		ARGUMENTS:
+		OUTPUT:
+		*/
+		MeshCache(MeshCache const& other);
+		/*
+		USAGE: Copy Assignment Operator, the mapping cannot be shared
+		ARGUMENTS:
+		OUTPUT:
+		*/
+		MeshCache& operator=(MeshCache const& other);
+	};
+}
+
+#endif //__MESHCACHEBASICX_H_
@@ -10,12 +10,21 @@ Date: 2015/06
 
 namespace BasicX
 {
+	//Instances of one mesh queued for this frame, one contiguous list of model matrices per render mode
+	//the lists are cleared but never shrunk so after the first frames adding to them does not allocate
+	struct MeshRenderQueue
+	{
+		std::vector<matrix4> m_lSolid; //instances rendered solid
+		std::vector<matrix4> m_lWire; //instances rendered as wireframe
+		std::vector<matrix4> m_lBoth; //instances rendered solid and wireframe
+	};
+
 	//MeshManager
 	class BasicXDLL MeshManager
 	{
 		std::vector<Mesh*> m_meshList; //Lit of all the meshes added to the system
 		std::map<String, uint> m_meshNames; //map of Meshes names and corresponding indices
-		std::vector<std::vector<MeshOptions>*> m_renderOptionsList; //list of options, one for each mesh -> one for each render call
+		std::vector<MeshRenderQueue> m_renderQueueList; //queued instances, one for each mesh -> one render call per mode
 
 		static MeshManager* m_pInstance; // Singleton pointer
 		ShaderManager* m_pShaderMngr = nullptr;	//Shader Manager
@@ -154,6 +163,22 @@ namespace BasicX
 		*/
 		int GenerateSkybox(void);
 		/*
+		USAGE: Loads a mesh from the cache next to its source, building it and writing the cache
+		again if the cache is missing or older than the source
+		ARGUMENTS:
+		-	String a_sSource -> source asset
+		-	MeshSource a_fnBuild -> builds the mesh from the source
+		OUTPUT: index of the mesh, -1 if it could not be loaded
+		*/
+		int LoadMesh(String a_sSource, MeshSource a_fnBuild);
+		/*
+		USAGE: Loads a Wavefront .obj file, through its cache if there is a fresh one
+		ARGUMENTS:
+		-	String a_sFileName -> .obj file
+		OUTPUT: index of the mesh, -1 if it could not be loaded
+		*/
+		int LoadOBJ(String a_sFileName);
+		/*
 		USAGE: will return all the names already stored in the mesh list
 		ARGUMENTS: ---
 		OUTPUT: Names in map
@@ -266,6 +291,25 @@ namespace BasicX
 		*/
 		uint GetMeshCount(void);
 		/*
+		USAGE: Sets what every mesh keeps in memory once it is uploaded
+		ARGUMENTS:
+		-	BTO_RESIDENCY a_eResidency -> RESIDENT_FULL, RESIDENT_POSITIONS or RESIDENT_NONE
+		OUTPUT: ---
+		*/
+		void SetResidency(BTO_RESIDENCY a_eResidency);
+		/*
+		USAGE: Get the bytes the vertex lists of every mesh take in memory
+		ARGUMENTS: ---
+		OUTPUT: resident bytes
+		*/
+		size_t GetResidentMemory(void);
+		/*
+		USAGE: Get the bytes the vertex and index buffers of every mesh take in the GPU
+		ARGUMENTS: ---
+		OUTPUT: GPU bytes
+		*/
+		size_t GetGPUMemory(void);
+		/*
 		USAGE: Sets where the objects are going to be rendered
 		ARGUMENTS:
 		GLuint a_FrameBuffer = 0 -> Where to render, 0 for the window
@@ -342,6 +386,15 @@ namespace BasicX
 		OUTPUT: ---
 		*/
 		void Release(void);
+		/*
+		USAGE: Renders the instances in the list in one call to the mesh, the matrices are handed over as they are
+		ARGUMENTS:
+		uint a_nMesh -> index of the mesh
+		std::vector<matrix4>& a_lInstance -> model matrices of the instances
+		int a_nRender -> render options SOLID | WIRE
+		OUTPUT: ---
+		*/
+		void RenderQueue(uint a_nMesh, std::vector<matrix4>& a_lInstance, int a_nRender);
 	};
 
 }
@@ -0,0 +1,103 @@
+/*----------------------------------------------
+Programmer: Alberto Bobadilla (labigm@gmail.com)
+Date: 2017/06
+----------------------------------------------*/
+#ifndef __VERTEXLAYOUTBASICX_H_
+#define __VERTEXLAYOUTBASICX_H_
+
+#include "BasicX\System\ShaderCompiler.h"
+
+namespace BasicX
+{
+	/*
+	Describes where one attribute of the vertex lives in the buffer and how OpenGL reads it
+	*/
+	struct BasicXDLL VertexAttribute
+	{
+		GLuint m_uLocation = 0; //Location of the attribute in the shader
+		GLint m_nComponents = 3; //Number of components stored
+		GLenum m_eType = GL_FLOAT; //Type of each component
+		GLboolean m_bNormalized = GL_FALSE; //Integer types are read back in [0, 1] or [-1, 1]
+		uint m_uOffset = 0; //Bytes from the start of the vertex
+		uint m_uSize = 0; //Bytes the attribute takes
+	};
+
+	/*
+	Layout of the interleaved vertex of a Mesh, position, color, uv, normal, binormal and tangent
+	in shader locations 0 to 5. Packs the composed vertex array of the Mesh in that layout and
+	sets the attribute pointers of the VAO from it
+	*/
+	class BasicXDLL VertexLayout
+	{
+		BTO_VERTEX m_eFormat = VERTEX_FLOAT; //Format of the layout
+		std::vector<VertexAttribute> m_lAttribute; //Attributes in shader location order
+		uint m_uStride = 0; //Bytes per vertex
+
+	public:
+		/*
+		USAGE: Constructor
+		ARGUMENTS: BTO_VERTEX a_eFormat = VERTEX_FLOAT -> format of the vertex
+		OUTPUT: class object
+		*/
+		VertexLayout(BTO_VERTEX a_eFormat = VERTEX_FLOAT);
+		/*
+		USAGE: Gets the format of the layout
+		ARGUMENTS: ---
+		OUTPUT: format
+		*/
+		BTO_VERTEX GetFormat(void) const;
+		/*
+		USAGE: Gets the number of bytes of each vertex
+		ARGUMENTS: ---
+		OUTPUT: stride
+		*/
+		uint GetStride(void) const;
+		/*
+		USAGE: Gets the attribute at the shader location
+		ARGUMENTS: uint a_uLocation -> location of the attribute
+		OUTPUT: attribute description
+		*/
+		VertexAttribute const& GetAttribute(uint a_uLocation) const;
+		/*
+		USAGE: Converts the composed vertex array into the bytes of the layout
+		ARGUMENTS:
+		- std::vector<vector3> const& a_lVertex -> six vector3 per vertex, position, color, uv,
+			normal, binormal and tangent
+		- std::vector<unsigned char>& a_lBuffer -> bytes of every vertex, resized to fit
+		OUTPUT: ---
+		*/
+		void Pack(std::vector<vector3> const& a_lVertex, std::vector<unsigned char>& a_lBuffer) const;
+		/*
+		USAGE: Enables and points every attribute of the VAO bound at the array buffer bound
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		void Apply(void) const;
+		/*
+		USAGE: Converts a float to a 16 bit half float, rounded to the nearest
+		ARGUMENTS: float a_fValue -> value to convert
+		OUTPUT: bits of the half float
+		*/
+		static unsigned short FloatToHalf(float a_fValue);
+		/*
+		USAGE: Converts a 16 bit half float back to a float
+		ARGUMENTS: unsigned short a_uHalf -> bits of the half float
+		OUTPUT: value
+		*/
+		static float HalfToFloat(unsigned short a_uHalf);
+		/*
+		USAGE: Packs a unit vector in GL_INT_2_10_10_10_REV, 10 signed bits per component
+		ARGUMENTS: vector3 a_v3Input -> vector to pack, clamped to [-1, 1]
+		OUTPUT: packed vector
+		*/
+		static uint PackSigned1010102(vector3 a_v3Input);
+		/*
+		USAGE: Packs a color in RGBA8, alpha is always opaque
+		ARGUMENTS: vector3 a_v3Color -> color to pack, clamped to [0, 1]
+		OUTPUT: packed color
+		*/
+		static uint PackColor(vector3 a_v3Color);
+	};
+}
+
+#endif //__VERTEXLAYOUTBASICX_H_
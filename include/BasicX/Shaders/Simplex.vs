@@ -5,9 +5,9 @@ layout (location = 2) in vec3 UV_b;
 layout (location = 3) in vec3 Normal_b;
 layout (location = 4) in vec3 Binormal_b;
 layout (location = 5) in vec3 Tangent_b;
+layout (location = 6) in mat4 m4ToWorld; //per instance, takes locations 6 to 9
 
 uniform mat4 VP;
-uniform mat4 m4ToWorld[250];
 
 out vec3 Normal_W;
 out vec3 Tangent_W;
@@ -19,14 +19,13 @@ out vec3 Color;
 
 void main()
 {
-	//gl_InstanceID
-	gl_Position = (VP * m4ToWorld[gl_InstanceID]) * vec4(Position_b, 1);
+	gl_Position = (VP * m4ToWorld) * vec4(Position_b, 1);
 	
 	UV = UV_b.xy;
 	Color = Color_b;
 
-	Position_W =	(m4ToWorld[gl_InstanceID] * vec4(Position_b,1)).xyz;
-	Normal_W =		(m4ToWorld[gl_InstanceID] * vec4(Normal_b,0)).xyz;
-	Tangent_W =		(m4ToWorld[gl_InstanceID] * vec4(Tangent_b, 0.0)).xyz;
-	Binormal_W =	(m4ToWorld[gl_InstanceID] * vec4(Binormal_b, 0.0)).xyz;
+	Position_W =	(m4ToWorld * vec4(Position_b,1)).xyz;
+	Normal_W =		(m4ToWorld * vec4(Normal_b,0)).xyz;
+	Tangent_W =		(m4ToWorld * vec4(Tangent_b, 0.0)).xyz;
+	Binormal_W =	(m4ToWorld * vec4(Binormal_b, 0.0)).xyz;
 }
\ No newline at end of file
@@ -0,0 +1,32 @@
+#version 330
+layout (location = 0) in vec3 Position_b; //float or half, read back as float either way
+layout (location = 1) in vec4 Color_b; //RGBA8 normalized
+layout (location = 2) in vec2 UV_b; //half
+layout (location = 3) in vec4 Normal_b; //10 bit signed normalized, w unused
+layout (location = 4) in vec4 Binormal_b;
+layout (location = 5) in vec4 Tangent_b;
+layout (location = 6) in mat4 m4ToWorld; //per instance, takes locations 6 to 9
+
+uniform mat4 VP;
+
+out vec3 Normal_W;
+out vec3 Tangent_W;
+out vec3 Binormal_W;
+out vec3 Position_W;
+out vec3 Eye_W;
+out vec2 UV;
+out vec3 Color;
+
+void main()
+{
+	gl_Position = (VP * m4ToWorld) * vec4(Position_b, 1);
+	
+	UV = UV_b;
+	Color = Color_b.rgb;
+
+	//10 bits per component leave the directions slightly off unit length
+	Position_W =	(m4ToWorld * vec4(Position_b,1)).xyz;
+	Normal_W =		(m4ToWorld * vec4(normalize(Normal_b.xyz), 0.0)).xyz;
+	Tangent_W =		(m4ToWorld * vec4(normalize(Tangent_b.xyz), 0.0)).xyz;
+	Binormal_W =	(m4ToWorld * vec4(normalize(Binormal_b.xyz), 0.0)).xyz;
+}
\ No newline at end of file
@@ -145,6 +145,18 @@ enum BTO_RENDER
 	RENDER_SOLID = 1,
 	RENDER_WIRE = 2,
 };
+enum BTO_VERTEX
+{
+	VERTEX_FLOAT = 0, //every attribute as 3 floats, 72 bytes
+	VERTEX_PACKED = 1, //float position, RGBA8 color, half uv, 10 bit normal, binormal and tangent, 32 bytes
+	VERTEX_PACKED_HALF = 2, //same as packed with a half position, 28 bytes
+};
+enum BTO_RESIDENCY
+{
+	RESIDENT_FULL = 0, //every vertex list stays in memory after the upload
+	RESIDENT_POSITIONS = 1, //only the positions stay, for collisions and GetVertexList
+	RESIDENT_NONE = 2, //nothing stays, the GPU copy is the only one
+};
 enum BTO_CAMERAMODE
 {
 	CAM_PERSP = 0,
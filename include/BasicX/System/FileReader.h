@@ -6,6 +6,7 @@ Date: 2017/06
 #define __FILEREADERCLASS_H_
 
 #include "BasicX\System\SystemSingleton.h"
+#include "BasicX\System\TextScanner.h"
 
 namespace BasicX
 {
@@ -16,6 +17,8 @@ class BasicXDLL FileReader
 	FILE* m_pFile; //File pointer
 	std::ifstream m_iStream;
 	std::ofstream m_oStream;
+	TextScanner m_Scanner; //Text file being read
+	StringView m_Line; //Line read, points inside the file
 
 public:
 	String m_sLine = ""; //Line of file
@@ -56,7 +59,7 @@ public:
 	ARGUMENTS: ---
 	OUTPUT: ---
 	*/
-	void Rewind(void) const;
+	void Rewind(void);
 	/*
 	USAGE: Reads Files and allocates it on the string
 	ARGUMENTS:
@@ -173,6 +176,12 @@ public:
 	*/
 	BTO_OUTPUT ReadNextLine(bool a_bSkipComments = true);
 	/*
+	USAGE: Gets the line read without copying it, tokenize it with TextScanner::NextToken
+	ARGUMENTS: ---
+	OUTPUT: view of the line, valid until the file is closed
+	*/
+	StringView GetLine(void) const;
+	/*
 	USAGE: Removes the blank spaces of the line
 		Modified by AndrewWilkinson88@gmail.com
 	ARGUMENTS:
@@ -0,0 +1,74 @@
+/*----------------------------------------------
+Programmer: Alberto Bobadilla (labigm@gmail.com)
+Date: 2017/06
+----------------------------------------------*/
+#ifndef __GLSTATEBASICX_H_
+#define __GLSTATEBASICX_H_
+
+#include "BasicX\System\ShaderCompiler.h"
+
+namespace BasicX
+{
+	/*
+	Remembers the program, vertex array and textures last bound through it and skips
+	the calls that would bind them again, the driver does not get redundant state changes.
+	Anything binding state directly with OpenGL has to call Invalidate afterwards.
+	*/
+	class BasicXDLL GLState
+	{
+		static const uint m_uTextureUnits = 8; //Number of texture units tracked
+		static GLuint m_uProgram; //Program in use
+		static GLuint m_uVertexArray; //Vertex array bound
+		static GLenum m_eActiveTexture; //Active texture unit
+		static GLuint m_uTexture[m_uTextureUnits]; //2D texture bound on each unit
+		static uint m_uSkipped; //Number of calls skipped since the last reset
+
+	public:
+		/*
+		USAGE: glUseProgram, only if the program is not in use already
+		ARGUMENTS: GLuint a_uProgram -> program to use
+		OUTPUT: ---
+		*/
+		static void UseProgram(GLuint a_uProgram);
+		/*
+		USAGE: glBindVertexArray, only if the vertex array is not bound already
+		ARGUMENTS: GLuint a_uVertexArray -> vertex array to bind
+		OUTPUT: ---
+		*/
+		static void BindVertexArray(GLuint a_uVertexArray);
+		/*
+		USAGE: glActiveTexture, only if the unit is not active already
+		ARGUMENTS: GLenum a_eUnit -> texture unit (GL_TEXTURE0 + n)
+		OUTPUT: ---
+		*/
+		static void ActiveTexture(GLenum a_eUnit);
+		/*
+		USAGE: Binds the 2D texture in the unit, only if it is not bound there already
+		ARGUMENTS:
+			GLenum a_eUnit -> texture unit (GL_TEXTURE0 + n)
+			GLuint a_uTexture -> texture to bind
+		OUTPUT: ---
+		*/
+		static void BindTexture2D(GLenum a_eUnit, GLuint a_uTexture);
+		/*
+		USAGE: Forgets the tracked state, the next call of each kind goes to OpenGL
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		static void Invalidate(void);
+		/*
+		USAGE: Gets the number of calls skipped since the last reset
+		ARGUMENTS: ---
+		OUTPUT: skipped calls
+		*/
+		static uint GetSkippedCallCount(void);
+		/*
+		USAGE: Sets the number of skipped calls back to 0
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		static void ResetSkippedCallCount(void);
+	};
+}
+
+#endif //__GLSTATEBASICX_H_
@@ -7,9 +7,45 @@ Date: 2015/06
 
 #include "BasicX\System\SystemSingleton.h"
 #include "BasicX\System\ShaderCompiler.h"
+#include <map>
 
 namespace BasicX
 {
+/*
+Locations of the variables the BasicX shaders share, looked up once when the program is linked
+so rendering does not ask the driver by name on every draw; -1 if the program does not use it
+*/
+struct BasicXDLL ShaderUniforms
+{
+	GLint m_nVP = -1; //uniform VP
+	GLint m_nMVP = -1; //uniform MVP
+	GLint m_nModelToWorld = -1; //uniform m4ModelToWorld
+	GLint m_nCameraOnWorld = -1; //uniform m4CameraOnWorld
+	GLint m_nTextureID = -1; //uniform TextureID
+	GLint m_nNormalID = -1; //uniform NormalID
+	GLint m_nSpecularID = -1; //uniform SpecularID
+	GLint m_nTexture = -1; //uniform nTexture
+	GLint m_nLightPosition = -1; //uniform LightPosition_W
+	GLint m_nLightColor = -1; //uniform LightColor
+	GLint m_nLightPower = -1; //uniform LightPower
+	GLint m_nAmbientColor = -1; //uniform AmbientColor
+	GLint m_nAmbientPower = -1; //uniform AmbientPower
+	GLint m_nTint = -1; //uniform Tint
+	GLint m_nCameraPosition = -1; //uniform CameraPosition_W
+	GLint m_nElements = -1; //uniform nElements
+	GLint m_nWireframe = -1; //uniform vWireframe
+
+	GLint m_nPositionAttrib = -1; //attribute Position_b
+	GLint m_nColorAttrib = -1; //attribute Color_b
+	GLint m_nUVAttrib = -1; //attribute UV_b
+	/*
+	USAGE: Looks up every location in the linked program
+	ARGUMENTS: GLuint a_nProgram -> linked program
+	OUTPUT: ---
+	*/
+	void Reflect(GLuint a_nProgram);
+};
+
 
 class BasicXDLL Shader
 {
@@ -17,6 +53,8 @@ class BasicXDLL Shader
 	String m_sVertexShaderName = "NULL";
 	String m_sFragmentShaderName = "NULL";
 	GLuint m_nProgram = 0;
+	ShaderUniforms m_Uniforms; //Locations of the shared variables
+	std::map<String, GLint> m_mUniform; //Location of every active uniform by name, arrays without the [0]
 public:
 	/*
 	USAGE:
@@ -79,6 +117,18 @@ public:
 	*/
 	int GetProgramID(void);
 	/*
+	USAGE: Gets the locations of the shared variables, looked up when the program was compiled
+	ARGUMENTS: ---
+	OUTPUT: locations
+	*/
+	ShaderUniforms const& GetUniforms(void);
+	/*
+	USAGE: Gets the location of an active uniform from the cache, does not call OpenGL
+	ARGUMENTS: String a_sName -> name of the uniform
+	OUTPUT: location, -1 if the program has no active uniform by that name
+	*/
+	GLint GetUniformLocation(String a_sName);
+	/*
 	USAGE:
 	ARGUMENTS: ---
 	OUTPUT: ---
@@ -6,6 +6,7 @@ Date: 2015/06
 #define __SHADERMANAGERSINGLETON_H_
 
 #include "BasicX\System\Shader.h"
+#include "BasicX\System\GLState.h"
 #include <vector>
 #include <assert.h>
 #include <map>
@@ -21,6 +22,7 @@ class BasicXDLL ShaderManager
 	
 	std::vector<Shader> m_vShader; //vector of shaders
 	std::map<String, int> m_map;//Indexer of Shaders
+	std::map<GLuint, int> m_mProgram;//Index of each shader by OpenGL program
 
 public:
 	/* Singleton accessor */
@@ -76,6 +78,13 @@ public:
 	OUTPUT:
 	*/
 	int IdentifyShader(String a_sName);
+	/* Asks for the cached variable locations of the specified program*/
+	/*
+	USAGE: Gets the variable locations cached when the program was compiled, no OpenGL call
+	ARGUMENTS: GLuint a_nProgram -> OpenGL identifier of the program
+	OUTPUT: locations, all -1 if the program is not known
+	*/
+	ShaderUniforms const& GetUniforms(GLuint a_nProgram);
 
 private:
 	/* Constructor */
@@ -7,6 +7,7 @@ Date: 2017/06
 
 #include "BasicX\System\Folder.h"
 #include <random>
+#include <chrono>
 
 namespace BasicX
 {
@@ -32,8 +33,8 @@ namespace BasicX
 		String m_sWindowName = "BasicX - Window"; // Window Name
 		String m_sAppName = "";//Name of the Application
 
-		std::vector<DWORD> m_clockList;//clocks list
-		std::vector<DWORD> m_deltaList;//deltas list
+		std::vector<long long> m_clockList;//clocks list, start of each clock in nanoseconds
+		std::vector<long long> m_deltaList;//deltas list, last query of each clock in nanoseconds
 		std::vector<float> m_countdownList;//countdown list
 
 	public:
@@ -207,6 +208,13 @@ namespace BasicX
 		*/
 		void Update(void);
 		/*
+		USAGE: Reads the steady clock of the system, it never goes back and has sub microsecond
+		resolution; the clocks below are all measured with it
+		ARGUMENTS: ---
+		OUTPUT: nanoseconds since an arbitrary point
+		*/
+		static long long GetTimeNanoseconds(void);
+		/*
 		USAGE: Starts a time count for the specified clock
 		ARGUMENTS: uint a_nClock -> clock to query
 		OUTPUT: ---
@@ -0,0 +1,148 @@
+/*----------------------------------------------
+Programmer: Alberto Bobadilla (labigm@gmail.com)
+Date: 2017/06
+----------------------------------------------*/
+#ifndef __TEXTSCANNERBASICX_H_
+#define __TEXTSCANNERBASICX_H_
+
+#include "BasicX\System\Definitions.h"
+
+namespace BasicX
+{
+	/*
+	Characters of a string owned by someone else, nothing is copied. Only valid while the
+	owner keeps the characters alive
+	*/
+	struct BasicXDLL StringView
+	{
+		const char* m_pData = nullptr; //First character
+		uint m_uLength = 0; //Number of characters
+
+		/*
+		USAGE: Tells if the view has no characters
+		ARGUMENTS: ---
+		OUTPUT: true if empty
+		*/
+		bool Empty(void) const;
+		/*
+		USAGE: Compares the characters of the view with a null terminated string
+		ARGUMENTS: const char* a_sInput -> string to compare with
+		OUTPUT: true if they are the same characters
+		*/
+		bool operator==(const char* a_sInput) const;
+		/*
+		USAGE: Copies the characters of the view in a string
+		ARGUMENTS: ---
+		OUTPUT: copy
+		*/
+		String ToString(void) const;
+	};
+
+	/*
+	Reads a text file line by line without copying it, the file is mapped in memory (or read in
+	a single block when it cannot be mapped) and lines and tokens are views into it
+	*/
+	class BasicXDLL TextScanner
+	{
+		HANDLE m_hFile = INVALID_HANDLE_VALUE; //File opened
+		HANDLE m_hMapping = nullptr; //Mapping of the file
+		const char* m_pView = nullptr; //View of the mapping
+		std::vector<char> m_lBuffer; //Contents of the file when it could not be mapped
+		const char* m_pData = nullptr; //Start of the text, in the view or in the buffer
+		size_t m_uSize = 0; //Characters in the text
+		size_t m_uPosition = 0; //Start of the next line
+		bool m_bOpen = false; //A file is open
+
+	public:
+		/*
+		USAGE: Constructor
+		ARGUMENTS: ---
+		OUTPUT: class object
+		*/
+		TextScanner(void);
+		/*
+		USAGE: Destructor, closes the file
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		~TextScanner(void);
+		/*
+		USAGE: Opens the file and starts at its first line
+		ARGUMENTS: String a_sFileName -> file to read
+		OUTPUT: false if the file cannot be read
+		*/
+		bool Open(String a_sFileName);
+		/*
+		USAGE: Closes the file, the views handed out are no longer valid
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		void Close(void);
+		/*
+		USAGE: Tells if a file is open
+		ARGUMENTS: ---
+		OUTPUT: true if open
+		*/
+		bool IsOpen(void) const;
+		/*
+		USAGE: Goes back to the first line of the file
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		void Rewind(void);
+		/*
+		USAGE: Reads the next line, without the leading blanks and the end of line
+		ARGUMENTS: StringView& a_Line -> line read
+		OUTPUT: false at the end of the file
+		*/
+		bool NextLine(StringView& a_Line);
+		/*
+		USAGE: Takes the next word separated by blanks out of the input
+		ARGUMENTS:
+		- StringView& a_Input -> characters left, the word and the blanks before it are taken out
+		- StringView& a_Token -> word read
+		OUTPUT: false if there are no words left
+		*/
+		static bool NextToken(StringView& a_Input, StringView& a_Token);
+		/*
+		USAGE: Takes the characters up to the separator out of the input, the separator goes too
+		ARGUMENTS:
+		- StringView& a_Input -> characters left
+		- char a_cSeparator -> separator
+		OUTPUT: characters before the separator, empty if two separators are together
+		*/
+		static StringView Split(StringView& a_Input, char a_cSeparator);
+		/*
+		USAGE: Parses a float from all the characters of the token, without copying them
+		ARGUMENTS:
+		- StringView a_Token -> token to parse
+		- float& a_fOutput -> value read
+		OUTPUT: false if the token is not a number
+		*/
+		static bool ParseFloat(StringView a_Token, float& a_fOutput);
+		/*
+		USAGE: Parses an integer from all the characters of the token
+		ARGUMENTS:
+		- StringView a_Token -> token to parse
+		- int& a_nOutput -> value read
+		OUTPUT: false if the token is not an integer
+		*/
+		static bool ParseInt(StringView a_Token, int& a_nOutput);
+
+	private:
+		/*
+		USAGE: Copy Constructor, the mapping cannot be shared
+		ARGUMENTS:
+		OUTPUT:
+		*/
+		TextScanner(TextScanner const& other);
+		/*
+		USAGE: Copy Assignment Operator, the mapping cannot be shared
+		ARGUMENTS:
+		OUTPUT:
+		*/
+		TextScanner& operator=(TextScanner const& other);
+	};
+}
+
+#endif //__TEXTSCANNERBASICX_H_